@@ -0,0 +1,298 @@
+/*
+Arena utility, function implementations
+*/
+
+// header files
+#include "Arena_Utility.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local function prototypes, used only in this file
+
+    void *arenaAllocate( void *allocatorData, size_t size, size_t alignment );
+    ArenaChunkType *createArenaChunk( size_t capacity );
+    size_t getAlignedOffset( const ArenaChunkType *chunk, size_t alignment );
+
+/*
+Name: allocateArenaMemory
+Process: allocates zeroed memory of given size and alignment from
+         current chunk, or first later chunk with space, creating a
+         chunk (of chunk size, or larger for large requests) if none
+Function input/parameters: arena (ArenaType *), size in bytes (size_t),
+                           alignment in bytes, power of two (size_t)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: pointer to memory, or NULL if out of memory
+                          (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: getAlignedOffset, createArenaChunk, memset
+*/
+void *allocateArenaMemory( ArenaType *arena, size_t size, size_t alignment )
+   {
+    ArenaChunkType *chunk = arena->current;
+    size_t offset = 0, chunkSize;
+
+    alignment = alignment > 0 ? alignment : 1;
+
+    // chunks skipped here stay unused until reset
+    while( chunk != NULL )
+       {
+        offset = getAlignedOffset( chunk, alignment );
+
+        if( offset <= chunk->capacity && size <= chunk->capacity - offset )
+           {
+            break;
+           }
+
+        chunk = chunk->next;
+       }
+
+    if( chunk == NULL )
+       {
+        chunkSize = size + alignment > arena->chunkSize ?
+                                         size + alignment : arena->chunkSize;
+        chunk = createArenaChunk( chunkSize );
+
+        if( chunk == NULL )
+           {
+            return NULL;
+           }
+
+        if( arena->last != NULL )
+           {
+            arena->last->next = chunk;
+           }
+
+        else
+           {
+            arena->first = chunk;
+           }
+
+        arena->last = chunk;
+        arena->reservedBytes += chunkSize;
+
+        offset = getAlignedOffset( chunk, alignment );
+       }
+
+    // bytes used before reset are cleared, others are zero already
+    if( offset < chunk->dirtyLength )
+       {
+        memset( chunk->data + offset, 0, chunk->dirtyLength - offset < size
+                                       ? chunk->dirtyLength - offset : size );
+       }
+
+    chunk->dirtyLength = offset + size > chunk->dirtyLength ?
+                                          offset + size : chunk->dirtyLength;
+
+    arena->usedBytes += offset + size - chunk->used;
+    chunk->used = offset + size;
+    arena->current = chunk;
+
+    return chunk->data + offset;
+   }
+
+/*
+Name: arenaAllocate
+Process: allocate function of table allocator of arena
+Function input/parameters: arena (void *), size in bytes (size_t),
+                           alignment in bytes (size_t)
+Function output/parameters: updated arena (void *)
+Function output/returned: pointer to zeroed memory, or NULL if out of
+                          memory (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: allocateArenaMemory
+*/
+void *arenaAllocate( void *allocatorData, size_t size, size_t alignment )
+   {
+    return allocateArenaMemory( (ArenaType *)allocatorData, size, alignment );
+   }
+
+/*
+Name: clearArena
+Process: releases arena and all its chunks, memory allocated in arena,
+         including tables built in it, is no longer valid
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearArena( ArenaType *arena )
+   {
+    ArenaChunkType *chunk = arena->first, *nextChunk;
+
+    while( chunk != NULL )
+       {
+        nextChunk = chunk->next;
+
+        free( chunk->data );
+        free( chunk );
+
+        chunk = nextChunk;
+       }
+
+    free( arena );
+   }
+
+/*
+Name: copyArenaString
+Process: copies string of given length into arena, terminated
+Function input/parameters: arena (ArenaType *),
+                           source (const char *), length (int)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: pointer to copy, or NULL if out of memory
+                          (char *)
+Device input/---: none
+Device output/---: none
+Dependencies: allocateArenaMemory, memcpy
+*/
+char *copyArenaString( ArenaType *arena, const char *source, int length )
+   {
+    // terminator is zeroed already
+    char *copy = (char *)allocateArenaMemory( arena, (size_t)length + 1, 1 );
+
+    if( copy != NULL )
+       {
+        memcpy( copy, source, length );
+       }
+
+    return copy;
+   }
+
+/*
+Name: createArena
+Process: creates empty arena, first chunk is created by first allocation
+Function input/parameters: chunk size in bytes,
+                           zero for DEFAULT_ARENA_CHUNK_SIZE (size_t)
+Function output/parameters: none
+Function output/returned: pointer to arena, or NULL if out of memory
+                          (ArenaType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc
+*/
+ArenaType *createArena( size_t chunkSize )
+   {
+    ArenaType *arena = (ArenaType *)malloc( sizeof( ArenaType ) );
+
+    if( arena == NULL )
+       {
+        return NULL;
+       }
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->last = NULL;
+    arena->chunkSize = chunkSize > 0 ? chunkSize : DEFAULT_ARENA_CHUNK_SIZE;
+    arena->usedBytes = 0;
+    arena->reservedBytes = 0;
+
+    // tables built in arena are never released one by one
+    arena->allocator.allocate = arenaAllocate;
+    arena->allocator.release = NULL;
+    arena->allocator.allocatorData = arena;
+
+    return arena;
+   }
+
+/*
+Name: createArenaChunk
+Process: creates chunk of given capacity, data comes zeroed, large
+         chunks untouched until used
+Function input/parameters: capacity in bytes (size_t)
+Function output/parameters: none
+Function output/returned: pointer to chunk, or NULL if out of memory
+                          (ArenaChunkType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free
+*/
+ArenaChunkType *createArenaChunk( size_t capacity )
+   {
+    ArenaChunkType *chunk = (ArenaChunkType *)malloc(
+                                                    sizeof( ArenaChunkType ) );
+
+    if( chunk == NULL )
+       {
+        return NULL;
+       }
+
+    chunk->data = (unsigned char *)calloc( 1, capacity );
+
+    if( chunk->data == NULL )
+       {
+        free( chunk );
+
+        return NULL;
+       }
+
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->dirtyLength = 0;
+
+    return chunk;
+   }
+
+/*
+Name: getAlignedOffset
+Process: finds offset of first address in chunk at or after used bytes
+         with given alignment, may be past chunk capacity
+Function input/parameters: chunk (const ArenaChunkType *),
+                           alignment in bytes, power of two (size_t)
+Function output/parameters: none
+Function output/returned: offset in chunk (size_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+size_t getAlignedOffset( const ArenaChunkType *chunk, size_t alignment )
+   {
+    uintptr_t address = (uintptr_t)( chunk->data + chunk->used );
+
+    return chunk->used + ( ( alignment - address % alignment ) % alignment );
+   }
+
+/*
+Name: getArenaAllocator
+Process: finds table allocator of arena, for allocator field of
+         HashAllocationOptionsType; tables built with it are dropped
+         by resetArena or clearArena, clearHashTable is not needed
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: none
+Function output/returned: allocator (const HashAllocatorType *)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+const HashAllocatorType *getArenaAllocator( ArenaType *arena )
+   {
+    return &arena->allocator;
+   }
+
+/*
+Name: resetArena
+Process: drops everything allocated in arena at once, keeping its
+         chunks for reuse
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void resetArena( ArenaType *arena )
+   {
+    ArenaChunkType *chunk;
+
+    for( chunk = arena->first; chunk != NULL; chunk = chunk->next )
+       {
+        chunk->used = 0;
+       }
+
+    arena->current = arena->first;
+    arena->usedBytes = 0;
+   }
@@ -0,0 +1,141 @@
+/*
+Arena utility, function prototypes
+
+Region allocator for short lived data: allocations are carved from
+large chunks in order and are never freed one by one; resetting the
+arena drops everything allocated in it at once, keeping its chunks
+for the next batch, so a batch of tables, their keys, and temporary
+buffers costs no malloc or free per item and leaves no fragmentation.
+Memory is returned zeroed; chunk bytes never used since the chunk was
+allocated are zero already, so only reused bytes are cleared.
+Tables are built in an arena through its HashAllocatorType.
+Not thread safe, use one arena per thread.
+*/
+
+// PreProcessor test
+#ifndef ARENA_UTILITY_H
+#define ARENA_UTILITY_H
+
+// header files
+#include <stddef.h>
+#include "HashUtilities.h"
+
+// constants
+
+    // chunk size used when none is given, large enough that chunk
+    // memory comes zeroed and untouched from the system
+    static const size_t DEFAULT_ARENA_CHUNK_SIZE = 1048576;
+
+// data structures
+
+    // chunk of arena memory, used bytes are allocated since reset,
+    // dirty bytes were allocated at some time since chunk was created
+    typedef struct ArenaChunkStruct
+       {
+        struct ArenaChunkStruct *next;
+        unsigned char *data;
+        size_t capacity;
+        size_t used;
+        size_t dirtyLength;
+       } ArenaChunkType;
+
+    // arena, chunks in allocation order, current is first chunk
+    // with space, later chunks are unused since reset
+    typedef struct ArenaStruct
+       {
+        ArenaChunkType *first;
+        ArenaChunkType *current;
+        ArenaChunkType *last;
+        size_t chunkSize;
+        size_t usedBytes;
+        size_t reservedBytes;
+        HashAllocatorType allocator;
+       } ArenaType;
+
+// function prototypes
+
+/*
+Name: allocateArenaMemory
+Process: allocates zeroed memory of given size and alignment from
+         current chunk, or first later chunk with space, creating a
+         chunk (of chunk size, or larger for large requests) if none
+Function input/parameters: arena (ArenaType *), size in bytes (size_t),
+                           alignment in bytes, power of two (size_t)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: pointer to memory, or NULL if out of memory
+                          (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: getAlignedOffset, createArenaChunk, memset
+*/
+void *allocateArenaMemory( ArenaType *arena, size_t size, size_t alignment );
+
+/*
+Name: clearArena
+Process: releases arena and all its chunks, memory allocated in arena,
+         including tables built in it, is no longer valid
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearArena( ArenaType *arena );
+
+/*
+Name: copyArenaString
+Process: copies string of given length into arena, terminated
+Function input/parameters: arena (ArenaType *),
+                           source (const char *), length (int)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: pointer to copy, or NULL if out of memory
+                          (char *)
+Device input/---: none
+Device output/---: none
+Dependencies: allocateArenaMemory, memcpy
+*/
+char *copyArenaString( ArenaType *arena, const char *source, int length );
+
+/*
+Name: createArena
+Process: creates empty arena, first chunk is created by first allocation
+Function input/parameters: chunk size in bytes,
+                           zero for DEFAULT_ARENA_CHUNK_SIZE (size_t)
+Function output/parameters: none
+Function output/returned: pointer to arena, or NULL if out of memory
+                          (ArenaType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc
+*/
+ArenaType *createArena( size_t chunkSize );
+
+/*
+Name: getArenaAllocator
+Process: finds table allocator of arena, for allocator field of
+         HashAllocationOptionsType; tables built with it are dropped
+         by resetArena or clearArena, clearHashTable is not needed
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: none
+Function output/returned: allocator (const HashAllocatorType *)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+const HashAllocatorType *getArenaAllocator( ArenaType *arena );
+
+/*
+Name: resetArena
+Process: drops everything allocated in arena at once, keeping its
+         chunks for reuse
+Function input/parameters: arena (ArenaType *)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void resetArena( ArenaType *arena );
+
+#endif  // ARENA_UTILITY_H
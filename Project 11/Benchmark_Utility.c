@@ -0,0 +1,425 @@
+/*
+Benchmark utility, function implementations
+*/
+
+// header files
+#include "Benchmark_Utility.h"
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// local function prototypes, used only in this file
+
+    int compareLatencies( const void *onePtr, const void *otherPtr );
+    double getZipfDensity( const ZipfGeneratorType *generator, double rank );
+    double getZipfIntegral( const ZipfGeneratorType *generator, double rank );
+    double getZipfIntegralInverse( const ZipfGeneratorType *generator, 
+                                                               double value );
+
+/*
+Name: addLatencySample
+Process: appends one operation latency to log, grows log as needed
+Function input/parameters: latency log (LatencyLogType *), 
+                           latency in nanoseconds (long long)
+Function output/parameters: updated latency log (LatencyLogType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: realloc
+*/
+void addLatencySample( LatencyLogType *log, long long nanoseconds )
+   {
+    long long *grownSamples;
+
+    if( log->count == log->capacity )
+       {
+        grownSamples = (long long *)realloc( log->samples, 
+                                   2 * log->capacity * sizeof( long long ) );
+
+        // keep existing samples if memory runs out
+        if( grownSamples == NULL )
+           {
+            return;
+           }
+
+        log->samples = grownSamples;
+        log->capacity *= 2;
+       }
+
+    log->samples[ log->count ] = nanoseconds;
+    log->count++;
+    log->sorted = false;
+   }
+
+/*
+Name: clearLatencyLog
+Process: releases latency log and its samples
+Function input/parameters: latency log (LatencyLogType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearLatencyLog( LatencyLogType *log )
+   {
+    if( log != NULL )
+       {
+        free( log->samples );
+        free( log );
+       }
+   }
+
+/*
+Name: compareLatencies
+Process: compares two latency samples for qsort
+Function input/parameters: pointers to samples (const void *)
+Function output/parameters: none
+Function output/returned: negative, zero, or positive as first sample
+                          is less than, equal to, or greater than second (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int compareLatencies( const void *onePtr, const void *otherPtr )
+   {
+    long long one = *(const long long *)onePtr;
+    long long other = *(const long long *)otherPtr;
+
+    return ( one > other ) - ( one < other );
+   }
+
+/*
+Name: createLatencyLog
+Process: creates empty latency log able to hold given number of samples
+         before growing, DEFAULT_LATENCY_LOG_CAPACITY if not positive
+Function input/parameters: starting capacity (long long)
+Function output/parameters: none
+Function output/returned: pointer to created log (LatencyLogType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc
+*/
+LatencyLogType *createLatencyLog( long long capacity )
+   {
+    LatencyLogType *log = (LatencyLogType *)malloc( sizeof( LatencyLogType ) );
+
+    if( capacity <= 0 )
+       {
+        capacity = DEFAULT_LATENCY_LOG_CAPACITY;
+       }
+
+    log->samples = (long long *)malloc( capacity * sizeof( long long ) );
+    log->count = 0;
+    log->capacity = capacity;
+    log->totalNanoseconds = 0;
+    log->sorted = true;
+
+    return log;
+   }
+
+/*
+Name: getLatencyPercentile
+Process: finds sample at given percentile (0 to 100) by nearest rank,
+         sorts samples on first request after new samples are added
+Function input/parameters: latency log (LatencyLogType *), 
+                           percentile (double)
+Function output/parameters: sorted latency log (LatencyLogType *)
+Function output/returned: latency in nanoseconds, 0 if log is empty 
+                          (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: qsort
+*/
+long long getLatencyPercentile( LatencyLogType *log, double percentile )
+   {
+    long long rank;
+
+    if( log->count == 0 )
+       {
+        return 0;
+       }
+
+    if( !log->sorted )
+       {
+        qsort( log->samples, log->count, sizeof( long long ), 
+                                                          compareLatencies );
+
+        log->sorted = true;
+       }
+
+    // nearest rank, 1 based
+    rank = (long long)( percentile / 100.0 * log->count + 0.999999 );
+
+    if( rank < 1 )
+       {
+        rank = 1;
+       }
+
+    if( rank > log->count )
+       {
+        rank = log->count;
+       }
+
+    return log->samples[ rank - 1 ];
+   }
+
+/*
+Name: getPeakResidentKilobytes
+Process: finds peak resident set size of this process so far
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: peak resident size in kilobytes, 
+                          0 if not available (long)
+Device input/---: none
+Device output/---: none
+Dependencies: getrusage
+*/
+long getPeakResidentKilobytes( void )
+   {
+#ifndef _WIN32
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+       {
+#ifdef __APPLE__
+        // reported in bytes on macOS
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+       }
+#endif
+
+    return 0;
+   }
+
+/*
+Name: getTimeNanoseconds
+Process: reads monotonic clock
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: current time in nanoseconds (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: clock_gettime (timespec_get on Windows)
+*/
+long long getTimeNanoseconds( void )
+   {
+    struct timespec now;
+
+#ifndef _WIN32
+    clock_gettime( CLOCK_MONOTONIC, &now );
+#else
+    timespec_get( &now, TIME_UTC );
+#endif
+
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+   }
+
+/*
+Name: getZipfDensity
+Process: finds unnormalized Zipfian weight of (real valued) rank
+Function input/parameters: generator (const ZipfGeneratorType *),
+                           rank from 1 (double)
+Function output/parameters: none
+Function output/returned: rank to the power of minus exponent (double)
+Device input/---: none
+Device output/---: none
+Dependencies: exp, log
+*/
+double getZipfDensity( const ZipfGeneratorType *generator, double rank )
+   {
+    return exp( -generator->exponent * log( rank ) );
+   }
+
+/*
+Name: getZipfIntegral
+Process: finds integral of Zipfian weight from 1 to given rank,
+         written to stay accurate as exponent approaches 1
+Function input/parameters: generator (const ZipfGeneratorType *),
+                           rank from 1 (double)
+Function output/parameters: none
+Function output/returned: integral value (double)
+Device input/---: none
+Device output/---: none
+Dependencies: expm1, log
+*/
+double getZipfIntegral( const ZipfGeneratorType *generator, double rank )
+   {
+    double logRank = log( rank );
+    double scaled = ( 1.0 - generator->exponent ) * logRank;
+
+    // expm1( scaled ) / scaled, tends to 1
+    if( fabs( scaled ) > 1e-8 )
+       {
+        return expm1( scaled ) / scaled * logRank;
+       }
+
+    return ( 1.0 + scaled / 2.0 ) * logRank;
+   }
+
+/*
+Name: getZipfIntegralInverse
+Process: inverts getZipfIntegral
+Function input/parameters: generator (const ZipfGeneratorType *),
+                           integral value (double)
+Function output/parameters: none
+Function output/returned: rank from 1 (double)
+Device input/---: none
+Device output/---: none
+Dependencies: exp, log1p
+*/
+double getZipfIntegralInverse( const ZipfGeneratorType *generator, 
+                                                                double value )
+   {
+    double scaled = value * ( 1.0 - generator->exponent );
+
+    if( scaled < -1.0 )
+       {
+        scaled = -1.0;
+       }
+
+    // log1p( scaled ) / scaled, tends to 1
+    if( fabs( scaled ) > 1e-8 )
+       {
+        return exp( log1p( scaled ) / scaled * value );
+       }
+
+    return exp( ( 1.0 - scaled / 2.0 ) * value );
+   }
+
+/*
+Name: getZipfRank
+Process: draws rank from Zipfian distribution of generator,
+         rank 0 is most frequent, uniform if exponent is zero
+Function input/parameters: generator (const ZipfGeneratorType *),
+                           random state (unsigned long long *)
+Function output/parameters: updated random state (unsigned long long *)
+Function output/returned: rank from 0 to count - 1 (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom, getZipfIntegralInverse, getZipfIntegral,
+              getZipfDensity
+*/
+long long getZipfRank( const ZipfGeneratorType *generator, 
+                                           unsigned long long *randomState )
+   {
+    double unit, value, rank;
+    long long rankIndex;
+
+    if( generator->exponent <= 0.0 )
+       {
+        return (long long)( nextRandom( randomState ) 
+                                     % (unsigned long long)generator->count );
+       }
+
+    // rejection inversion, usually accepts first try
+    while( true )
+       {
+        unit = ( nextRandom( randomState ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+        value = generator->hIntegralCount 
+                + unit * ( generator->hIntegralFirst - generator->hIntegralCount );
+        rank = getZipfIntegralInverse( generator, value );
+        rankIndex = (long long)( rank + 0.5 );
+
+        if( rankIndex < 1 )
+           {
+            rankIndex = 1;
+           }
+
+        else if( rankIndex > generator->count )
+           {
+            rankIndex = generator->count;
+           }
+
+        if( rankIndex - rank <= generator->shortcut
+             || value >= getZipfIntegral( generator, rankIndex + 0.5 ) 
+                                   - getZipfDensity( generator, rankIndex ) )
+           {
+            return rankIndex - 1;
+           }
+       }
+   }
+
+/*
+Name: initializeZipfGenerator
+Process: sets up Zipfian sampler over given number of ranks,
+         probability of rank k (from 1) proportional to 1 / k^exponent
+Function input/parameters: rank count (long long), exponent (double)
+Function output/parameters: generator (ZipfGeneratorType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getZipfIntegral, getZipfIntegralInverse, getZipfDensity
+*/
+void initializeZipfGenerator( ZipfGeneratorType *generator, 
+                                           long long count, double exponent )
+   {
+    generator->count = count > 0 ? count : 1;
+    generator->exponent = exponent;
+    generator->hIntegralFirst = getZipfIntegral( generator, 1.5 ) - 1.0;
+    generator->hIntegralCount = getZipfIntegral( generator, 
+                                                  generator->count + 0.5 );
+    generator->shortcut = 2.0 - getZipfIntegralInverse( generator, 
+                              getZipfIntegral( generator, 2.5 ) 
+                                        - getZipfDensity( generator, 2.0 ) );
+   }
+
+/*
+Name: nextRandom
+Process: advances splitmix64 generator
+Function input/parameters: generator state (unsigned long long *)
+Function output/parameters: updated generator state (unsigned long long *)
+Function output/returned: next pseudo random value (unsigned long long)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+unsigned long long nextRandom( unsigned long long *state )
+   {
+    unsigned long long value;
+
+    *state += 0x9E3779B97F4A7C15ULL;
+
+    value = *state;
+    value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return value ^ ( value >> 31 );
+   }
+
+/*
+Name: writeLatencyJson
+Process: writes JSON member for latency log: operation count,
+         batch seconds, operations per second, and percentiles
+Function input/parameters: output file (FILE *), member name (const char *),
+                           latency log (LatencyLogType *)
+Function output/parameters: sorted latency log (LatencyLogType *)
+Function output/returned: none
+Device input/---: none
+Device output/file: JSON member written as specified
+Dependencies: fprintf, getLatencyPercentile
+*/
+void writeLatencyJson( FILE *outFilePtr, const char *name, 
+                                                         LatencyLogType *log )
+   {
+    double seconds = log->totalNanoseconds / 1e9;
+
+    fprintf( outFilePtr, "\"%s\": { \"count\": %lld, \"seconds\": %.6f, "
+                         "\"ops_per_second\": %.1f, ", name, log->count, 
+              seconds, seconds > 0.0 ? log->count / seconds : 0.0 );
+
+    fprintf( outFilePtr, "\"p50_ns\": %lld, \"p90_ns\": %lld, "
+                         "\"p99_ns\": %lld, \"p999_ns\": %lld, "
+                         "\"max_ns\": %lld }",
+              getLatencyPercentile( log, 50.0 ), 
+              getLatencyPercentile( log, 90.0 ),
+              getLatencyPercentile( log, 99.0 ), 
+              getLatencyPercentile( log, 99.9 ),
+              getLatencyPercentile( log, 100.0 ) );
+   }
@@ -0,0 +1,181 @@
+/*
+Benchmark utility, function prototypes
+
+Timing, per operation latency logs with percentiles, JSON output,
+and pseudo random and Zipfian key selection shared by the benchmark
+and workload drivers.
+*/
+
+// PreProcessor test
+#ifndef BENCHMARK_UTILITY_H
+#define BENCHMARK_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include <stdio.h>
+
+// constants
+
+    // starting number of samples held by a latency log
+    static const long long DEFAULT_LATENCY_LOG_CAPACITY = 4096;
+
+// data structures
+
+    // latency samples of one kind of operation, in nanoseconds
+    typedef struct LatencyLogStruct
+       {
+        long long *samples;
+        long long count;
+        long long capacity;
+        long long totalNanoseconds;
+        bool sorted;
+       } LatencyLogType;
+
+    // Zipfian rank sampler (rejection inversion, constant memory)
+    typedef struct ZipfGeneratorStruct
+       {
+        long long count;
+        double exponent;
+        double hIntegralFirst;
+        double hIntegralCount;
+        double shortcut;
+       } ZipfGeneratorType;
+
+// function prototypes
+
+/*
+Name: addLatencySample
+Process: appends one operation latency to log, grows log as needed
+Function input/parameters: latency log (LatencyLogType *), 
+                           latency in nanoseconds (long long)
+Function output/parameters: updated latency log (LatencyLogType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: realloc
+*/
+void addLatencySample( LatencyLogType *log, long long nanoseconds );
+
+/*
+Name: clearLatencyLog
+Process: releases latency log and its samples
+Function input/parameters: latency log (LatencyLogType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearLatencyLog( LatencyLogType *log );
+
+/*
+Name: createLatencyLog
+Process: creates empty latency log able to hold given number of samples
+         before growing, DEFAULT_LATENCY_LOG_CAPACITY if not positive
+Function input/parameters: starting capacity (long long)
+Function output/parameters: none
+Function output/returned: pointer to created log (LatencyLogType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc
+*/
+LatencyLogType *createLatencyLog( long long capacity );
+
+/*
+Name: getLatencyPercentile
+Process: finds sample at given percentile (0 to 100) by nearest rank,
+         sorts samples on first request after new samples are added
+Function input/parameters: latency log (LatencyLogType *), 
+                           percentile (double)
+Function output/parameters: sorted latency log (LatencyLogType *)
+Function output/returned: latency in nanoseconds, 0 if log is empty 
+                          (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: qsort
+*/
+long long getLatencyPercentile( LatencyLogType *log, double percentile );
+
+/*
+Name: getPeakResidentKilobytes
+Process: finds peak resident set size of this process so far
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: peak resident size in kilobytes, 
+                          0 if not available (long)
+Device input/---: none
+Device output/---: none
+Dependencies: getrusage
+*/
+long getPeakResidentKilobytes( void );
+
+/*
+Name: getTimeNanoseconds
+Process: reads monotonic clock
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: current time in nanoseconds (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: clock_gettime (timespec_get on Windows)
+*/
+long long getTimeNanoseconds( void );
+
+/*
+Name: getZipfRank
+Process: draws rank from Zipfian distribution of generator,
+         rank 0 is most frequent, uniform if exponent is zero
+Function input/parameters: generator (const ZipfGeneratorType *),
+                           random state (unsigned long long *)
+Function output/parameters: updated random state (unsigned long long *)
+Function output/returned: rank from 0 to count - 1 (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom, getZipfIntegralInverse, getZipfIntegral,
+              getZipfDensity
+*/
+long long getZipfRank( const ZipfGeneratorType *generator, 
+                                          unsigned long long *randomState );
+
+/*
+Name: initializeZipfGenerator
+Process: sets up Zipfian sampler over given number of ranks,
+         probability of rank k (from 1) proportional to 1 / k^exponent
+Function input/parameters: rank count (long long), exponent (double)
+Function output/parameters: generator (ZipfGeneratorType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getZipfIntegral, getZipfIntegralInverse, getZipfDensity
+*/
+void initializeZipfGenerator( ZipfGeneratorType *generator, 
+                                          long long count, double exponent );
+
+/*
+Name: nextRandom
+Process: advances splitmix64 generator
+Function input/parameters: generator state (unsigned long long *)
+Function output/parameters: updated generator state (unsigned long long *)
+Function output/returned: next pseudo random value (unsigned long long)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+unsigned long long nextRandom( unsigned long long *state );
+
+/*
+Name: writeLatencyJson
+Process: writes JSON member for latency log: operation count,
+         batch seconds, operations per second, and percentiles
+Function input/parameters: output file (FILE *), member name (const char *),
+                           latency log (LatencyLogType *)
+Function output/parameters: sorted latency log (LatencyLogType *)
+Function output/returned: none
+Device input/---: none
+Device output/file: JSON member written as specified
+Dependencies: fprintf, getLatencyPercentile
+*/
+void writeLatencyJson( FILE *outFilePtr, const char *name, 
+                                                        LatencyLogType *log );
+
+#endif  // BENCHMARK_UTILITY_H
@@ -0,0 +1,472 @@
+/*
+Binary data utility, function implementations
+*/
+
+// header files
+#include "Binary_Data_Utility.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local global constants, used only in this file
+
+    // size of blocks copied from temporary column files
+    const size_t BINARY_COPY_BLOCK_SIZE = 65536;
+
+    // column and section alignment, in bytes
+    const size_t BINARY_ALIGNMENT = 8;
+
+// local function prototypes, used only in this file
+
+    int loadBinaryData( ProbingHashType *hash, const char *binaryFileName,
+                                                        bool restoreNodes );
+
+/*
+Name: closeBinaryDataWriter
+Process: pads name section, appends staged columns, writes final header,
+         and closes binary file, or removes it if not kept 
+         or if any write failed
+Function input/parameters: writer (BinaryDataWriterType *), 
+                           keep file flag (bool)
+Function output/parameters: none
+Function output/returned: number of records in kept file, 
+                          or -1 if file was removed (long long)
+Device input/---: none
+Device output/file: binary data to HD
+Device output/monitor: none
+Dependencies: fwrite, fread, rewind, fseek, ferror, fclose, remove, 
+              malloc, free
+*/
+long long closeBinaryDataWriter( BinaryDataWriterType *writer, bool keepFile )
+   {
+    long long recordCount = (long long)writer->header.recordCount;
+    char zeroBytes[ 8 ] = { 0 };
+    char *copyBlock;
+    size_t bytesRead;
+    int column;
+    bool success = keepFile;
+
+    if( success )
+       {
+        // pad names, append columns
+        fwrite( zeroBytes, 1, ( BINARY_ALIGNMENT 
+                   - writer->header.nameSectionSize % BINARY_ALIGNMENT ) 
+                                   % BINARY_ALIGNMENT, writer->outFilePtr );
+
+        copyBlock = (char *)malloc( BINARY_COPY_BLOCK_SIZE );
+
+        // node column follows if any node index was written
+        for( column = 0; column < 4 
+                        && writer->columnFilePtrs[ column ] != NULL; column++ )
+           {
+            rewind( writer->columnFilePtrs[ column ] );
+
+            while( ( bytesRead = fread( copyBlock, 1, BINARY_COPY_BLOCK_SIZE, 
+                                     writer->columnFilePtrs[ column ] ) ) > 0 )
+               {
+                fwrite( copyBlock, 1, bytesRead, writer->outFilePtr );
+               }
+
+            success = success && !ferror( writer->columnFilePtrs[ column ] );
+           }
+
+        free( copyBlock );
+
+        // final header
+        fseek( writer->outFilePtr, 0, SEEK_SET );
+        fwrite( &writer->header, sizeof( writer->header ), 1, 
+                                                         writer->outFilePtr );
+
+        success = success && !ferror( writer->outFilePtr );
+       }
+
+    // release files
+    for( column = 0; column < 4 
+                        && writer->columnFilePtrs[ column ] != NULL; column++ )
+       {
+        fclose( writer->columnFilePtrs[ column ] );
+       }
+
+    success = fclose( writer->outFilePtr ) == 0 && success;
+
+    // no partial output
+    if( !success )
+       {
+        remove( writer->fileName );
+       }
+
+    free( writer->fileName );
+    free( writer );
+
+    return success ? recordCount : -1;
+   }
+
+/*
+Name: convertCsvToBinary
+Process: converts state temperature CSV file (as read by uploadData)
+         to binary data file, names longer than STD_STR_LEN - 1
+         are truncated as they would be in the table,
+         binary file is removed if CSV file has a malformed number
+Function input/parameters: CSV file name, binary file name (const char *)
+Function output/parameters: none
+Function output/returned: number of records written, 
+                          or -1 on failure (long long)
+Device input/file: CSV data from HD
+Device output/file: binary data to HD, message on malformed number
+Dependencies: openMappedFile, openBinaryDataWriter, 
+              readViewToDelimiterFromMap, readDoubleFromMap,
+              readCharacterFromMap, getMapParseStatus, writeBinaryRecord,
+              closeBinaryDataWriter, closeMappedFile
+*/
+long long convertCsvToBinary( const char *csvFileName, 
+                                                 const char *binaryFileName )
+   {
+    MappedFileType *mappedFile = openMappedFile( csvFileName );
+    BinaryDataWriterType *writer;
+    StringViewType nameView;
+    double avgTemp, lowestTemp, highestTemp;
+    size_t errorOffset;
+    bool success = true;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    writer = openBinaryDataWriter( binaryFileName );
+
+    if( writer == NULL )
+       {
+        closeMappedFile( mappedFile );
+
+        return -1;
+       }
+
+    // convert each row
+    while( success && readViewToDelimiterFromMap( mappedFile, COMMA, 
+                                                                  &nameView ) )
+       {
+        avgTemp = readDoubleFromMap( mappedFile );
+
+        // ignores comma
+        readCharacterFromMap( mappedFile );
+
+        lowestTemp = readDoubleFromMap( mappedFile );
+
+        // ignores comma
+        readCharacterFromMap( mappedFile );
+
+        highestTemp = readDoubleFromMap( mappedFile );
+
+        // stop at first malformed number
+        if( getMapParseStatus( mappedFile, &errorOffset ) != PARSE_SUCCESS )
+           {
+            printf( "\nData error in %s at byte %lu: %s\n", csvFileName,
+                                       (unsigned long)errorOffset, 
+                        getParseStatusString( mappedFile->parseStatus ) );
+
+            success = false;
+           }
+
+        else
+           {
+            success = writeBinaryRecord( writer, nameView.start, 
+                     nameView.length, avgTemp, lowestTemp, highestTemp );
+           }
+       }
+
+    closeMappedFile( mappedFile );
+
+    return closeBinaryDataWriter( writer, success );
+   }
+
+/*
+Name: loadBinaryData
+Process: uploads data from memory mapped binary data file 
+         into given hash table, names are inserted straight from 
+         the mapping, temperatures straight from the columns, 
+         checkpoint items put back in their nodes if asked and table
+         has same layout
+Function input/parameters: hash table (ProbingHashType *),
+                           binary file name (const char *),
+                           restore nodes flag (bool)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded, or -1 if file could not
+                          be mapped or is not a valid binary data file (int)
+Device input/file: binary data from HD
+Device output/monitor: none
+Dependencies: openMappedFile, memcmp, memcpy, addItemAtIndex, 
+              addItemFromView, closeMappedFile
+*/
+int loadBinaryData( ProbingHashType *hash, const char *binaryFileName,
+                                                        bool restoreNodes )
+   {
+    MappedFileType *mappedFile = openMappedFile( binaryFileName );
+    BinaryDataHeaderType header;
+    const unsigned char *namePtr, *nameEnd;
+    const char *columnPtr;
+    size_t columnOffset, columnCount;
+    double avgTemp, lowestTemp, highestTemp;
+    uint64_t index, nodeIndex;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    // validate header and sizes against file length
+    if( mappedFile->length < sizeof( header ) )
+       {
+        closeMappedFile( mappedFile );
+
+        return -1;
+       }
+
+    memcpy( &header, mappedFile->data, sizeof( header ) );
+
+    columnCount = header.checkpointNumber != 0 ? 4 : 3;
+
+    columnOffset = sizeof( header ) + header.nameSectionSize 
+                 + ( BINARY_ALIGNMENT - header.nameSectionSize 
+                                      % BINARY_ALIGNMENT ) % BINARY_ALIGNMENT;
+
+    if( memcmp( header.magic, BINARY_DATA_MAGIC, 
+                                               sizeof( header.magic ) ) != 0
+         || header.version != BINARY_DATA_VERSION
+         || header.nameSectionSize > mappedFile->length
+         || columnOffset > mappedFile->length
+         || ( mappedFile->length - columnOffset )
+                    / ( columnCount * sizeof( double ) ) < header.recordCount )
+       {
+        closeMappedFile( mappedFile );
+
+        return -1;
+       }
+
+    // nodes only mean the same in table of same layout
+    restoreNodes = restoreNodes && columnCount == 4
+                 && header.tableSize == (uint64_t)hash->tableSize
+                 && header.probeStrategy == (uint64_t)hash->probeStrategy;
+
+    // walk names and columns together
+    namePtr = (const unsigned char *)mappedFile->data + sizeof( header );
+    nameEnd = namePtr + header.nameSectionSize;
+    columnPtr = mappedFile->data + columnOffset;
+
+    for( index = 0; index < header.recordCount 
+                         && namePtr < nameEnd 
+                         && namePtr + 1 + *namePtr <= nameEnd; index++ )
+       {
+        memcpy( &avgTemp, columnPtr + index * sizeof( double ), 
+                                                            sizeof( double ) );
+        memcpy( &lowestTemp, columnPtr 
+                          + ( header.recordCount + index ) * sizeof( double ), 
+                                                            sizeof( double ) );
+        memcpy( &highestTemp, columnPtr 
+                      + ( 2 * header.recordCount + index ) * sizeof( double ), 
+                                                            sizeof( double ) );
+
+        memcpy( &nodeIndex, columnPtr 
+                      + ( 3 * header.recordCount + index ) * sizeof( double ), 
+                                                          sizeof( uint64_t ) );
+
+        // node taken or chained table, item is added as usual
+        if( !restoreNodes || nodeIndex >= header.tableSize
+             || !addItemAtIndex( hash, (int)nodeIndex, 
+                                 (const char *)namePtr + 1, *namePtr, 
+                                 avgTemp, lowestTemp, highestTemp ) )
+           {
+            addItemFromView( hash, (const char *)namePtr + 1, *namePtr, 
+                                           avgTemp, lowestTemp, highestTemp );
+           }
+
+        namePtr += 1 + *namePtr;
+       }
+
+    closeMappedFile( mappedFile );
+
+    return (int)index;
+   }
+
+/*
+Name: openBinaryDataWriter
+Process: creates binary data file with placeholder header,
+         ready for records to be written
+Function input/parameters: binary file name (const char *)
+Function output/parameters: none
+Function output/returned: pointer to writer, or NULL if file or temporary
+                          column files could not be created 
+                          (BinaryDataWriterType *)
+Device input/---: none
+Device output/file: header written to HD
+Dependencies: fopen, tmpfile, fwrite, malloc, strlen, strcpy
+*/
+BinaryDataWriterType *openBinaryDataWriter( const char *binaryFileName )
+   {
+    BinaryDataWriterType *writer 
+               = (BinaryDataWriterType *)malloc( sizeof( BinaryDataWriterType ) );
+    int column;
+    bool success;
+
+    writer->outFilePtr = fopen( binaryFileName, "wb" );
+    success = writer->outFilePtr != NULL;
+
+    // columns are staged in temporary files until names are done
+    writer->columnFilePtrs[ 3 ] = NULL;
+
+    for( column = 0; column < 3; column++ )
+       {
+        writer->columnFilePtrs[ column ] = tmpfile();
+
+        success = success && writer->columnFilePtrs[ column ] != NULL;
+       }
+
+    if( !success )
+       {
+        for( column = 0; column < 3; column++ )
+           {
+            if( writer->columnFilePtrs[ column ] != NULL )
+               {
+                fclose( writer->columnFilePtrs[ column ] );
+               }
+           }
+
+        if( writer->outFilePtr != NULL )
+           {
+            fclose( writer->outFilePtr );
+            remove( binaryFileName );
+           }
+
+        free( writer );
+
+        return NULL;
+       }
+
+    writer->fileName = (char *)malloc( strlen( binaryFileName ) + 1 );
+    strcpy( writer->fileName, binaryFileName );
+
+    // placeholder header, rewritten when counts are known
+    memcpy( writer->header.magic, BINARY_DATA_MAGIC, 
+                                            sizeof( writer->header.magic ) );
+    writer->header.version = BINARY_DATA_VERSION;
+    writer->header.recordCount = 0;
+    writer->header.nameSectionSize = 0;
+    writer->header.checkpointNumber = 0;
+    writer->header.tableSize = 0;
+    writer->header.probeStrategy = 0;
+
+    fwrite( &writer->header, sizeof( writer->header ), 1, writer->outFilePtr );
+
+    return writer;
+   }
+
+/*
+Name: restoreDataFromBinary
+Process: uploads binary data file into given empty hash table as
+         uploadDataFromBinary, except that a checkpoint of an open
+         addressing table of same size and probe strategy puts each
+         item back in node it was written from, so table has same
+         layout as the one checkpointed
+Function input/parameters: hash table (ProbingHashType *),
+                           binary file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded, or -1 if file could not
+                          be mapped or is not a valid binary data file (int)
+Device input/file: binary data from HD
+Device output/monitor: none
+Dependencies: loadBinaryData
+*/
+int restoreDataFromBinary( ProbingHashType *hash, 
+                                                const char *binaryFileName )
+   {
+    return loadBinaryData( hash, binaryFileName, true );
+   }
+
+/*
+Name: uploadDataFromBinary
+Process: uploads data from memory mapped binary data file 
+         into given hash table, names are inserted straight from 
+         the mapping, temperatures straight from the columns
+Function input/parameters: hash table (ProbingHashType *),
+                           binary file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded, or -1 if file could not
+                          be mapped or is not a valid binary data file (int)
+Device input/file: binary data from HD
+Device output/monitor: none
+Dependencies: loadBinaryData
+*/
+int uploadDataFromBinary( ProbingHashType *hash, const char *binaryFileName )
+   {
+    return loadBinaryData( hash, binaryFileName, false );
+   }
+
+/*
+Name: writeBinaryNodeIndex
+Process: appends table node of record last written to node column,
+         staged in temporary file created with first node index;
+         checkpoints write one for each record
+Function input/parameters: writer (BinaryDataWriterType *),
+                           node index (uint64_t)
+Function output/parameters: updated writer (BinaryDataWriterType *)
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: node index to HD
+Dependencies: tmpfile, fwrite
+*/
+bool writeBinaryNodeIndex( BinaryDataWriterType *writer, 
+                                                         uint64_t nodeIndex )
+   {
+    if( writer->columnFilePtrs[ 3 ] == NULL )
+       {
+        writer->columnFilePtrs[ 3 ] = tmpfile();
+       }
+
+    return writer->columnFilePtrs[ 3 ] != NULL 
+            && fwrite( &nodeIndex, sizeof( uint64_t ), 1, 
+                                         writer->columnFilePtrs[ 3 ] ) == 1;
+   }
+
+/*
+Name: writeBinaryRecord
+Process: appends one record to binary file being written, 
+         names longer than STD_STR_LEN - 1 are truncated 
+         as they would be in the table
+Function input/parameters: writer (BinaryDataWriterType *),
+                           name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated writer (BinaryDataWriterType *)
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: record data to HD
+Dependencies: fwrite
+*/
+bool writeBinaryRecord( BinaryDataWriterType *writer, const char *name, 
+                                 int nameLength, double avgTemp, 
+                                 double lowTemp, double highTemp )
+   {
+    double temps[ 3 ] = { avgTemp, lowTemp, highTemp };
+    unsigned char storedLength;
+    int column;
+    bool success;
+
+    // name, truncated as table would
+    storedLength = (unsigned char)( nameLength < STD_STR_LEN - 1 ? 
+                                                nameLength : STD_STR_LEN - 1 );
+
+    success = fwrite( &storedLength, 1, 1, writer->outFilePtr ) == 1
+               && fwrite( name, 1, storedLength, writer->outFilePtr ) 
+                                                             == storedLength;
+
+    // temperatures, one per column
+    for( column = 0; column < 3; column++ )
+       {
+        success = success && fwrite( &temps[ column ], sizeof( double ), 1, 
+                                          writer->columnFilePtrs[ column ] ) == 1;
+       }
+
+    writer->header.nameSectionSize += 1 + storedLength;
+    writer->header.recordCount++;
+
+    return success;
+   }
@@ -0,0 +1,184 @@
+/*
+Binary data utility, function prototypes
+
+Compact binary form of the state temperature data, so repeated loads
+skip text parsing entirely. Layout, in native byte order:
+
+   header:       magic "HTBD", version (uint32), record count (uint64),
+                 name section size in bytes (uint64), checkpoint number
+                 (uint64), zero unless written as a write ahead log
+                 checkpoint (see Write_Ahead_Log_Utility.h), then size
+                 and probe strategy of table checkpointed (uint64)
+   name section: per record, name length (uint8) then name characters
+                 (no NULL_CHAR), padded with zeros to a multiple of 8
+   columns:      average temperatures (double [record count]),
+                 then lowest, then highest temperatures, then for
+                 checkpoints table node of each record (uint64)
+*/
+
+// PreProcessor test
+#ifndef BINARY_DATA_UTILITY_H
+#define BINARY_DATA_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "HashUtilities.h"
+#include "Mapped_Input_Utility.h"
+
+// constants
+
+    // binary file identification and version
+    static const char BINARY_DATA_MAGIC[ 4 ] = { 'H', 'T', 'B', 'D' };
+    static const uint32_t BINARY_DATA_VERSION = 3;
+
+// data structures
+
+    // binary file header
+    typedef struct BinaryDataHeaderStruct
+       {
+        char magic[ 4 ];
+        uint32_t version;
+        uint64_t recordCount;
+        uint64_t nameSectionSize;
+        uint64_t checkpointNumber;
+        uint64_t tableSize;
+        uint64_t probeStrategy;
+       } BinaryDataHeaderType;
+
+    // binary file being written, columns staged in temporary files,
+    // node column only once a node index is written
+    typedef struct BinaryDataWriterStruct
+       {
+        FILE *outFilePtr;
+        FILE *columnFilePtrs[ 4 ];
+        char *fileName;
+        BinaryDataHeaderType header;
+       } BinaryDataWriterType;
+
+// function prototypes
+
+/*
+Name: closeBinaryDataWriter
+Process: pads name section, appends staged columns, writes final header,
+         and closes binary file, or removes it if not kept 
+         or if any write failed
+Function input/parameters: writer (BinaryDataWriterType *), 
+                           keep file flag (bool)
+Function output/parameters: none
+Function output/returned: number of records in kept file, 
+                          or -1 if file was removed (long long)
+Device input/---: none
+Device output/file: binary data to HD
+Device output/monitor: none
+Dependencies: fwrite, fread, rewind, fseek, ferror, fclose, remove, 
+              malloc, free
+*/
+long long closeBinaryDataWriter( BinaryDataWriterType *writer, bool keepFile );
+
+/*
+Name: convertCsvToBinary
+Process: converts state temperature CSV file (as read by uploadData)
+         to binary data file, names longer than STD_STR_LEN - 1
+         are truncated as they would be in the table,
+         binary file is removed if CSV file has a malformed number
+Function input/parameters: CSV file name, binary file name (const char *)
+Function output/parameters: none
+Function output/returned: number of records written, 
+                          or -1 on failure (long long)
+Device input/file: CSV data from HD
+Device output/file: binary data to HD, message on malformed number
+Dependencies: openMappedFile, openBinaryDataWriter, 
+              readViewToDelimiterFromMap, readDoubleFromMap,
+              readCharacterFromMap, getMapParseStatus, writeBinaryRecord,
+              closeBinaryDataWriter, closeMappedFile
+*/
+long long convertCsvToBinary( const char *csvFileName, 
+                                                 const char *binaryFileName );
+
+/*
+Name: openBinaryDataWriter
+Process: creates binary data file with placeholder header,
+         ready for records to be written
+Function input/parameters: binary file name (const char *)
+Function output/parameters: none
+Function output/returned: pointer to writer, or NULL if file or temporary
+                          column files could not be created 
+                          (BinaryDataWriterType *)
+Device input/---: none
+Device output/file: header written to HD
+Dependencies: fopen, tmpfile, fwrite, malloc, strlen, strcpy
+*/
+BinaryDataWriterType *openBinaryDataWriter( const char *binaryFileName );
+
+/*
+Name: restoreDataFromBinary
+Process: uploads binary data file into given empty hash table as
+         uploadDataFromBinary, except that a checkpoint of an open
+         addressing table of same size and probe strategy puts each
+         item back in node it was written from, so table has same
+         layout as the one checkpointed
+Function input/parameters: hash table (ProbingHashType *),
+                           binary file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded, or -1 if file could not
+                          be mapped or is not a valid binary data file (int)
+Device input/file: binary data from HD
+Device output/monitor: none
+Dependencies: loadBinaryData
+*/
+int restoreDataFromBinary( ProbingHashType *hash, 
+                                               const char *binaryFileName );
+
+/*
+Name: uploadDataFromBinary
+Process: uploads data from memory mapped binary data file 
+         into given hash table, names are inserted straight from 
+         the mapping, temperatures straight from the columns
+Function input/parameters: hash table (ProbingHashType *),
+                           binary file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded, or -1 if file could not
+                          be mapped or is not a valid binary data file (int)
+Device input/file: binary data from HD
+Device output/monitor: none
+Dependencies: loadBinaryData
+*/
+int uploadDataFromBinary( ProbingHashType *hash, const char *binaryFileName );
+
+/*
+Name: writeBinaryNodeIndex
+Process: appends table node of record last written to node column,
+         staged in temporary file created with first node index;
+         checkpoints write one for each record
+Function input/parameters: writer (BinaryDataWriterType *),
+                           node index (uint64_t)
+Function output/parameters: updated writer (BinaryDataWriterType *)
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: node index to HD
+Dependencies: tmpfile, fwrite
+*/
+bool writeBinaryNodeIndex( BinaryDataWriterType *writer, 
+                                                        uint64_t nodeIndex );
+
+/*
+Name: writeBinaryRecord
+Process: appends one record to binary file being written, 
+         names longer than STD_STR_LEN - 1 are truncated 
+         as they would be in the table
+Function input/parameters: writer (BinaryDataWriterType *),
+                           name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated writer (BinaryDataWriterType *)
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: record data to HD
+Dependencies: fwrite
+*/
+bool writeBinaryRecord( BinaryDataWriterType *writer, const char *name, 
+                                 int nameLength, double avgTemp, 
+                                 double lowTemp, double highTemp );
+
+#endif  // BINARY_DATA_UTILITY_H
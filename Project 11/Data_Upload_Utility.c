@@ -0,0 +1,698 @@
+/*
+Data upload utility, function implementations
+*/
+
+// header files
+#include "Data_Upload_Utility.h"
+#include <pthread.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// local data structures, used only in this file
+
+    // parsed row, name points into mapped file
+    typedef struct ParsedRowStruct
+       {
+        const char *name;
+        int nameLength;
+        int hashIndex;
+        double averageTemp, lowestTemp, highestTemp;
+       } ParsedRowType;
+
+    // table shared by insert threads, each stripe of UPLOAD_STRIPE_NODES
+    // nodes has its own lock; node rank is file row number (from one) of
+    // row in node, zero for nodes in use before upload
+    typedef struct UploadTableStruct
+       {
+        ProbingHashType *hash;
+        pthread_mutex_t *stripeLocks;
+        int stripeCount;
+        int *nodeRanks;
+       } UploadTableType;
+
+    // one upload thread's share of the file, rows that found no unused
+    // node are left over for calling thread
+    typedef struct UploadChunkStruct
+       {
+        MappedFileType chunkView;
+        const ProbingHashType *hash;
+        ParsedRowType *rows;
+        int rowCount;
+        int rowCapacity;
+        bool threadStarted;
+        UploadTableType *table;
+        int firstRank;
+        StateDataType *leftovers;
+        int leftoverCount;
+       } UploadChunkType;
+
+// local function prototypes, used only in this file
+
+    void *insertUploadChunk( void *chunkPtr );
+    bool insertUploadRow( UploadTableType *table, const ParsedRowType *row,
+                                          int rank, StateDataType *leftover );
+    void *parseUploadChunk( void *chunkPtr );
+
+/*
+Name: getProcessorCount
+Process: finds number of online processors, at least one
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: processor count (int)
+Device input/---: none
+Device output/---: none
+Dependencies: sysconf
+*/
+int getProcessorCount( void )
+   {
+    long count = 1;
+
+#ifndef _WIN32
+    count = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+
+    return count > 0 ? (int)count : 1;
+   }
+
+/*
+Name: insertUploadChunk
+Process: thread function, inserts every row of one parsed chunk into
+         shared table, keeping rows that found no unused node
+Function input/parameters: chunk (void *, UploadChunkType *)
+Function output/parameters: updated chunk leftovers (UploadChunkType *),
+                            updated table (in chunk)
+Function output/returned: NULL (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: insertUploadRow, realloc
+*/
+void *insertUploadChunk( void *chunkPtr )
+   {
+    UploadChunkType *chunk = (UploadChunkType *)chunkPtr;
+    StateDataType leftover;
+    int rowIndex;
+
+    for( rowIndex = 0; rowIndex < chunk->rowCount; rowIndex++ )
+       {
+        if( !insertUploadRow( chunk->table, &chunk->rows[ rowIndex ],
+                                  chunk->firstRank + rowIndex, &leftover ) )
+           {
+            chunk->leftovers = (StateDataType *)realloc( chunk->leftovers,
+                      ( chunk->leftoverCount + 1 ) * sizeof( StateDataType ) );
+            chunk->leftovers[ chunk->leftoverCount ] = leftover;
+            chunk->leftoverCount++;
+           }
+       }
+
+    return NULL;
+   }
+
+/*
+Name: insertUploadRow
+Process: stores row in first unused node of its probe sequence, locking
+         each stripe of nodes as probe enters it; a node on the way
+         holding same name from a later file row is swapped with item
+         carried, which then goes on probing, so rows of one name stay
+         in file order along their probe sequence and finds give the
+         same item as after a single threaded load
+Function input/parameters: table (UploadTableType *),
+                           row (const ParsedRowType *),
+                           file row number, from one (int)
+Function output/parameters: updated table (UploadTableType *),
+                            item left over if false (StateDataType *)
+Function output/returned: true if stored, false if probe found no
+                          unused node (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: memset, memcpy, pthread_mutex_lock, strcmp,
+              pthread_mutex_unlock
+*/
+bool insertUploadRow( UploadTableType *table, const ParsedRowType *row,
+                                           int rank, StateDataType *leftover )
+   {
+    StateDataType *array = table->hash->array, carried, swapped;
+    int *nodeRanks = table->nodeRanks;
+    const bool quadratic = table->hash->probeStrategy != LINEAR_PROBING;
+    int size = table->hash->tableSize, index = row->hashIndex;
+    int increment = quadratic ? 2 : 1;
+    int step, stripe, heldStripe = -1, swappedRank;
+
+    // zeroed past name, as nodes of serial loads
+    memset( &carried, 0, sizeof( carried ) );
+    memcpy( carried.name, row->name, row->nameLength );
+    carried.averageTemp = row->averageTemp;
+    carried.lowestTemp = row->lowestTemp;
+    carried.highestTemp = row->highestTemp;
+    carried.inUse = USED_NODE;
+
+    increment = increment % size;
+
+    // same steps as table's own probe, quadratic increments grow by 4
+    for( step = 1; step <= size; step++ )
+       {
+        stripe = index / UPLOAD_STRIPE_NODES;
+
+        if( stripe != heldStripe )
+           {
+            if( heldStripe >= 0 )
+               {
+                pthread_mutex_unlock( &table->stripeLocks[ heldStripe ] );
+               }
+
+            pthread_mutex_lock( &table->stripeLocks[ stripe ] );
+            heldStripe = stripe;
+           }
+
+        if( !array[ index ].inUse )
+           {
+            array[ index ] = carried;
+            nodeRanks[ index ] = rank;
+
+            pthread_mutex_unlock( &table->stripeLocks[ heldStripe ] );
+
+            return true;
+           }
+
+        // later row of same name moves on, carried row takes its node
+        if( nodeRanks[ index ] > rank
+                   && strcmp( array[ index ].name, carried.name ) == 0 )
+           {
+            swapped = array[ index ];
+            swappedRank = nodeRanks[ index ];
+
+            array[ index ] = carried;
+            nodeRanks[ index ] = rank;
+
+            carried = swapped;
+            rank = swappedRank;
+           }
+
+        index += increment;
+
+        if( index >= size )
+           {
+            index -= size;
+           }
+
+        if( quadratic )
+           {
+            increment = ( increment + 4 ) % size;
+           }
+       }
+
+    if( heldStripe >= 0 )
+       {
+        pthread_mutex_unlock( &table->stripeLocks[ heldStripe ] );
+       }
+
+    *leftover = carried;
+
+    return false;
+   }
+
+/*
+Name: parseUploadChunk
+Process: thread function, tokenizes and parses every row of one chunk
+         into row list, calculating hash index of each name,
+         stops at first malformed number (recorded in chunk view)
+Function input/parameters: chunk (void *, UploadChunkType *)
+Function output/parameters: updated chunk rows (UploadChunkType *)
+Function output/returned: NULL (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: readViewToDelimiterFromMap, readDoubleFromMap,
+              readCharacterFromMap, getHashIndexFromView, realloc
+*/
+void *parseUploadChunk( void *chunkPtr )
+   {
+    UploadChunkType *chunk = (UploadChunkType *)chunkPtr;
+    MappedFileType *chunkView = &chunk->chunkView;
+    StringViewType nameView;
+    ParsedRowType *row;
+
+    while( readViewToDelimiterFromMap( chunkView, COMMA, &nameView ) )
+       {
+        // grow row list as needed
+        if( chunk->rowCount == chunk->rowCapacity )
+           {
+            chunk->rowCapacity = chunk->rowCapacity * 2 + 1024;
+            chunk->rows = (ParsedRowType *)realloc( chunk->rows, 
+                               chunk->rowCapacity * sizeof( ParsedRowType ) );
+           }
+
+        row = &chunk->rows[ chunk->rowCount ];
+
+        row->averageTemp = readDoubleFromMap( chunkView );
+
+        // ignores comma
+        readCharacterFromMap( chunkView );
+
+        row->lowestTemp = readDoubleFromMap( chunkView );
+
+        // ignores comma
+        readCharacterFromMap( chunkView );
+
+        row->highestTemp = readDoubleFromMap( chunkView );
+
+        // stop at first malformed number, main thread reports it
+        if( chunkView->parseStatus != PARSE_SUCCESS )
+           {
+            break;
+           }
+
+        // truncate name to fit node, hash now while data is in cache
+        row->name = nameView.start;
+        row->nameLength = nameView.length < STD_STR_LEN - 1 ? 
+                                          nameView.length : STD_STR_LEN - 1;
+        row->hashIndex = getHashIndexFromView( chunk->hash, row->name, 
+                                                             row->nameLength );
+
+        chunk->rowCount++;
+       }
+
+    return NULL;
+   }
+
+/*
+Name: uploadData
+Process: uploads data from file with unknown number of data sets,
+         stops with message at first malformed number,
+         has internal Verbose Boolean to display input operation
+Function input/parameters: file name (char *), table size (int),
+                           probe type (int)
+Function output/parameters: none
+Function output/returned: pointer to hash table (ProbingHashType *)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: initializeHashTable, uploadDataFromReader, free
+*/
+ProbingHashType *uploadData( char *fileName, int tableSize, int probeType )
+   {
+    ProbingHashType *tempHashPtr = initializeHashTable( tableSize, probeType );
+
+    // file not found
+    if( uploadDataFromReader( tempHashPtr, fileName ) < 0 )
+       {
+        free( tempHashPtr );
+       }
+
+    return tempHashPtr;
+   }
+
+/*
+Name: uploadDataFromMap
+Process: uploads data from memory mapped file into given hash table,
+         state names are inserted straight from the mapping
+         with no intermediate string buffer,
+         stops with message at first malformed number
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be mapped (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openMappedFile, readViewToDelimiterFromMap, readDoubleFromMap,
+              readCharacterFromMap, getMapParseStatus, printf,
+              addItemFromView, closeMappedFile
+*/
+int uploadDataFromMap( ProbingHashType *hash, const char *fileName )
+   {
+    StringViewType nameView;
+    double avgTemp, lowestTemp, highestTemp;
+    int index = 0;
+    size_t errorOffset;
+    MappedFileType *mappedFile = openMappedFile( fileName );
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    // get names until end of mapping
+    while( readViewToDelimiterFromMap( mappedFile, COMMA, &nameView ) )
+       {
+        avgTemp = readDoubleFromMap( mappedFile );
+
+        // ignores comma
+        readCharacterFromMap( mappedFile );
+
+        lowestTemp = readDoubleFromMap( mappedFile );
+
+        // ignores comma
+        readCharacterFromMap( mappedFile );
+
+        highestTemp = readDoubleFromMap( mappedFile );
+
+        // stop at first malformed number
+        if( getMapParseStatus( mappedFile, &errorOffset ) != PARSE_SUCCESS )
+           {
+            printf( "\nData error in %s at byte %lu: %s\n", fileName,
+                                       (unsigned long)errorOffset, 
+                        getParseStatusString( mappedFile->parseStatus ) );
+
+            break;
+           }
+
+        // add to hash table, name copied once into node
+        addItemFromView( hash, nameView.start, nameView.length, 
+                                             avgTemp, lowestTemp, highestTemp );
+
+        index++;
+       }
+
+    closeMappedFile( mappedFile );
+
+    return index;
+   }
+
+/*
+Name: uploadDataFromReader
+Process: uploads data from file into given hash table through buffered
+         input reader with background read ahead, as uploadData does,
+         stops with message at first malformed number,
+         has internal Verbose Boolean to display input operation
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be opened (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openInputReaderWithReadAhead, readStringToDelimiterFromReader, 
+              readDoubleFromReader, readCharacterFromReader, 
+              getReaderParseStatus, printf, addItemFromData, closeInputReader
+*/
+int uploadDataFromReader( ProbingHashType *hash, const char *fileName )
+   {
+    char stateNameStr[ MAX_STR_LEN ];
+    double avgTemp, lowestTemp, highestTemp;
+    int index = 0;
+    long long errorOffset;
+    bool verbose = false;  // Set to true to verify data upload, false otherwise
+    InputReaderType *reader = openInputReaderWithReadAhead( fileName, 
+                                                 DEFAULT_READER_BUFFER_SIZE );
+
+    if( reader != NULL )
+       {
+        if( verbose )
+           {
+            printf( "\n     ----- Verbose: Begin Loading Data From File\n" );
+           }
+
+        // get first state name
+        readStringToDelimiterFromReader( reader, COMMA, stateNameStr );
+
+        while( !checkForEndOfReader( reader ) )
+           {
+            avgTemp = readDoubleFromReader( reader );
+
+            // ignores comma
+            readCharacterFromReader( reader );
+
+            lowestTemp = readDoubleFromReader( reader );
+
+            // ignores comma
+            readCharacterFromReader( reader );
+
+            highestTemp = readDoubleFromReader( reader );
+
+            // stop at first malformed number
+            if( getReaderParseStatus( reader, &errorOffset ) != PARSE_SUCCESS )
+               {
+                printf( "\nData error in %s at byte %lld: %s\n", fileName,
+                   errorOffset, getParseStatusString( reader->parseStatus ) );
+
+                break;
+               }
+
+            if( verbose )
+               {
+                printf( "State Name: %s | ", stateNameStr );
+
+                printf( "Average Temp: %5.2f | ", avgTemp );
+
+                printf( "Lowest Temp: %5.2f | ", lowestTemp );
+
+                printf( "Highest Temp: %5.2f\n", highestTemp );
+               }
+
+            // add to hash table
+            addItemFromData( hash, stateNameStr, 
+                                             avgTemp, lowestTemp, highestTemp );
+
+            // reprime - read next state name
+            readStringToDelimiterFromReader( reader, COMMA, stateNameStr );
+
+            index++;
+           }
+
+        if( verbose )
+           {
+            printf( "\n     ----- Verbose: Items found in file: %d\n", index );
+            printf( "     ----- Verbose: End Loading Data From File\n\n" );
+           }
+
+        closeInputReader( reader );
+
+        return index;
+       }
+
+    // file not found
+    return -1;
+   }
+
+/*
+Name: uploadDataParallel
+Process: uploads data from memory mapped file into given hash table
+         using a pool of threads: file is split into newline aligned
+         chunks, each thread tokenizes, parses and hashes one chunk,
+         then inserts its rows, locking stripes of table nodes as it
+         probes them; finds give the same items as after the single
+         threaded loaders, though items may sit in other nodes;
+         tables with chains, index hooks (including filter), write
+         barrier, or probing display have rows inserted in file order
+         on calling thread instead;
+         uses all processors if thread count is not positive,
+         fewer threads for small files, chunk whose thread could
+         not be started is handled on calling thread,
+         stops with message at first malformed number
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *), thread count (int)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be mapped (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openMappedFile, pthread_create, pthread_join,
+              parseUploadChunk, printf, malloc, calloc,
+              pthread_mutex_init, insertUploadChunk, addItemFromStruct,
+              pthread_mutex_destroy, addItemFromHashedView,
+              closeMappedFile, free
+*/
+int uploadDataParallel( ProbingHashType *hash, const char *fileName,
+                                                             int threadCount )
+   {
+    MappedFileType *mappedFile = openMappedFile( fileName );
+    UploadChunkType *chunks;
+    UploadTableType table;
+    pthread_t *threads;
+    ParsedRowType *row;
+    const char *newlinePtr;
+    size_t chunkStart = 0, chunkEnd;
+    int chunkIndex, rowIndex, stripe, insertCount, index = 0;
+    bool parallelInsert;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    // pick thread count, no more threads than minimum size chunks
+    if( threadCount <= 0 )
+       {
+        threadCount = getProcessorCount();
+       }
+
+    if( (size_t)threadCount > mappedFile->length / MIN_UPLOAD_CHUNK_SIZE + 1 )
+       {
+        threadCount = (int)( mappedFile->length / MIN_UPLOAD_CHUNK_SIZE ) + 1;
+       }
+
+    chunks = (UploadChunkType *)calloc( threadCount,
+                                                   sizeof( UploadChunkType ) );
+    threads = (pthread_t *)malloc( threadCount * sizeof( pthread_t ) );
+
+    // split at newlines, start one thread per chunk
+    for( chunkIndex = 0; chunkIndex < threadCount; chunkIndex++ )
+       {
+        chunkEnd = mappedFile->length;
+
+        if( chunkIndex < threadCount - 1 )
+           {
+            chunkEnd = mappedFile->length / threadCount * ( chunkIndex + 1 );
+
+            if( chunkEnd < chunkStart )
+               {
+                chunkEnd = chunkStart;
+               }
+
+            newlinePtr = (const char *)memchr( mappedFile->data + chunkEnd,
+                             NEWLINE_CHAR, mappedFile->length - chunkEnd );
+
+            chunkEnd = newlinePtr == NULL ? mappedFile->length
+                             : (size_t)( newlinePtr - mappedFile->data ) + 1;
+           }
+
+        // chunk view shares the mapping, never closed itself
+        chunks[ chunkIndex ].chunkView = *mappedFile;
+        chunks[ chunkIndex ].chunkView.data = mappedFile->data + chunkStart;
+        chunks[ chunkIndex ].chunkView.length = chunkEnd - chunkStart;
+        chunks[ chunkIndex ].hash = hash;
+
+        // chunk with no thread is parsed here
+        chunks[ chunkIndex ].threadStarted = pthread_create(
+                     &threads[ chunkIndex ], NULL, parseUploadChunk,
+                                                  &chunks[ chunkIndex ] ) == 0;
+
+        if( !chunks[ chunkIndex ].threadStarted )
+           {
+            parseUploadChunk( &chunks[ chunkIndex ] );
+           }
+
+        chunkStart = chunkEnd;
+       }
+
+    // rows are inserted up to first malformed number, in file order
+    insertCount = threadCount;
+
+    for( chunkIndex = 0; chunkIndex < threadCount; chunkIndex++ )
+       {
+        if( chunks[ chunkIndex ].threadStarted )
+           {
+            pthread_join( threads[ chunkIndex ], NULL );
+           }
+
+        chunks[ chunkIndex ].firstRank = index + 1;
+
+        if( chunkIndex < insertCount )
+           {
+            index += chunks[ chunkIndex ].rowCount;
+           }
+
+        // report first malformed number, as offset in whole file
+        if( chunkIndex < insertCount
+             && chunks[ chunkIndex ].chunkView.parseStatus != PARSE_SUCCESS )
+           {
+            printf( "\nData error in %s at byte %lu: %s\n", fileName,
+                    (unsigned long)( chunks[ chunkIndex ].chunkView.data
+                       - mappedFile->data
+                       + chunks[ chunkIndex ].chunkView.parseErrorOffset ),
+                    getParseStatusString(
+                                 chunks[ chunkIndex ].chunkView.parseStatus ) );
+
+            insertCount = chunkIndex + 1;
+           }
+       }
+
+    // nodes are written only by insert threads, under stripe locks
+    parallelInsert = hash->chains == NULL && hash->indexHooks == NULL
+                      && hash->writeBarrier == NULL && !hash->showProbing
+                      && hash->probeStrategy != NO_PROBING
+                      && hash->tableSize > 0;
+
+    table.stripeLocks = NULL;
+    table.nodeRanks = NULL;
+
+    if( parallelInsert )
+       {
+        table.hash = hash;
+        table.stripeCount = hash->tableSize / UPLOAD_STRIPE_NODES + 1;
+        table.stripeLocks = (pthread_mutex_t *)malloc(
+                               table.stripeCount * sizeof( pthread_mutex_t ) );
+        table.nodeRanks = (int *)calloc( hash->tableSize, sizeof( int ) );
+
+        parallelInsert = table.stripeLocks != NULL && table.nodeRanks != NULL;
+       }
+
+    if( parallelInsert )
+       {
+        for( stripe = 0; stripe < table.stripeCount; stripe++ )
+           {
+            pthread_mutex_init( &table.stripeLocks[ stripe ], NULL );
+           }
+
+        for( chunkIndex = 0; chunkIndex < insertCount; chunkIndex++ )
+           {
+            chunks[ chunkIndex ].table = &table;
+
+            // chunk with no thread is inserted here
+            chunks[ chunkIndex ].threadStarted = pthread_create(
+                         &threads[ chunkIndex ], NULL, insertUploadChunk,
+                                                  &chunks[ chunkIndex ] ) == 0;
+
+            if( !chunks[ chunkIndex ].threadStarted )
+               {
+                insertUploadChunk( &chunks[ chunkIndex ] );
+               }
+           }
+
+        for( chunkIndex = 0; chunkIndex < insertCount; chunkIndex++ )
+           {
+            if( chunks[ chunkIndex ].threadStarted )
+               {
+                pthread_join( threads[ chunkIndex ], NULL );
+               }
+           }
+
+        // rows with no unused node (full table) are added as usual
+        for( chunkIndex = 0; chunkIndex < insertCount; chunkIndex++ )
+           {
+            for( rowIndex = 0; rowIndex < chunks[ chunkIndex ].leftoverCount;
+                                                                 rowIndex++ )
+               {
+                addItemFromStruct( hash,
+                                    chunks[ chunkIndex ].leftovers[ rowIndex ] );
+               }
+
+            free( chunks[ chunkIndex ].leftovers );
+           }
+
+        for( stripe = 0; stripe < table.stripeCount; stripe++ )
+           {
+            pthread_mutex_destroy( &table.stripeLocks[ stripe ] );
+           }
+       }
+
+    else
+       {
+        for( chunkIndex = 0; chunkIndex < insertCount; chunkIndex++ )
+           {
+            for( rowIndex = 0; rowIndex < chunks[ chunkIndex ].rowCount;
+                                                                 rowIndex++ )
+               {
+                row = &chunks[ chunkIndex ].rows[ rowIndex ];
+
+                addItemFromHashedView( hash, row->hashIndex, row->name,
+                                         row->nameLength, row->averageTemp,
+                                         row->lowestTemp, row->highestTemp );
+               }
+           }
+       }
+
+    for( chunkIndex = 0; chunkIndex < threadCount; chunkIndex++ )
+       {
+        free( chunks[ chunkIndex ].rows );
+       }
+
+    free( table.stripeLocks );
+    free( table.nodeRanks );
+    free( threads );
+    free( chunks );
+    closeMappedFile( mappedFile );
+
+    return index;
+   }
@@ -0,0 +1,123 @@
+/*
+Data upload utility, function prototypes
+
+Loaders that fill a hash table from a state temperature CSV file
+(state name, average, lowest, highest temperature per line).
+*/
+
+// PreProcessor test
+#ifndef DATA_UPLOAD_UTILITY_H
+#define DATA_UPLOAD_UTILITY_H
+
+// header files
+#include "File_Input_Utility.h"
+#include "HashUtilities.h"
+#include "Mapped_Input_Utility.h"
+
+// constants
+
+    // smallest share of a file given to one upload thread, in bytes
+    static const size_t MIN_UPLOAD_CHUNK_SIZE = 1048576;
+
+    // table nodes per lock of parallel insert
+    static const int UPLOAD_STRIPE_NODES = 256;
+
+// function prototypes
+
+/*
+Name: getProcessorCount
+Process: finds number of online processors, at least one
+Function input/parameters: none
+Function output/parameters: none
+Function output/returned: processor count (int)
+Device input/---: none
+Device output/---: none
+Dependencies: sysconf
+*/
+int getProcessorCount( void );
+
+/*
+Name: uploadData
+Process: uploads data from file with unknown number of data sets,
+         stops with message at first malformed number,
+         has internal Verbose Boolean to display input operation
+Function input/parameters: file name (char *), table size (int),
+                           probe type (int)
+Function output/parameters: none
+Function output/returned: pointer to hash table (ProbingHashType *)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: initializeHashTable, uploadDataFromReader, free
+*/
+ProbingHashType *uploadData( char *fileName, int tableSize, int probeType );
+
+/*
+Name: uploadDataFromMap
+Process: uploads data from memory mapped file into given hash table,
+         state names are inserted straight from the mapping
+         with no intermediate string buffer,
+         stops with message at first malformed number
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be mapped (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openMappedFile, readViewToDelimiterFromMap, readDoubleFromMap,
+              readCharacterFromMap, getMapParseStatus, printf,
+              addItemFromView, closeMappedFile
+*/
+int uploadDataFromMap( ProbingHashType *hash, const char *fileName );
+
+/*
+Name: uploadDataFromReader
+Process: uploads data from file into given hash table through buffered
+         input reader with background read ahead, as uploadData does,
+         stops with message at first malformed number,
+         has internal Verbose Boolean to display input operation
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be opened (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openInputReaderWithReadAhead, readStringToDelimiterFromReader, 
+              readDoubleFromReader, readCharacterFromReader, 
+              getReaderParseStatus, printf, addItemFromData, closeInputReader
+*/
+int uploadDataFromReader( ProbingHashType *hash, const char *fileName );
+
+/*
+Name: uploadDataParallel
+Process: uploads data from memory mapped file into given hash table
+         using a pool of threads: file is split into newline aligned
+         chunks, each thread tokenizes, parses and hashes one chunk,
+         then inserts its rows, locking stripes of table nodes as it
+         probes them; finds give the same items as after the single
+         threaded loaders, though items may sit in other nodes;
+         tables with chains, index hooks (including filter), write
+         barrier, or probing display have rows inserted in file order
+         on calling thread instead;
+         uses all processors if thread count is not positive,
+         fewer threads for small files, chunk whose thread could
+         not be started is handled on calling thread,
+         stops with message at first malformed number
+Function input/parameters: hash table (ProbingHashType *),
+                           file name (const char *), thread count (int)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of items loaded,
+                          or -1 if file could not be mapped (int)
+Device input/file: data from HD
+Device output/monitor: none
+Dependencies: openMappedFile, pthread_create, pthread_join,
+              parseUploadChunk, printf, malloc, calloc,
+              pthread_mutex_init, insertUploadChunk, addItemFromStruct,
+              pthread_mutex_destroy, addItemFromHashedView,
+              closeMappedFile, free
+*/
+int uploadDataParallel( ProbingHashType *hash, const char *fileName,
+                                                             int threadCount );
+
+#endif  // DATA_UPLOAD_UTILITY_H
@@ -10,6 +10,8 @@ non-commercial use as long as the above copyright statement is included.
 // header files
 #include "File_Input_Utility.h"
 #include <stdlib.h> //////////////////////////test
+#include <string.h>
+#include "Scan_Utility.h"
 
 // local global constants, used only in this file
 
@@ -33,6 +35,14 @@ non-commercial use as long as the above copyright statement is included.
     //   accessOpenFlag
     const int SET_INPUT_FLAG = 1001;
 
+// local function prototypes, used only in this file
+
+    int fillReaderBuffer( InputReaderType *reader, int minimumAvailable );
+
+    int fillReaderBufferFromReadAhead( InputReaderType *reader, 
+                                                        int minimumAvailable );
+
+    void *readAheadWorker( void *readerPtr );
 
     /*
     Name: accessEndOfInputFileFlag
@@ -714,5 +724,715 @@ non-commercial use as long as the above copyright statement is included.
                                              capturedString );
        }
 
+    /*
+    Name: checkForEndOfReader
+    process: checks to see if end of file has been encountered by reader,
+             returns true if EOF has been encountered, false otherwise
+    Function input/parameters: reader (const InputReaderType *)
+    Function output/parameters: none
+    Function output/returned: result of specified test (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    bool checkForEndOfReader( const InputReaderType *reader )
+       {
+        // return reader end of file flag
+        return reader->endOfFileFlag;
+       }
+
+    /*
+    Name: clearLeadingWhiteSpaceFromReader
+    process: skips non printable characters in reader buffer,
+             and space if flag set,
+             returns first non white space value found as integer,
+             consuming it, or EOF if none found
+    Function input/parameters: reader (InputReaderType *),
+                               clear space flag (bool)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: first non WS character as integer
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: fillReaderBuffer, skipWhiteSpace
+    */
+    int clearLeadingWhiteSpaceFromReader( InputReaderType *reader,
+                                                              bool clearSpace )
+       {
+        // initialize variables
+        const char *startPtr, *endPtr, *foundPtr;
+
+        // loop across buffer refills
+        while( reader->bufferIndex < reader->bufferLength
+                                           || fillReaderBuffer( reader, 1 ) > 0 )
+           {
+            // skip white space in all buffered bytes
+               // function: skipWhiteSpace
+            startPtr = reader->buffer + reader->bufferIndex;
+            endPtr = reader->buffer + reader->bufferLength;
+            foundPtr = skipWhiteSpace( startPtr, endPtr, clearSpace );
+
+            reader->bufferIndex += (int)( foundPtr - startPtr );
+
+            // return, consume character if found
+            if( foundPtr < endPtr )
+               {
+                reader->bufferIndex++;
+
+                return (unsigned char)*foundPtr;
+               }
+           }
+
+        // no data left
+        return EOF;
+       }
+
+    /*
+    Name: closeInputReader
+    process: stops read ahead thread if any, closes reader file,
+             releases reader buffers and reader,
+             returns true if successful, false otherwise
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: none
+    Function output/returned: success of operation (bool)
+    Device input/file: file closed
+    Device output/monitor: none
+    Dependencies: pthread_join, fclose, free
+    */
+    bool closeInputReader( InputReaderType *reader )
+       {
+        // check for valid reader
+        if( reader != NULL )
+           {
+            // stop and wait for read ahead thread
+               // function: pthread_join
+            if( reader->readAhead )
+               {
+                pthread_mutex_lock( &reader->readAheadLock );
+                reader->stopReadAhead = true;
+                pthread_cond_broadcast( &reader->readAheadSignal );
+                pthread_mutex_unlock( &reader->readAheadLock );
+
+                pthread_join( reader->readAheadThread, NULL );
+
+                pthread_cond_destroy( &reader->readAheadSignal );
+                pthread_mutex_destroy( &reader->readAheadLock );
+                free( reader->standbyBuffer );
+               }
+
+            // close file, release memory
+               // function: fclose, free
+            fclose( reader->filePtr );
+            free( reader->buffer );
+            free( reader );
+
+            // return successful operation
+            return true;
+           }
+
+        // return failed operation
+        return false;
+       }
+
+    /*
+    Name: fillReaderBuffer
+    process: moves unread bytes to front of reader buffer and refills
+             the remainder from file when fewer than the requested
+             bytes are available; buffer is always NULL_CHAR terminated
+    Function input/parameters: reader (InputReaderType *),
+                               minimum available bytes (int)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: number of unread bytes available (int)
+    Device input/file: data read from file
+    Device output/monitor: none
+    Dependencies: memmove, fread, fillReaderBufferFromReadAhead
+    */
+    int fillReaderBuffer( InputReaderType *reader, int minimumAvailable )
+       {
+        // initialize variables
+        int available = reader->bufferLength - reader->bufferIndex;
+        size_t bytesRead = 1;
+
+        // check for blocks supplied by read ahead thread
+        if( reader->readAhead )
+           {
+            return fillReaderBufferFromReadAhead( reader, minimumAvailable );
+           }
+
+        // check for refill needed
+        if( available < minimumAvailable )
+           {
+            // move unread bytes to front of buffer
+               // function: memmove
+            memmove( reader->buffer, reader->buffer + reader->bufferIndex,
+                                                                    available );
+            reader->bufferFileOffset += reader->bufferIndex;
+            reader->bufferIndex = 0;
+            reader->bufferLength = available;
+
+            // fill until request met, buffer full, or file drained
+            while( reader->bufferLength < minimumAvailable
+                    && reader->bufferLength < reader->bufferCapacity
+                                                             && bytesRead > 0 )
+               {
+                // function: fread
+                bytesRead = fread( reader->buffer + reader->bufferLength, 1,
+                                 reader->bufferCapacity - reader->bufferLength,
+                                                              reader->filePtr );
+
+                reader->bufferLength += (int)bytesRead;
+               }
+
+            // terminate buffer for in place conversions
+            reader->buffer[ reader->bufferLength ] = NULL_CHAR;
+
+            available = reader->bufferLength;
+           }
+
+        // return unread byte count
+        return available;
+       }
+
+    /*
+    Name: fillReaderBufferFromReadAhead
+    process: when fewer than the requested bytes are available,
+             waits for the read ahead thread's standby block,
+             copies unread bytes to just before that block and swaps
+             buffers, handing the old buffer back to the thread to refill;
+             both buffers keep HUGE_STR_LEN bytes of room before the block
+    Function input/parameters: reader (InputReaderType *),
+                               minimum available bytes (int)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: number of unread bytes available (int)
+    Device input/file: none (read by thread)
+    Device output/monitor: none
+    Dependencies: pthread_mutex_lock, pthread_cond_wait, 
+                  pthread_cond_signal, memcpy
+    */
+    int fillReaderBufferFromReadAhead( InputReaderType *reader, 
+                                                         int minimumAvailable )
+       {
+        // initialize variables
+        int available = reader->bufferLength - reader->bufferIndex;
+        int newStart;
+        char *swapBuffer;
+
+        // swap in blocks until request met or file drained
+        while( available < minimumAvailable )
+           {
+            // wait for standby block
+               // function: pthread_mutex_lock, pthread_cond_wait
+            pthread_mutex_lock( &reader->readAheadLock );
+
+            while( !reader->standbyFull )
+               {
+                pthread_cond_wait( &reader->readAheadSignal, 
+                                                       &reader->readAheadLock );
+               }
+
+            // check for file drained, empty block stays as end marker
+            if( reader->standbyLength == 0 )
+               {
+                pthread_mutex_unlock( &reader->readAheadLock );
+
+                break;
+               }
+
+            // place unread bytes just before new block, swap buffers
+               // function: memcpy
+            newStart = HUGE_STR_LEN - available;
+
+            memcpy( reader->standbyBuffer + newStart, 
+                       reader->buffer + reader->bufferIndex, available );
+
+            reader->bufferFileOffset += reader->bufferIndex - newStart;
+            reader->bufferIndex = newStart;
+            reader->bufferLength = HUGE_STR_LEN + reader->standbyLength;
+
+            swapBuffer = reader->buffer;
+            reader->buffer = reader->standbyBuffer;
+            reader->standbyBuffer = swapBuffer;
+
+            // hand old buffer back to thread
+               // function: pthread_cond_signal
+            reader->standbyFull = false;
+            pthread_cond_signal( &reader->readAheadSignal );
+            pthread_mutex_unlock( &reader->readAheadLock );
+
+            // terminate buffer for in place conversions
+            reader->buffer[ reader->bufferLength ] = NULL_CHAR;
+
+            available = reader->bufferLength - reader->bufferIndex;
+           }
+
+        // return unread byte count
+        return available;
+       }
+
+    /*
+    Name: getReaderParseStatus
+    process: provides status of first failed number conversion by reader,
+             PARSE_SUCCESS if none has failed
+    Function input/parameters: reader (const InputReaderType *)
+    Function output/parameters: file byte offset of failed number,
+                                if any (long long *)
+    Function output/returned: first failed parse status (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    ParseStatusType getReaderParseStatus( const InputReaderType *reader,
+                                                        long long *errorOffset )
+       {
+        // set offset, return status
+        *errorOffset = reader->parseErrorOffset;
+
+        return reader->parseStatus;
+       }
+
+    /*
+    Name: openInputReader
+    process: opens input file into new reader context with read buffer
+             of given size (DEFAULT_READER_BUFFER_SIZE if not positive),
+             returns NULL if file cannot be opened
+    Function input/parameters: file name (c-string), buffer size (int)
+    Function output/parameters: none
+    Function output/returned: pointer to created reader (InputReaderType *)
+    Device input/file: file opened
+    Device output/monitor: none
+    Dependencies: fopen, malloc, free
+    */
+    InputReaderType *openInputReader( const char *fileName, int bufferSize )
+       {
+        // initialize variables
+        InputReaderType *reader;
+        FILE *filePtr;
+
+        // check for default buffer size, must hold at least one full field
+        if( bufferSize <= 0 )
+           {
+            bufferSize = DEFAULT_READER_BUFFER_SIZE;
+           }
+
+        if( bufferSize < HUGE_STR_LEN )
+           {
+            bufferSize = HUGE_STR_LEN;
+           }
+
+        // open file
+           // function: fopen
+        filePtr = fopen( fileName, "rb" );
+
+        if( filePtr == NULL )
+           {
+            return NULL;
+           }
+
+        // allocate reader and buffer, with room for terminator
+           // function: malloc
+        reader = (InputReaderType *)malloc( sizeof( InputReaderType ) );
+        reader->buffer = (char *)malloc( bufferSize + 1 );
+
+        // initialize reader state
+        reader->filePtr = filePtr;
+        reader->bufferCapacity = bufferSize;
+        reader->bufferLength = 0;
+        reader->bufferIndex = 0;
+        reader->bufferFileOffset = 0;
+        reader->endOfFileFlag = false;
+        reader->parseStatus = PARSE_SUCCESS;
+        reader->parseErrorOffset = 0;
+        reader->readAhead = false;
+        reader->standbyBuffer = NULL;
+        reader->buffer[ 0 ] = NULL_CHAR;
+
+        // return new reader
+        return reader;
+       }
+
+    /*
+    Name: openInputReaderWithReadAhead
+    process: opens input file into new reader context as openInputReader,
+             then starts a thread that reads the next block of given size
+             into a standby buffer while the current block is parsed,
+             so file input and parsing overlap; if the thread cannot
+             be started, reader falls back to plain buffered reads,
+             returns NULL if file cannot be opened
+    Function input/parameters: file name (c-string), block size (int)
+    Function output/parameters: none
+    Function output/returned: pointer to created reader (InputReaderType *)
+    Device input/file: file opened, read by thread
+    Device output/monitor: none
+    Dependencies: openInputReader, malloc, free, pthread_mutex_init,
+                  pthread_cond_init, pthread_create, readAheadWorker,
+                  pthread_cond_destroy, pthread_mutex_destroy
+    */
+    InputReaderType *openInputReaderWithReadAhead( const char *fileName, 
+                                                               int bufferSize )
+       {
+        // open plain reader
+           // function: openInputReader
+        InputReaderType *reader = openInputReader( fileName, bufferSize );
+
+        if( reader == NULL )
+           {
+            return NULL;
+           }
+
+        // replace buffer with pair that keeps room for carried over bytes
+           // function: free, malloc
+        free( reader->buffer );
+        reader->buffer = (char *)malloc( 
+                                 HUGE_STR_LEN + reader->bufferCapacity + 1 );
+        reader->standbyBuffer = (char *)malloc( 
+                                 HUGE_STR_LEN + reader->bufferCapacity + 1 );
+        reader->buffer[ 0 ] = NULL_CHAR;
+
+        // start thread reading first block
+           // function: pthread_mutex_init, pthread_cond_init, pthread_create
+        reader->readAhead = true;
+        reader->standbyFull = false;
+        reader->stopReadAhead = false;
+        reader->standbyLength = 0;
+
+        pthread_mutex_init( &reader->readAheadLock, NULL );
+        pthread_cond_init( &reader->readAheadSignal, NULL );
+
+        // check for thread not started, fall back to plain buffered reads
+           // function: pthread_mutex_destroy, pthread_cond_destroy, free
+        if( pthread_create( &reader->readAheadThread, NULL, 
+                                              readAheadWorker, reader ) != 0 )
+           {
+            pthread_cond_destroy( &reader->readAheadSignal );
+            pthread_mutex_destroy( &reader->readAheadLock );
+            free( reader->standbyBuffer );
+
+            reader->standbyBuffer = NULL;
+            reader->readAhead = false;
+           }
+
+        // return new reader
+        return reader;
+       }
+
+    /*
+    Name: readAheadWorker
+    process: thread function, fills standby buffer with next file block
+             whenever the parser has taken the previous one,
+             marks an empty block at end of file, then exits
+    Function input/parameters: reader (void *, InputReaderType *)
+    Function output/parameters: updated standby buffer (InputReaderType *)
+    Function output/returned: NULL (void *)
+    Device input/file: data read from file
+    Device output/monitor: none
+    Dependencies: pthread_mutex_lock, pthread_cond_wait, fread,
+                  pthread_cond_signal
+    */
+    void *readAheadWorker( void *readerPtr )
+       {
+        // initialize variables
+        InputReaderType *reader = (InputReaderType *)readerPtr;
+        char *blockPtr;
+        size_t blockLength, bytesRead;
+
+        pthread_mutex_lock( &reader->readAheadLock );
+
+        while( !reader->stopReadAhead )
+           {
+            // wait until standby buffer is free
+            if( reader->standbyFull )
+               {
+                pthread_cond_wait( &reader->readAheadSignal, 
+                                                       &reader->readAheadLock );
+
+                continue;
+               }
+
+            // fill block outside lock, parser does not touch free standby
+            blockPtr = reader->standbyBuffer + HUGE_STR_LEN;
+            pthread_mutex_unlock( &reader->readAheadLock );
+
+            blockLength = 0;
+            bytesRead = 1;
+
+            while( blockLength < (size_t)reader->bufferCapacity 
+                                                              && bytesRead > 0 )
+               {
+                // function: fread
+                bytesRead = fread( blockPtr + blockLength, 1, 
+                         reader->bufferCapacity - blockLength, reader->filePtr );
+
+                blockLength += bytesRead;
+               }
+
+            // publish block
+            pthread_mutex_lock( &reader->readAheadLock );
+
+            reader->standbyLength = (int)blockLength;
+            reader->standbyFull = true;
+            pthread_cond_signal( &reader->readAheadSignal );
+
+            // empty block marks end of file
+            if( blockLength == 0 )
+               {
+                break;
+               }
+           }
+
+        pthread_mutex_unlock( &reader->readAheadLock );
+
+        return NULL;
+       }
+
+    /*
+    Name: readCharacterFromReader
+    process: ignores leading unprintable characters, including space,
+             captures first printable character
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: character found if successful, ZERO_CHAR otherwise
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader
+    */
+    char readCharacterFromReader( InputReaderType *reader )
+       {
+        // initialize variables
+        int intChar = ZERO_CHAR;
+
+        // check for data accessible
+        if( !reader->endOfFileFlag )
+           {
+            // get character
+               // function: clearLeadingWhiteSpaceFromReader
+            intChar = clearLeadingWhiteSpaceFromReader( reader, true );
+
+            // check for end of file found
+            if( intChar == EOF )
+               {
+                // set end of file flag, set return value to zero
+                reader->endOfFileFlag = true;
+                intChar = ZERO_CHAR;
+               }
+           }
+
+        // return value as character
+        return (char)intChar;
+       }
+
+    /*
+    Name: readDoubleFromReader
+    process: ignores leading unprintable characters,
+             captures first contiguous double value from reader buffer
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: double value found if successful,
+                              ZERO_VALUE otherwise
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader, fillReaderBuffer, 
+                  parseDoubleFromSpan
+    */
+    double readDoubleFromReader( InputReaderType *reader )
+       {
+        // initialize variables
+        double doubleVal = ZERO_VALUE;
+        const char *startPtr, *endPtr;
+        ParseStatusType status;
+
+        // check for data accessible
+        if( !reader->endOfFileFlag )
+           {
+            // skip leading white space, including space
+               // function: clearLeadingWhiteSpaceFromReader
+            if( clearLeadingWhiteSpaceFromReader( reader, true ) == EOF )
+               {
+                // set end of file flag
+                reader->endOfFileFlag = true;
+
+                return ZERO_VALUE;
+               }
+
+            // step back to first character, make sure whole number is loaded
+               // function: fillReaderBuffer
+            reader->bufferIndex--;
+            fillReaderBuffer( reader, HUGE_STR_LEN );
+
+            // convert in place
+               // function: parseDoubleFromSpan
+            startPtr = reader->buffer + reader->bufferIndex;
+            status = parseDoubleFromSpan( startPtr, 
+                  reader->buffer + reader->bufferLength, &doubleVal, &endPtr );
+
+            // keep first failure and where it happened
+            if( status != PARSE_SUCCESS 
+                                      && reader->parseStatus == PARSE_SUCCESS )
+               {
+                reader->parseStatus = status;
+                reader->parseErrorOffset = 
+                            reader->bufferFileOffset + reader->bufferIndex;
+               }
+
+            // consume converted characters
+            reader->bufferIndex += (int)( endPtr - startPtr );
+           }
+
+        // return acquired value
+        return doubleVal;
+       }
+
+   /*
+    Name: readStringConfiguredFromReader
+    Process: captures string from reader buffer, options as specified
+             for readStringConfiguredFromFile
+    Function input/parameters: reader (InputReaderType *),
+                               see readStringConfiguredFromFile
+    Function output/parameters: captured string (char *), EMPTY_STRING otherwise
+    Function output/returned: success of operation (bool)
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader, fillReaderBuffer,
+                  findDelimiterOrControl, memchr, memcpy
+    */
+   bool readStringConfiguredFromReader( InputReaderType *reader,
+                                        bool clearLeadingNonPrintable,
+                                        bool clearLeadingSpace,
+                                        bool stopAtNonPrintable,
+                                        char delimiter,
+                                        char *capturedString )
+      {
+       // initialize variables
+       int intChar = EOF, index = 0, available;
+       const char *startPtr, *stopPtr;
+
+       // initialize output string
+       capturedString[ index ] = NULL_CHAR;
+
+       // check for data accessible
+       if( reader->endOfFileFlag )
+          {
+           return false;
+          }
+
+       // check for clearing non printable
+       if( clearLeadingNonPrintable )
+          {
+           // function: clearLeadingWhiteSpaceFromReader
+           intChar = clearLeadingWhiteSpaceFromReader( reader,
+                                                           clearLeadingSpace );
+          }
+
+       // otherwise, clear spaces only if requested
+       else
+          {
+           do
+              {
+               intChar = EOF;
+
+               if( fillReaderBuffer( reader, 1 ) > 0 )
+                  {
+                   intChar =
+                        (unsigned char)reader->buffer[ reader->bufferIndex ];
+                   reader->bufferIndex++;
+                  }
+              }
+           while( clearLeadingSpace && intChar == (int)SPACE );
+          }
+
+       // check for end of file found
+       if( intChar == EOF )
+          {
+           // set end of file flag, return failed operation
+           reader->endOfFileFlag = true;
+
+           return false;
+          }
+
+       // first character is still in buffer, capture it with the rest
+       reader->bufferIndex--;
 
+       // loop to capture input in buffered runs,
+       // same stop conditions as file version
+       while( reader->bufferIndex < reader->bufferLength
+                                           || fillReaderBuffer( reader, 1 ) > 0 )
+          {
+           // check for full string, stopping character is still consumed
+           if( index == MAX_STR_LEN - 1 )
+              {
+               reader->bufferIndex++;
 
+               break;
+              }
+
+           // find stopping character in buffered bytes that fit string
+              // function: findDelimiterOrControl, memchr
+           startPtr = reader->buffer + reader->bufferIndex;
+           available = reader->bufferLength - reader->bufferIndex;
+
+           if( available > MAX_STR_LEN - 1 - index )
+              {
+               available = MAX_STR_LEN - 1 - index;
+              }
+
+           if( stopAtNonPrintable )
+              {
+               stopPtr = findDelimiterOrControl( startPtr, startPtr + available,
+                                                                   delimiter );
+              }
+
+           else
+              {
+               stopPtr = (const char *)memchr( startPtr, delimiter, available );
+
+               if( stopPtr == NULL )
+                  {
+                   stopPtr = startPtr + available;
+                  }
+              }
+
+           // place run in string, terminate string
+           memcpy( capturedString + index, startPtr, stopPtr - startPtr );
+           index += (int)( stopPtr - startPtr );
+           capturedString[ index ] = NULL_CHAR;
+
+           reader->bufferIndex += (int)( stopPtr - startPtr );
+
+           // check for stopping character found, consume it
+           if( stopPtr < startPtr + available )
+              {
+               reader->bufferIndex++;
+
+               break;
+              }
+          }
+
+       // return successful operation
+       return true;
+      }
+
+   /*
+    Name: readStringToDelimiterFromReader
+    process: ignores leading white space, including space character,
+             captures series of characters up to specified character
+    Function input/parameters: reader (InputReaderType *), delimiter (char)
+    Function output/parameters: captured string (char *), EMPTY_STRING otherwise
+    Function output/returned: string found if successful
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: readStringConfiguredFromReader with appropriate parameters
+    */
+    bool readStringToDelimiterFromReader( InputReaderType *reader,
+                                          char delimiter, char *capturedString )
+       {
+        // initialize variables
+        bool clearLeadingNonPrintable = true;
+        bool clearLeadingSpace = true;
+        bool stopAtNonPrintable = true;
+
+        // call utility function, return
+        return readStringConfiguredFromReader( reader,
+                                               clearLeadingNonPrintable,
+                                               clearLeadingSpace,
+                                               stopAtNonPrintable,
+                                               delimiter,
+                                               capturedString );
+       }
@@ -32,7 +32,9 @@ UTILITY USAGE INSTRUCTIONS:
 // header files
 #include <stdbool.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "StandardConstants.h"
+#include "Number_Parse_Utility.h"
 
 // constants shared with other files
 
@@ -45,6 +47,36 @@ UTILITY USAGE INSTRUCTIONS:
     // constant used for zero int/double value return
     static const char ZERO_VALUE = 0;
 
+    // default read buffer size for input readers, in bytes
+    static const int DEFAULT_READER_BUFFER_SIZE = 1048576;
+
+// data structures
+
+    // input reader context, owns its file and read buffer so that
+    // several files may be parsed at once (one reader per thread);
+    // a read ahead reader also owns a standby buffer that its thread
+    // fills from the file while the current buffer is parsed
+    typedef struct InputReaderStruct
+       {
+        FILE *filePtr;
+        char *buffer;
+        int bufferCapacity;
+        int bufferLength;
+        int bufferIndex;
+        long long bufferFileOffset;
+        bool endOfFileFlag;
+        ParseStatusType parseStatus;
+        long long parseErrorOffset;
+        bool readAhead;
+        bool standbyFull;
+        bool stopReadAhead;
+        char *standbyBuffer;
+        int standbyLength;
+        pthread_t readAheadThread;
+        pthread_mutex_t readAheadLock;
+        pthread_cond_t readAheadSignal;
+       } InputReaderType;
+
 // function prototypes
 
     /*
@@ -291,5 +323,163 @@ UTILITY USAGE INSTRUCTIONS:
     */
     bool readStringToDelimiterFromFile( char delimiter, char *capturedString );
 
+// reader context function prototypes
+
+    /*
+    Name: checkForEndOfReader
+    process: checks to see if end of file has been encountered by reader,
+             returns true if EOF has been encountered, false otherwise
+    Function input/parameters: reader (const InputReaderType *)
+    Function output/parameters: none
+    Function output/returned: result of specified test (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    bool checkForEndOfReader( const InputReaderType *reader );
+
+    /*
+    Name: clearLeadingWhiteSpaceFromReader
+    process: skips non printable characters in reader buffer,
+             and space if flag set,
+             returns first non white space value found as integer,
+             consuming it, or EOF if none found
+    Function input/parameters: reader (InputReaderType *),
+                               clear space flag (bool)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: first non WS character as integer
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: fillReaderBuffer
+    */
+    int clearLeadingWhiteSpaceFromReader( InputReaderType *reader,
+                                                              bool clearSpace );
+
+    /*
+    Name: getReaderParseStatus
+    process: provides status of first failed number conversion by reader,
+             PARSE_SUCCESS if none has failed
+    Function input/parameters: reader (const InputReaderType *)
+    Function output/parameters: file byte offset of failed number,
+                                if any (long long *)
+    Function output/returned: first failed parse status (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    ParseStatusType getReaderParseStatus( const InputReaderType *reader,
+                                                       long long *errorOffset );
+
+    /*
+    Name: closeInputReader
+    process: stops read ahead thread if any, closes reader file,
+             releases reader buffers and reader,
+             returns true if successful, false otherwise
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: none
+    Function output/returned: success of operation (bool)
+    Device input/file: file closed
+    Device output/monitor: none
+    Dependencies: pthread_join, fclose, free
+    */
+    bool closeInputReader( InputReaderType *reader );
+
+    /*
+    Name: openInputReader
+    process: opens input file into new reader context with read buffer
+             of given size (DEFAULT_READER_BUFFER_SIZE if not positive),
+             returns NULL if file cannot be opened
+    Function input/parameters: file name (c-string), buffer size (int)
+    Function output/parameters: none
+    Function output/returned: pointer to created reader (InputReaderType *)
+    Device input/file: file opened
+    Device output/monitor: none
+    Dependencies: fopen, malloc, free
+    */
+    InputReaderType *openInputReader( const char *fileName, int bufferSize );
+
+    /*
+    Name: openInputReaderWithReadAhead
+    process: opens input file into new reader context as openInputReader,
+             then starts a thread that reads the next block of given size
+             into a standby buffer while the current block is parsed,
+             so file input and parsing overlap; if the thread cannot
+             be started, reader falls back to plain buffered reads,
+             returns NULL if file cannot be opened
+    Function input/parameters: file name (c-string), block size (int)
+    Function output/parameters: none
+    Function output/returned: pointer to created reader (InputReaderType *)
+    Device input/file: file opened, read by thread
+    Device output/monitor: none
+    Dependencies: openInputReader, malloc, free, pthread_mutex_init,
+                  pthread_cond_init, pthread_create, readAheadWorker,
+                  pthread_cond_destroy, pthread_mutex_destroy
+    */
+    InputReaderType *openInputReaderWithReadAhead( const char *fileName, 
+                                                              int bufferSize );
+
+    /*
+    Name: readCharacterFromReader
+    process: ignores leading unprintable characters, including space,
+             captures first printable character
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: character found if successful, ZERO_CHAR otherwise
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader
+    */
+    char readCharacterFromReader( InputReaderType *reader );
+
+    /*
+    Name: readDoubleFromReader
+    process: ignores leading unprintable characters,
+             captures first contiguous double value from reader buffer,
+             records first failed conversion and its position in reader
+             (see getReaderParseStatus), end of file flag is only set
+             when no data remains
+    Function input/parameters: reader (InputReaderType *)
+    Function output/parameters: updated reader (InputReaderType *)
+    Function output/returned: double value found if successful,
+                              ZERO_VALUE otherwise
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader, parseDoubleFromSpan
+    */
+    double readDoubleFromReader( InputReaderType *reader );
+
+   /*
+    Name: readStringConfiguredFromReader
+    Process: captures string from reader buffer, options as specified
+             for readStringConfiguredFromFile
+    Function input/parameters: reader (InputReaderType *),
+                               see readStringConfiguredFromFile
+    Function output/parameters: captured string (char *), EMPTY_STRING otherwise
+    Function output/returned: success of operation (bool)
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: clearLeadingWhiteSpaceFromReader, fillReaderBuffer
+    */
+   bool readStringConfiguredFromReader( InputReaderType *reader,
+                                        bool clearLeadingNonPrintable,
+                                        bool clearLeadingSpace,
+                                        bool stopAtNonPrintable,
+                                        char delimiter,
+                                        char *capturedString );
+
+   /*
+    Name: readStringToDelimiterFromReader
+    process: ignores leading white space, including space character,
+             captures series of characters up to specified character
+    Function input/parameters: reader (InputReaderType *), delimiter (char)
+    Function output/parameters: captured string (char *), EMPTY_STRING otherwise
+    Function output/returned: string found if successful
+    Device input/file: buffer refilled from file as needed
+    Device output/monitor: none
+    Dependencies: readStringConfiguredFromReader with appropriate parameters
+    */
+    bool readStringToDelimiterFromReader( InputReaderType *reader,
+                                          char delimiter, char *capturedString );
+
 #endif  // FILE_INPUT_UTILITY_H
 
@@ -0,0 +1,323 @@
+/*
+Generic hash table, macro instantiated specializations
+
+DEFINE_HASH_TABLE( Name, KeyType, ValueType, hashFunction, equalFunction )
+defines a hash table type and its functions for one key and value type.
+Hash and compare functions are called directly by name in each
+specialization, so the compiler can inline them; there are no void
+pointers or function pointer calls.
+
+hashFunction must be callable as uint64_t hashFunction( const KeyType * ),
+equalFunction as bool equalFunction( const KeyType *, const KeyType * );
+both are best declared static inline ahead of the macro.
+
+Open addressing with linear or quadratic probing (ProbeType), fixed
+table size as with ProbingHashType; removed entries are marked so
+searches stop at the first never used entry.
+*/
+
+// PreProcessor test
+#ifndef GENERIC_HASH_TABLE_H
+#define GENERIC_HASH_TABLE_H
+
+// header files
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "HashUtilities.h"
+
+// constants
+
+    // index returned when key is not in table
+    static const int GENERIC_ITEM_NOT_FOUND = -1;
+
+    // state of table entry
+    typedef enum { GENERIC_EMPTY_ENTRY, GENERIC_USED_ENTRY,
+                                  GENERIC_REMOVED_ENTRY } GenericEntryStateType;
+
+// function prototypes
+
+/*
+Name: getGenericBytesHash
+Process: 64 bit hash of bytes (FNV-1a with splitmix64 finish),
+         ready made hash for keys held as plain bytes or strings
+Function input/parameters: data (const void *), data length (size_t)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline uint64_t getGenericBytesHash( const void *data, size_t length )
+   {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    size_t index;
+
+    for( index = 0; index < length; index++ )
+       {
+        hash = ( hash ^ bytes[ index ] ) * 0x100000001B3ULL;
+       }
+
+    hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return hash ^ ( hash >> 31 );
+   }
+
+/*
+Name: getGenericIntegerHash
+Process: 64 bit hash of integer key (splitmix64 finish)
+Function input/parameters: key (uint64_t)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline uint64_t getGenericIntegerHash( uint64_t key )
+   {
+    key = ( key ^ ( key >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    key = ( key ^ ( key >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return key ^ ( key >> 31 );
+   }
+
+/*
+Functions defined by DEFINE_HASH_TABLE for given Name
+
+Name: add<Name>Item
+Process: adds key and value to table, replaces value if key is
+         already in table, reuses first removed entry probed
+Function input/parameters: table (<Name>Type *), key (const KeyType *),
+                           value (const ValueType *)
+Function output/parameters: updated table (<Name>Type *)
+Function output/returned: true if added or replaced,
+                          false if no entry was free (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: hashFunction, equalFunction
+
+Name: clear<Name>
+Process: releases table and its array
+Function input/parameters: table (<Name>Type *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+
+Name: find<Name>Index
+Process: finds index of key, probing until key, a never used entry,
+         or tableSize probes
+Function input/parameters: table (const <Name>Type *), key (const KeyType *)
+Function output/parameters: none
+Function output/returned: index or GENERIC_ITEM_NOT_FOUND (int)
+Device input/---: none
+Device output/---: none
+Dependencies: hashFunction, equalFunction
+
+Name: find<Name>Item
+Process: finds value of key in table
+Function input/parameters: table (const <Name>Type *), key (const KeyType *)
+Function output/parameters: none
+Function output/returned: pointer to value in table,
+                          or NULL if not found (ValueType *)
+Device input/---: none
+Device output/---: none
+Dependencies: find<Name>Index
+
+Name: initialize<Name>
+Process: creates table of given capacity, all entries never used
+Function input/parameters: capacity (int), probe strategy (ProbeType)
+Function output/parameters: none
+Function output/returned: pointer to created table,
+                          or NULL if out of memory (<Name>Type *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free
+
+Name: remove<Name>Item
+Process: finds key in table, marks entry removed
+Function input/parameters: table (<Name>Type *), key (const KeyType *)
+Function output/parameters: updated table (<Name>Type *),
+                            removed value, if pointer not NULL (ValueType *)
+Function output/returned: true if removed, false if not found (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: find<Name>Index
+*/
+#define DEFINE_HASH_TABLE( Name, KeyType, ValueType,                          \
+                                             hashFunction, equalFunction )    \
+                                                                              \
+    typedef struct Name##EntryStruct                                          \
+       {                                                                      \
+        KeyType key;                                                          \
+        ValueType value;                                                      \
+        unsigned char state;                                                  \
+       } Name##EntryType;                                                     \
+                                                                              \
+    typedef struct Name##Struct                                               \
+       {                                                                      \
+        Name##EntryType *array;                                               \
+        int tableSize;                                                        \
+        int itemCount;                                                        \
+        ProbeType probeStrategy;                                              \
+       } Name##Type;                                                          \
+                                                                              \
+static inline int find##Name##Index( const Name##Type *table,                 \
+                                                         const KeyType *key ) \
+   {                                                                          \
+    uint64_t size = (uint64_t)table->tableSize;                               \
+    uint64_t index = hashFunction( key ) % size;                              \
+    uint64_t probe;                                                           \
+    const Name##EntryType *entry;                                             \
+                                                                              \
+    for( probe = 1; probe <= size; probe++ )                                  \
+       {                                                                      \
+        entry = &table->array[ index ];                                       \
+                                                                              \
+        if( entry->state == GENERIC_EMPTY_ENTRY )                             \
+           {                                                                  \
+            return GENERIC_ITEM_NOT_FOUND;                                    \
+           }                                                                  \
+                                                                              \
+        if( entry->state == GENERIC_USED_ENTRY                                \
+                                       && equalFunction( &entry->key, key ) ) \
+           {                                                                  \
+            return (int)index;                                                \
+           }                                                                  \
+                                                                              \
+        /* linear steps by one, quadratic by 1, 3, 5, ... (i squared) */      \
+        index += table->probeStrategy == QUADRATIC_PROBING                    \
+                                                      ? 2 * probe - 1 : 1;    \
+        index %= size;                                                        \
+       }                                                                      \
+                                                                              \
+    return GENERIC_ITEM_NOT_FOUND;                                            \
+   }                                                                          \
+                                                                              \
+static inline bool add##Name##Item( Name##Type *table, const KeyType *key,    \
+                                                     const ValueType *value ) \
+   {                                                                          \
+    uint64_t size = (uint64_t)table->tableSize;                               \
+    uint64_t index = hashFunction( key ) % size;                              \
+    uint64_t probe;                                                           \
+    Name##EntryType *entry, *freeEntry = NULL;                                \
+                                                                              \
+    if( table->probeStrategy == NO_PROBING )                                  \
+       {                                                                      \
+        return false;                                                         \
+       }                                                                      \
+                                                                              \
+    for( probe = 1; probe <= size; probe++ )                                  \
+       {                                                                      \
+        entry = &table->array[ index ];                                       \
+                                                                              \
+        if( entry->state == GENERIC_EMPTY_ENTRY )                             \
+           {                                                                  \
+            if( freeEntry == NULL )                                           \
+               {                                                              \
+                freeEntry = entry;                                            \
+               }                                                              \
+                                                                              \
+            break;                                                            \
+           }                                                                  \
+                                                                              \
+        if( entry->state == GENERIC_REMOVED_ENTRY )                           \
+           {                                                                  \
+            if( freeEntry == NULL )                                           \
+               {                                                              \
+                freeEntry = entry;                                            \
+               }                                                              \
+           }                                                                  \
+                                                                              \
+        else if( equalFunction( &entry->key, key ) )                          \
+           {                                                                  \
+            entry->value = *value;                                            \
+                                                                              \
+            return true;                                                      \
+           }                                                                  \
+                                                                              \
+        index += table->probeStrategy == QUADRATIC_PROBING                    \
+                                                      ? 2 * probe - 1 : 1;    \
+        index %= size;                                                        \
+       }                                                                      \
+                                                                              \
+    if( freeEntry == NULL )                                                   \
+       {                                                                      \
+        return false;                                                         \
+       }                                                                      \
+                                                                              \
+    freeEntry->key = *key;                                                    \
+    freeEntry->value = *value;                                                \
+    freeEntry->state = GENERIC_USED_ENTRY;                                    \
+    table->itemCount++;                                                       \
+                                                                              \
+    return true;                                                              \
+   }                                                                          \
+                                                                              \
+static inline void clear##Name( Name##Type *table )                           \
+   {                                                                          \
+    free( table->array );                                                     \
+    free( table );                                                            \
+   }                                                                          \
+                                                                              \
+static inline ValueType *find##Name##Item( const Name##Type *table,           \
+                                                         const KeyType *key ) \
+   {                                                                          \
+    int index = find##Name##Index( table, key );                              \
+                                                                              \
+    return index == GENERIC_ITEM_NOT_FOUND                                    \
+                                      ? NULL : &table->array[ index ].value;  \
+   }                                                                          \
+                                                                              \
+static inline Name##Type *initialize##Name( int capacity, ProbeType probe )   \
+   {                                                                          \
+    Name##Type *table = (Name##Type *)malloc( sizeof( Name##Type ) );         \
+                                                                              \
+    if( table == NULL )                                                       \
+       {                                                                      \
+        return NULL;                                                          \
+       }                                                                      \
+                                                                              \
+    /* zeroed entries are GENERIC_EMPTY_ENTRY */                              \
+    table->array = (Name##EntryType *)calloc( capacity,                       \
+                                                 sizeof( Name##EntryType ) ); \
+                                                                              \
+    if( table->array == NULL )                                                \
+       {                                                                      \
+        free( table );                                                        \
+                                                                              \
+        return NULL;                                                          \
+       }                                                                      \
+                                                                              \
+    table->tableSize = capacity;                                              \
+    table->itemCount = 0;                                                     \
+    table->probeStrategy = probe;                                             \
+                                                                              \
+    return table;                                                             \
+   }                                                                          \
+                                                                              \
+static inline bool remove##Name##Item( Name##Type *table, const KeyType *key, \
+                                                    ValueType *removedValue ) \
+   {                                                                          \
+    int index = find##Name##Index( table, key );                              \
+                                                                              \
+    if( index == GENERIC_ITEM_NOT_FOUND )                                     \
+       {                                                                      \
+        return false;                                                         \
+       }                                                                      \
+                                                                              \
+    if( removedValue != NULL )                                                \
+       {                                                                      \
+        *removedValue = table->array[ index ].value;                          \
+       }                                                                      \
+                                                                              \
+    table->array[ index ].state = GENERIC_REMOVED_ENTRY;                      \
+    table->itemCount--;                                                       \
+                                                                              \
+    return true;                                                              \
+   }
+
+#endif  // GENERIC_HASH_TABLE_H
@@ -1,4 +1,14 @@
 #include "HashUtilities.h"
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 // define constants
 const int MINIMUM_HASH_LETTER_COUNT = 7;
@@ -6,6 +16,208 @@ const int ITEM_NOT_FOUND = -1;
 const bool USED_NODE = true;
 const bool UNUSED_NODE = false;
 
+// no node, in tree links and free list of chained tables
+static const int NO_CHAIN_NODE = -1;
+
+// membership filter block of 512 bits (one cache line) in words,
+// bits set per name, and filter bits per expected item
+#define HASH_FILTER_BLOCK_WORDS 8
+static const int HASH_FILTER_BLOCK_BITS = 512;
+static const int HASH_FILTER_BITS_PER_NAME = 6;
+static const int HASH_FILTER_BITS_PER_ITEM = 10;
+
+// huge page sizes, shift of page size bits in mmap flags, 
+// and kernel memory policy modes used with mbind
+static const size_t HUGE_PAGE_2MB_BYTES = 2097152;
+static const size_t HUGE_PAGE_1GB_BYTES = 1073741824;
+static const int HUGE_PAGE_FLAG_SHIFT = 26;
+static const int NUMA_POLICY_PREFERRED = 1;
+static const int NUMA_POLICY_BIND = 2;
+static const int NUMA_POLICY_INTERLEAVE = 3;
+
+// local function prototypes, used only in this file
+void *allocateTableArray( size_t length, 
+                                   const HashAllocationOptionsType *options, 
+                                             HashAllocationType *allocation );
+void *allocateTableMemory( const HashAllocatorType *allocator, size_t size,
+                                                           size_t alignment );
+int balanceChainTree( HashTreeLinkType *links, int node );
+static inline bool checkHashFilter( const HashFilterType *filter, 
+                                           const char *name, int nameLength );
+int collectChainTree( const HashTreeLinkType *links, int node, 
+                                                      int *nodes, int count );
+static inline int compareChainName( const char *name, int nameLength, 
+                                                 const StateDataType *node );
+int compareChainNodes( const ProbingHashType *hash, int oneNode, 
+                                                               int otherNode );
+void filterNodeAdded( void *indexData, const StateDataType *node );
+void filterNodeRemoved( void *indexData, const StateDataType *node );
+int findItemIndexChained( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength );
+int findItemIndexTreeChained( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength );
+int findOpenIndexChained( const ProbingHashType *hash, int hashIndex );
+static inline int getChainTreeHeight( const HashTreeLinkType *links, 
+                                                                   int node );
+static inline unsigned long long getFilterNameHash( const char *name, 
+                                                              int nameLength );
+static inline int getSlabFreeNode( const ProbingHashType *hash, int slab );
+static inline void guardNodeWrite( const ProbingHashType *hash, 
+                                                                int nodeIndex );
+int insertChainTree( const ProbingHashType *hash, int root, int nodeIndex );
+void linkNodeChained( const ProbingHashType *hash, int hashIndex, 
+                                                               int nodeIndex );
+void linkNodeTreeChained( const ProbingHashType *hash, int hashIndex, 
+                                                               int nodeIndex );
+void *mapTableArray( size_t length, size_t alignment, int flags, 
+                                                      size_t *mappedLength );
+void rebuildHashFilter( HashFilterType *filter, 
+                                            const StateDataType *skippedNode );
+void releaseTableArray( const ProbingHashType *hash );
+void releaseTableMemory( const HashAllocatorType *allocator, void *memory );
+int removeChainTree( const ProbingHashType *hash, int root, int nodeIndex );
+int removeChainTreeMinimum( HashTreeLinkType *links, int node, 
+                                                              int *minimum );
+void returnPoolNode( const ProbingHashType *hash, int nodeIndex );
+int rotateChainTree( HashTreeLinkType *links, int node, bool rotateLeft );
+static inline void setFilterName( HashFilterType *filter, const char *name, 
+                                                              int nameLength );
+bool setTableArrayPolicy( void *array, size_t length, 
+                                 const HashAllocationOptionsType *options );
+void takePoolNode( const ProbingHashType *hash, int nodeIndex );
+void unlinkNodeChained( const ProbingHashType *hash, int nodeIndex );
+void unlinkNodeTreeChained( const ProbingHashType *hash, int nodeIndex );
+int findItemIndexVerbose( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength );
+int findOpenIndexVerbose( const ProbingHashType *hash, int hashIndex );
+static inline int probeItemIndex( const ProbingHashType *hash, int hashIndex, 
+                                  const char *name, int nameLength, 
+                                  const bool quadratic, const bool masked );
+static inline int probeOpenIndex( const ProbingHashType *hash, int hashIndex,
+                                  const bool quadratic, const bool masked );
+void notifyIndexHooks( const ProbingHashType *hash, const StateDataType *node,
+                                                              bool nodeAdded );
+
+// probe loop specializations, one per probe strategy and table size
+// policy, each passes constants to the inlined probe loop so each
+// compiles to its own loop with no strategy branches
+#define DEFINE_PROBE_FUNCTIONS( functionsName, suffix, quadratic, masked )  \
+int findItemIndex##suffix( const ProbingHashType *hash, int hashIndex,     \
+                                   const char *name, int nameLength )      \
+  {                                                                        \
+  return probeItemIndex( hash, hashIndex, name, nameLength,                \
+                                                       quadratic, masked ); \
+  }                                                                        \
+                                                                           \
+int findOpenIndex##suffix( const ProbingHashType *hash, int hashIndex )    \
+  {                                                                        \
+  return probeOpenIndex( hash, hashIndex, quadratic, masked );             \
+  }                                                                        \
+                                                                           \
+static const HashProbeType functionsName =                                 \
+  { findItemIndex##suffix, findOpenIndex##suffix, NULL, NULL };
+
+DEFINE_PROBE_FUNCTIONS( LINEAR_PROBE_FUNCTIONS, Linear, false, false )
+DEFINE_PROBE_FUNCTIONS( MASKED_LINEAR_PROBE_FUNCTIONS, 
+                                                  LinearMasked, false, true )
+DEFINE_PROBE_FUNCTIONS( QUADRATIC_PROBE_FUNCTIONS, Quadratic, true, false )
+DEFINE_PROBE_FUNCTIONS( MASKED_QUADRATIC_PROBE_FUNCTIONS, 
+                                                 QuadraticMasked, true, true )
+
+// original probe loops, with probing display
+static const HashProbeType VERBOSE_PROBE_FUNCTIONS = 
+  { findItemIndexVerbose, findOpenIndexVerbose, NULL, NULL };
+
+// chained buckets, inline arrays turning into balanced trees
+static const HashProbeType TREE_CHAINED_FUNCTIONS = 
+  { findItemIndexTreeChained, findOpenIndexChained, 
+                                    linkNodeTreeChained, unlinkNodeTreeChained };
+
+// chained buckets, lists of pooled nodes
+static const HashProbeType CHAINED_FUNCTIONS = 
+  { findItemIndexChained, findOpenIndexChained, 
+                                            linkNodeChained, unlinkNodeChained };
+
+/*
+Name: addHashIndexHook
+Process: attaches secondary index hook to table, hook is then told of 
+         every node added or removed until removed with 
+         removeHashIndexHook, which must be done before table is cleared
+Function input/parameters: hash data (ProbingHashType *), 
+                           hook (HashIndexHookType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void addHashIndexHook( ProbingHashType *hash, HashIndexHookType *hook )
+  {
+  // add to front of chain
+  hook->next = hash->indexHooks;
+  hash->indexHooks = hook;
+  }
+
+/*
+Name: addItemAtIndex
+Process: adds item to given unused node of open addressing table, 
+         as when a saved table is put back node for node, 
+         name is truncated to fit if needed
+Function input/parameters: hash data (ProbingHashType *), node (int),
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: false if table is chained or has no probing,
+                          or node is out of table or in use (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: guardNodeWrite, notifyIndexHooks
+*/
+bool addItemAtIndex( ProbingHashType *hash, int index, 
+                                  const char *name, int nameLength, 
+                                  double avgTemp, double lowTemp, 
+                                  double highTemp )
+  {
+  // variables
+  StateDataType *nodePtr;
+  int charIndex;
+  
+  // chained nodes belong to buckets, not to places
+  if( hash->probeStrategy == NO_PROBING 
+       || hash->probeFunctions->linkNode != NULL
+       || index < 0 || index >= hash->tableSize 
+       || hash->array[ index ].inUse )
+    {
+    return false;
+    }
+  
+  if( nameLength > STD_STR_LEN - 1 )
+    {
+    nameLength = STD_STR_LEN - 1;
+    }
+  
+  guardNodeWrite( hash, index );
+  
+  // copy data straight into node
+  nodePtr = &hash->array[ index ];
+  
+  for( charIndex = 0; charIndex < nameLength; charIndex++ )
+    {
+    nodePtr->name[ charIndex ] = name[ charIndex ];
+    }
+  
+  nodePtr->name[ nameLength ] = NULL_CHAR;
+  nodePtr->averageTemp = avgTemp;
+  nodePtr->lowestTemp = lowTemp;
+  nodePtr->highestTemp = highTemp;
+  nodePtr->inUse = USED_NODE;
+  
+  notifyIndexHooks( hash, nodePtr, true );
+  
+  // return sucess
+  return true;
+  }
+
 /*
 Name: addItemFromData
 Process: adds item to hash table using data input,
@@ -33,25 +245,109 @@ bool addItemFromData( ProbingHashType *hash, const char *stateName,
   return addItemFromStruct( hash, newItem );
   }
 
+/*
+Name: addItemFromHashedView
+Process: adds item to hash table using name given as pointer and length
+         with its hash index already calculated (by getHashIndexFromView
+         on the name truncated to STD_STR_LEN - 1), so hashing
+         may be done ahead of time, for example on other threads
+Function input/parameters: hash data (ProbingHashType *), hash index (int),
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: result of operation (bool)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: findOpenIndex, guardNodeWrite, printf, dataToString,
+              notifyIndexHooks, bound linkNode
+*/
+bool addItemFromHashedView( ProbingHashType *hash, int hashIndex,
+                                  const char *name, int nameLength, 
+                                  double avgTemp, double lowTemp, 
+                                  double highTemp )
+  {
+  // variables
+  int index, charIndex;
+  StateDataType *nodePtr;
+  char displayStr[ STD_STR_LEN ];
+  
+  // check for no prob strategy first
+  if( hash->probeStrategy == NO_PROBING )
+    {
+    return false;
+    }
+  
+  // probe for open index
+  index = findOpenIndex( hash, hashIndex );
+  
+  // chained table has no unused node
+  if( index == ITEM_NOT_FOUND )
+    {
+    return false;
+    }
+  
+  guardNodeWrite( hash, index );
+  
+  // copy data straight into node
+  nodePtr = &hash->array[ index ];
+  
+  // full table, node is replaced
+  if( nodePtr->inUse )
+    {
+    notifyIndexHooks( hash, nodePtr, false );
+    }
+  
+  for( charIndex = 0; charIndex < nameLength; charIndex++ )
+    {
+    nodePtr->name[ charIndex ] = name[ charIndex ];
+    }
+    
+  nodePtr->name[ nameLength ] = NULL_CHAR;
+  nodePtr->averageTemp = avgTemp;
+  nodePtr->lowestTemp = lowTemp;
+  nodePtr->highestTemp = highTemp;
+  nodePtr->inUse = USED_NODE;
+  
+  // chained node joins its bucket
+  if( hash->probeFunctions->linkNode != NULL )
+    {
+    hash->probeFunctions->linkNode( hash, hashIndex, index );
+    }
+  
+  notifyIndexHooks( hash, nodePtr, true );
+  
+  if( hash->showProbing )
+    {
+    // create display string, display
+    dataToString( displayStr, *nodePtr );
+    printf( "\n%s %d -> %d\n", displayStr, hashIndex, index );
+    }
+  
+  // return sucess
+  return true;
+  }
+
 /*
 Name: addItemFromStruct
 Process: adds item to hash table using struct input,
          uses probing as specified in heap data,
-         may probe as many as tableSize times
+         may probe as many as tableSize times,
+         chained tables add to bucket of hash index
 Function input/parameters: hash data (ProbingHashType *), 
                            new item (StateDataType)
 Function output/parameters: updated hash table data (ProbingHashType *)
-Function output/returned: result of operation (bool)
+Function output/returned: result of operation,
+                          false if chained table has no unused node (bool)
 Device input/---: none
 Device output/monitor: probing process displayed
-Dependencies: getHashIndex, toPower, printf, dataToString,
-              setHeapNodeFromStruct
+Dependencies: getHashIndex, findOpenIndex, guardNodeWrite, printf,
+              dataToString, setHeapNodeFromStruct, notifyIndexHooks,
+              bound linkNode
 */
 bool addItemFromStruct( ProbingHashType *hash, StateDataType newItem )
   {       
   // variables
-  int hashIndex, index = 0, quadraticCounter = 0, 
-                  linearCounter = 0, loopCounter = 0;
+  int hashIndex, index = 0;
   char displayStr[ STD_STR_LEN ];
 
   // check for no prob strategy first
@@ -63,455 +359,2166 @@ bool addItemFromStruct( ProbingHashType *hash, StateDataType newItem )
   // get the hash index
   hashIndex = getHashIndex( *hash, newItem );
   
-  // pre prime loop index
-  index = hashIndex;
-
-  // display indicies probed
-  printf( "\nIndices probed: %d", index );    
-        
-  // loop while value not found at current index 
-  // and value not equal to search value
-  while( hash->array[ index ].inUse && loopCounter <= hash->tableSize) 
-    {       
-    // check for probing strategy
-    // if linear
-    if( hash->probeStrategy == LINEAR_PROBING )
-      {
-      // increment index
-      linearCounter++;
-       
-      // update index 
-      index = hashIndex + linearCounter;  
-      }
+  // probe for open index
+  index = findOpenIndex( hash, hashIndex );
   
-    // otherwise assume quadratic
-    else 
-      {
-      // increment quadraticCounter
-      quadraticCounter++;
-        
-      // set index
-      index = ( hashIndex + toPower( quadraticCounter, 2 ));
-      }
-      
-    // mod the index, to verify within array
-    index = index % hash->tableSize;
-    
-    // display index    
-    printf( ", %d", index );
-      
-    // increment loopcounter
-    loopCounter++;
+  // chained table has no unused node
+  if( index == ITEM_NOT_FOUND )
+    {
+    return false;
     }
   
-  // create display string
-  dataToString( displayStr, newItem );
+  if( hash->showProbing )
+    {
+    // create display string
+    dataToString( displayStr, newItem );
     
-  // display string
-  printf( "\n%s %d -> %d\n", displayStr, hashIndex, index );
+    // display string
+    printf( "\n%s %d -> %d\n", displayStr, hashIndex, index );
+    }
+  
+  guardNodeWrite( hash, index );
+  
+  // full table, node is replaced
+  if( hash->array[ index ].inUse )
+    {
+    notifyIndexHooks( hash, &hash->array[ index ], false );
+    }
   
   // add item at index found 
   setHashNodeFromStruct( &hash->array[ index ], newItem);
+  
+  if( hash->array[ index ].inUse )
+    {
+    // chained node joins its bucket
+    if( hash->probeFunctions->linkNode != NULL )
+      {
+      hash->probeFunctions->linkNode( hash, hashIndex, index );
+      }
+    
+    notifyIndexHooks( hash, &hash->array[ index ], true );
+    }
 
   // return sucess
   return true;
   }
 
 /*
-Name: clearHashTable
-Process: clear hash table array, sets size to zero,
-         sets probing to NO_PROBING
-Function input/parameters: hash data (ProbingHashType *)
+Name: addItemFromView
+Process: adds item to hash table using name given as pointer and length
+         (not NULL_CHAR terminated), name is copied once, directly into
+         the table node, truncated to fit if needed
+Function input/parameters: hash data (ProbingHashType *), 
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
 Function output/parameters: updated hash table data (ProbingHashType *)
-Function output/returned: none
+Function output/returned: result of operation (bool)
 Device input/---: none
-Device output/---: none
-Dependencies: free
+Device output/monitor: probing process displayed if enabled
+Dependencies: getHashIndexFromView, addItemFromHashedView
 */
-void clearHashTable( ProbingHashType *hash )
+bool addItemFromView( ProbingHashType *hash, const char *name, 
+                                  int nameLength, double avgTemp, 
+                                  double lowTemp, double highTemp )
   {
-  // free memory of array
-  free( hash->array );
-  
-  // set size of hash to 0
-  hash->tableSize = 0;
-  
-  // set probing to NO_PROBING	
-  hash->probeStrategy = NO_PROBING;
+  // truncate name to fit node
+  if( nameLength > STD_STR_LEN - 1 )
+    {
+    nameLength = STD_STR_LEN - 1;
+    }
   
-  // free the hash
-  free( hash );
+  // get the hash index, add
+  return addItemFromHashedView( hash, 
+                        getHashIndexFromView( hash, name, nameLength ),
+                        name, nameLength, avgTemp, lowTemp, highTemp );
   }
 
 /*
-Name: compareStates
-Process: compares states by name
-Function input/parameters: one state and other state (const StateDataType)
-Function output/parameters: none
-Function output/returned: value representing comparison,
-                  greater than zero if first state is greater than second state,
-                  less than zero if first state is less than second state,
-                  zero if state names and lengths are the same,
-                  otherwise, larger state name length is greater
+Name: allocateTableArray
+Process: allocates node array of given length with page size and
+         NUMA policy of options, reserved huge pages first, then 
+         standard pages aligned to and advised as transparent huge 
+         pages, NUMA policy set before array is touched; allocates 
+         from heap if options are NULL or all default, or mapping fails,
+         from allocator of options if it has one;
+         array is all zero bytes (all nodes empty) in every case, 
+         pages are faulted in when first used
+Function input/parameters: array length in bytes (size_t),
+                           options, or NULL 
+                           (const HashAllocationOptionsType *)
+Function output/parameters: allocation made (HashAllocationType *)
+Function output/returned: pointer to array, or NULL if out of memory
+                          (void *)
 Device input/---: none
 Device output/---: none
-Dependencies: getStringLength
+Dependencies: allocateTableMemory, mapTableArray, madvise, 
+              setTableArrayPolicy, calloc
 */
-int compareStates( const StateDataType oneState, 
-                                               const StateDataType otherState )
+void *allocateTableArray( size_t length, 
+                                   const HashAllocationOptionsType *options, 
+                                              HashAllocationType *allocation )
   {
   // variables
-  int oneIndex = 0, twoIndex = 0;
+  void *array = NULL;
   
-  // loop to iterate through both strings 
-  while( oneState.name[ oneIndex ] && otherState.name[ twoIndex ] )
+  allocation->kind = HEAP_ALLOCATION;
+  allocation->mappedLength = 0;
+  allocation->numaPlaced = false;
+  
+  // allocator of table serves array, cache line aligned
+  if( options != NULL && options->allocator != NULL )
     {
-    // compare character by character
-    // if difference is found
-    if( oneState.name[ oneIndex ] != otherState.name[ twoIndex ] )
+    allocation->kind = ALLOCATOR_ALLOCATION;
+    
+    return allocateTableMemory( options->allocator, length, 64 );
+    }
+  
+#ifndef _WIN32
+  if( options != NULL && ( options->pageSize != STANDARD_PAGES 
+                                  || options->numaPolicy != NUMA_DEFAULT ) )
+    {
+#ifdef MAP_HUGETLB
+    // reserved huge pages of size asked for
+    if( options->pageSize != STANDARD_PAGES )
       {
-      // return difference
-      return oneState.name[ oneIndex ] - otherState.name[ twoIndex];
+      array = mapTableArray( length, options->pageSize == HUGE_PAGES_1GB 
+                         ? HUGE_PAGE_1GB_BYTES : HUGE_PAGE_2MB_BYTES, 
+                            MAP_HUGETLB | ( ( options->pageSize == HUGE_PAGES_1GB 
+                                ? 30 : 21 ) << HUGE_PAGE_FLAG_SHIFT ), 
+                                                  &allocation->mappedLength );
+      allocation->kind = HUGE_PAGE_ALLOCATION;
       }
+#endif
     
-    // increment index's
-    oneIndex++;
-    twoIndex++;
+    // standard pages, aligned so transparent huge pages can back them
+    if( array == NULL )
+      {
+      array = mapTableArray( length, options->pageSize != STANDARD_PAGES 
+                     ? HUGE_PAGE_2MB_BYTES : (size_t)sysconf( _SC_PAGESIZE ), 
+                                               0, &allocation->mappedLength );
+      allocation->kind = MAPPED_ALLOCATION;
+      
+#ifdef MADV_HUGEPAGE
+      if( array != NULL && options->pageSize != STANDARD_PAGES 
+           && madvise( array, allocation->mappedLength, MADV_HUGEPAGE ) == 0 )
+        {
+        allocation->kind = TRANSPARENT_HUGE_ALLOCATION;
+        }
+#endif
+      }
+    
+    if( array != NULL && options->numaPolicy != NUMA_DEFAULT )
+      {
+      allocation->numaPlaced = setTableArrayPolicy( array, 
+                                         allocation->mappedLength, options );
+      }
     }
+#endif
+  
+  // heap, by default or when mapping failed, zeroed so all nodes 
+  // are empty; large blocks come zeroed from the system untouched
+  if( array == NULL )
+    {
+    allocation->kind = HEAP_ALLOCATION;
+    allocation->mappedLength = 0;
     
-      
-  // otherwise, if at end of shortest string
-    // return difference in string lengths
-  return getStringLength( oneState.name ) - 
-             getStringLength( otherState.name );	
+    array = calloc( 1, length );
+    }
+  
+  return array;
   }
 
 /*
-Name: copyString
-Process: copies string from source to destination
-Function input/parameters: source string (const char *)
-Function output/parameters: destination string (char *)
-Function output/returned: none
+Name: allocateTableMemory
+Process: allocates zeroed memory of given size and alignment from 
+         allocator of table, or from heap if allocator has none
+Function input/parameters: allocator (const HashAllocatorType *),
+                           size in bytes (size_t), 
+                           alignment in bytes, power of two (size_t)
+Function output/parameters: none
+Function output/returned: pointer to memory, or NULL if out of memory
+                          (void *)
 Device input/---: none
 Device output/---: none
-Dependencies: none
+Dependencies: allocator allocate, calloc, aligned_alloc, memset
 */
-void copyString( char *dest, const char *source )
+void *allocateTableMemory( const HashAllocatorType *allocator, size_t size,
+                                                            size_t alignment )
   {
   // variables
-  int index = 0;
+  void *memory;
   
-  // iterate until hitting NULL_CHAR of source
-  while( source[ index ] != NULL_CHAR )
+  if( allocator->allocate != NULL )
     {
-    // copy index to dest
-	dest[index] = source[index];
-	
-	// increment index
-	index++;
-	
-	// set dest at index to NULL_CHAR 	
-    dest[index] = NULL_CHAR;
-    }	
+    return allocator->allocate( allocator->allocatorData, size, alignment );
+    }
+  
+  // heap blocks are aligned for any type already
+  if( alignment <= sizeof( long double ) )
+    {
+    return calloc( 1, size );
+    }
+  
+  // aligned size must be multiple of alignment
+  size = ( size + alignment - 1 ) & ~( alignment - 1 );
+  memory = aligned_alloc( alignment, size );
+  
+  if( memory != NULL )
+    {
+    memset( memory, 0, size );
+    }
+  
+  return memory;
   }
 
 /*
-Name: dataToString
-Process: creates string from StateDataType data
-Function input/parameters: provided state data (const StateDataType)
-Function output/parameters: output string (char *)
-Function output/returned: none
+Name: balanceChainTree
+Process: updates height of tree node from its subtrees, rotates node
+         (once, or twice for inner heavy subtree) if subtree heights
+         differ by more than one, keeping chained bucket trees balanced
+Function input/parameters: tree links (HashTreeLinkType *), node (int)
+Function output/parameters: updated tree links (HashTreeLinkType *)
+Function output/returned: root of balanced subtree (int)
 Device input/---: none
 Device output/---: none
-Dependencies: sprintf, or other options
+Dependencies: getChainTreeHeight, rotateChainTree
 */
-void dataToString( char *outStr, const StateDataType state )
+int balanceChainTree( HashTreeLinkType *links, int node )
   {
-  // copy string from stateDataType to outStr	
-  sprintf( outStr, "%s, Avg: %5.2f, Low: %5.2f, High: %5.2f, ", 
-    state.name, state.averageTemp, state.lowestTemp, state.highestTemp );	
-  }
-
-/*
-Name: displayHashTable
-Process: array data dump of numbered data to screen, 
-         shows data where used, shows "Unused" where not
-Function input/parameters: provided heap data (const ProbingHashType *)
-Function output/parameters: none
-Function output/returned: none
-Device input/---: none
+  // variables
+  int leftHeight = getChainTreeHeight( links, links[ node ].left );
+  int rightHeight = getChainTreeHeight( links, links[ node ].right );
+  int child;
+  
+  // left heavy
+  if( leftHeight > rightHeight + 1 )
+    {
+    child = links[ node ].left;
+    
+    if( getChainTreeHeight( links, links[ child ].left ) 
+                          < getChainTreeHeight( links, links[ child ].right ) )
+      {
+      links[ node ].left = rotateChainTree( links, child, true );
+      }
+    
+    return rotateChainTree( links, node, false );
+    }
+  
+  // right heavy
+  if( rightHeight > leftHeight + 1 )
+    {
+    child = links[ node ].right;
+    
+    if( getChainTreeHeight( links, links[ child ].right ) 
+                           < getChainTreeHeight( links, links[ child ].left ) )
+      {
+      links[ node ].right = rotateChainTree( links, child, false );
+      }
+    
+    return rotateChainTree( links, node, true );
+    }
+  
+  links[ node ].height = 1 + ( leftHeight > rightHeight 
+                                                 ? leftHeight : rightHeight );
+  
+  return node;
+  }
+
+/*
+Name: bindProbeFunctions
+Process: binds probe loops to table once, from its probe strategy,
+         display setting, and table size (power of two sizes use masking
+         in place of modulo), so loops have no strategy branches,
+         chained tables always use their bucket functions,
+         called by initializeHashTable and setHashTableVerbose,
+         and must be called again if those fields are changed directly
+Function input/parameters: hash data (ProbingHashType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void bindProbeFunctions( ProbingHashType *hash )
+  {
+  // variables
+  bool masked = hash->tableSize > 0 
+                         && ( hash->tableSize & ( hash->tableSize - 1 ) ) == 0;
+  
+  // chained buckets, no probing to display
+  if( hash->probeStrategy == TREE_CHAINING )
+    {
+    hash->probeFunctions = &TREE_CHAINED_FUNCTIONS;
+    }
+  
+  else if( hash->probeStrategy == CHAINING )
+    {
+    hash->probeFunctions = &CHAINED_FUNCTIONS;
+    }
+  
+  // display uses original loops
+  else if( hash->showProbing )
+    {
+    hash->probeFunctions = &VERBOSE_PROBE_FUNCTIONS;
+    }
+  
+  // linear
+  else if( hash->probeStrategy == LINEAR_PROBING )
+    {
+    hash->probeFunctions = masked ? &MASKED_LINEAR_PROBE_FUNCTIONS 
+                                                    : &LINEAR_PROBE_FUNCTIONS;
+    }
+  
+  // otherwise quadratic, as in original loops
+  else
+    {
+    hash->probeFunctions = masked ? &MASKED_QUADRATIC_PROBE_FUNCTIONS 
+                                                 : &QUADRATIC_PROBE_FUNCTIONS;
+    }
+  }
+
+/*
+Name: checkHashFilter
+Process: checks membership filter for name, reads the one block 
+         chosen by name hash
+Function input/parameters: filter (const HashFilterType *),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: false if name is surely not in table,
+                          true if it may be (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: getFilterNameHash
+*/
+static inline bool checkHashFilter( const HashFilterType *filter, 
+                                           const char *name, int nameLength )
+  {
+  // variables
+  unsigned long long hashValue = getFilterNameHash( name, nameLength );
+  unsigned long long bitHash = hashValue * 0x9E3779B97F4A7C15ULL;
+  const unsigned long long *block = &filter->blocks[ HASH_FILTER_BLOCK_WORDS
+        * ( ( ( hashValue >> 32 ) * (unsigned long long)filter->blockCount ) 
+                                                                    >> 32 ) ];
+  unsigned long long bit;
+  int bitIndex;
+  
+  for( bitIndex = 0; bitIndex < HASH_FILTER_BITS_PER_NAME; bitIndex++ )
+    {
+    // 9 bits pick one of 512 bits in block
+    bit = ( bitHash >> ( 64 - 9 * ( bitIndex + 1 ) ) ) & 511;
+    
+    if( ( block[ bit >> 6 ] & ( 1ULL << ( bit & 63 ) ) ) == 0 )
+      {
+      return false;
+      }
+    }
+  
+  return true;
+  }
+
+/*
+Name: clearHashTable
+Process: clear hash table array, chained buckets, and filter, 
+         sets size to zero,
+         sets probing to NO_PROBING, deallocates hash struct,
+         all returned to allocator of table
+Function input/parameters: hash data (ProbingHashType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: releaseTableArray, releaseTableMemory
+*/
+void clearHashTable( ProbingHashType *hash )
+  {
+  // variables, allocator outlives hash struct
+  HashAllocatorType allocator = hash->allocator;
+  
+  // free memory of array, as it was allocated
+  releaseTableArray( hash );
+  
+  // free chained buckets
+  if( hash->chains != NULL )
+    {
+    releaseTableMemory( &allocator, hash->chains->buckets );
+    releaseTableMemory( &allocator, hash->chains->links );
+    releaseTableMemory( &allocator, hash->chains->slabs );
+    releaseTableMemory( &allocator, hash->chains );
+    }
+  
+  // free filter, its hook goes with table
+  if( hash->filter != NULL )
+    {
+    releaseTableMemory( &allocator, hash->filter->blocks );
+    releaseTableMemory( &allocator, hash->filter );
+    }
+  
+  // set size of hash to 0
+  hash->tableSize = 0;
+  
+  // set probing to NO_PROBING	
+  hash->probeStrategy = NO_PROBING;
+  
+  // free the hash
+  releaseTableMemory( &allocator, hash );
+  }
+
+/*
+Name: collectChainTree
+Process: lists nodes of chained bucket tree in order, 
+         used when bucket shrinks back to its inline array
+Function input/parameters: tree links (const HashTreeLinkType *),
+                           subtree root (int), 
+                           number of nodes already listed (int)
+Function output/parameters: node indices (int *)
+Function output/returned: number of nodes listed (int)
+Device input/---: none
+Device output/---: none
+Dependencies: collectChainTree (recursively)
+*/
+int collectChainTree( const HashTreeLinkType *links, int node, 
+                                                       int *nodes, int count )
+  {
+  if( node == NO_CHAIN_NODE )
+    {
+    return count;
+    }
+  
+  count = collectChainTree( links, links[ node ].left, nodes, count );
+  
+  nodes[ count ] = node;
+  
+  return collectChainTree( links, links[ node ].right, nodes, count + 1 );
+  }
+
+/*
+Name: compareChainName
+Process: compares name given as pointer and length with node name,
+         same order as compareStates
+Function input/parameters: name (const char *), name length (int),
+                           node (const StateDataType *)
+Function output/parameters: none
+Function output/returned: less than, equal to, or greater than zero
+                          as name is before, same as, or after 
+                          node name (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline int compareChainName( const char *name, int nameLength, 
+                                                  const StateDataType *node )
+  {
+  // variables
+  int charIndex;
+  
+  for( charIndex = 0; charIndex < nameLength 
+                           && node->name[ charIndex ] != NULL_CHAR; charIndex++ )
+    {
+    if( name[ charIndex ] != node->name[ charIndex ] )
+      {
+      return name[ charIndex ] - node->name[ charIndex ];
+      }
+    }
+  
+  // node name is shorter
+  if( charIndex < nameLength )
+    {
+    return nameLength - charIndex;
+    }
+  
+  // same name, or node name is longer
+  return node->name[ charIndex ] == NULL_CHAR ? 0 : -1;
+  }
+
+/*
+Name: compareChainNodes
+Process: compares chained nodes by name with compareStates, 
+         same names by node index, so nodes with the same name 
+         have a fixed tree order
+Function input/parameters: hash (const ProbingHashType *),
+                           one node and other node (int)
+Function output/parameters: none
+Function output/returned: value representing comparison, as compareStates 
+                          (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareStates
+*/
+int compareChainNodes( const ProbingHashType *hash, int oneNode, 
+                                                                int otherNode )
+  {
+  // variables
+  int result = compareStates( hash->array[ oneNode ], 
+                                                  hash->array[ otherNode ] );
+  
+  return result != 0 ? result : oneNode - otherNode;
+  }
+
+/*
+Name: compareStates
+Process: compares states by name
+Function input/parameters: one state and other state (const StateDataType)
+Function output/parameters: none
+Function output/returned: value representing comparison,
+                  greater than zero if first state is greater than second state,
+                  less than zero if first state is less than second state,
+                  zero if state names and lengths are the same,
+                  otherwise, larger state name length is greater
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength
+*/
+int compareStates( const StateDataType oneState, 
+                                               const StateDataType otherState )
+  {
+  // variables
+  int oneIndex = 0, twoIndex = 0;
+  
+  // loop to iterate through both strings 
+  while( oneState.name[ oneIndex ] && otherState.name[ twoIndex ] )
+    {
+    // compare character by character
+    // if difference is found
+    if( oneState.name[ oneIndex ] != otherState.name[ twoIndex ] )
+      {
+      // return difference
+      return oneState.name[ oneIndex ] - otherState.name[ twoIndex];
+      }
+    
+    // increment index's
+    oneIndex++;
+    twoIndex++;
+    }
+    
+      
+  // otherwise, if at end of shortest string
+    // return difference in string lengths
+  return getStringLength( oneState.name ) - 
+             getStringLength( otherState.name );	
+  }
+
+/*
+Name: copyString
+Process: copies string from source to destination
+Function input/parameters: source string (const char *)
+Function output/parameters: destination string (char *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void copyString( char *dest, const char *source )
+  {
+  // variables
+  int index = 0;
+  
+  // iterate until hitting NULL_CHAR of source
+  while( source[ index ] != NULL_CHAR )
+    {
+    // copy index to dest
+	dest[index] = source[index];
+	
+	// increment index
+	index++;
+	
+	// set dest at index to NULL_CHAR 	
+    dest[index] = NULL_CHAR;
+    }	
+  }
+
+/*
+Name: dataToString
+Process: creates string from StateDataType data
+Function input/parameters: provided state data (const StateDataType)
+Function output/parameters: output string (char *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: sprintf, or other options
+*/
+void dataToString( char *outStr, const StateDataType state )
+  {
+  // copy string from stateDataType to outStr	
+  sprintf( outStr, "%s, Avg: %5.2f, Low: %5.2f, High: %5.2f, ", 
+    state.name, state.averageTemp, state.lowestTemp, state.highestTemp );	
+  }
+
+/*
+Name: disableHashFilter
+Process: detaches and releases membership filter of table, if any
+Function input/parameters: hash data (ProbingHashType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, releaseTableMemory
+*/
+void disableHashFilter( ProbingHashType *hash )
+  {
+  if( hash->filter != NULL )
+    {
+    removeHashIndexHook( hash, &hash->filter->hook );
+    
+    releaseTableMemory( &hash->allocator, hash->filter->blocks );
+    releaseTableMemory( &hash->allocator, hash->filter );
+    
+    hash->filter = NULL;
+    }
+  }
+
+/*
+Name: displayHashTable
+Process: array data dump of numbered data to screen, 
+         shows data where used, shows "Unused" where not
+Function input/parameters: provided heap data (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
 Device output/monitor: displayed as specified
 Dependencies: printf, dataToString
 */
-void displayHashTable( const ProbingHashType *hash )
+void displayHashTable( const ProbingHashType *hash )
+  {
+  // variables
+  int index;
+  char displayStr[ STD_STR_LEN ];
+  
+  // display title
+  printf( "\nHASH TABLE ARRAY DUMP:\n" );
+   
+  // iterate thorugh array until hitting size
+  for( index = 0; index < hash->tableSize; index++ )
+    {
+    printf( " %2d) ", index );    
+        
+    // check if data is in use
+    if( hash->array[ index ].inUse )
+      {
+      dataToString( displayStr, hash->array[index] );    
+          
+      // display data at index
+      printf( "%s\n", displayStr );
+      }  
+	  
+    // otherwise
+    else
+      {
+      // display not in use at index
+      printf( "Unsused\n" );
+      }	 	
+    }  	
+  }
+
+/*
+Name: enableHashFilter
+Process: creates membership filter of table sized for expected number 
+         of items (at least items already in table), fills it from 
+         table, attaches it so adds and removes keep it in sync; 
+         replaces filter already enabled
+Function input/parameters: hash data (ProbingHashType *),
+                           expected items (int)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: true if enabled, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: disableHashFilter, allocateTableMemory, releaseTableMemory, 
+              rebuildHashFilter, addHashIndexHook
+*/
+bool enableHashFilter( ProbingHashType *hash, int expectedItems )
+  {
+  // variables
+  HashFilterType *filter;
+  int index, itemCount = 0;
+  
+  disableHashFilter( hash );
+  
+  for( index = 0; index < hash->tableSize; index++ )
+    {
+    itemCount += hash->array[ index ].inUse ? 1 : 0;
+    }
+  
+  expectedItems = expectedItems > itemCount ? expectedItems : itemCount;
+  
+  filter = (HashFilterType *)allocateTableMemory( &hash->allocator, 
+                                                   sizeof( HashFilterType ), 
+                                                    sizeof( long double ) );
+  
+  if( filter == NULL )
+    {
+    return false;
+    }
+  
+  // blocks for bits wanted per item, one cache line each
+  filter->blockCount = (int)( ( (long long)expectedItems 
+                       * HASH_FILTER_BITS_PER_ITEM + HASH_FILTER_BLOCK_BITS - 1 ) 
+                                                   / HASH_FILTER_BLOCK_BITS );
+  filter->blockCount = filter->blockCount > 0 ? filter->blockCount : 1;
+  filter->blocks = (unsigned long long *)allocateTableMemory( 
+       &hash->allocator, filter->blockCount * HASH_FILTER_BLOCK_WORDS 
+                                              * sizeof( unsigned long long ),
+                   HASH_FILTER_BLOCK_WORDS * sizeof( unsigned long long ) );
+  
+  if( filter->blocks == NULL )
+    {
+    releaseTableMemory( &hash->allocator, filter );
+    
+    return false;
+    }
+  
+  // rebuild after about a quarter of expected items are removed, 
+  // so rebuilding adds little to each remove
+  filter->rebuildCount = expectedItems / 4 > 1 ? expectedItems / 4 : 1;
+  filter->hashTable = hash;
+  
+  rebuildHashFilter( filter, NULL );
+  
+  filter->hook.nodeAdded = filterNodeAdded;
+  filter->hook.nodeRemoved = filterNodeRemoved;
+  filter->hook.indexData = filter;
+  
+  addHashIndexHook( hash, &filter->hook );
+  
+  hash->filter = filter;
+  
+  return true;
+  }
+
+/*
+Name: filterNodeAdded
+Process: index hook of membership filter, sets bits of node name
+Function input/parameters: filter (void *), node (const StateDataType *)
+Function output/parameters: updated filter (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: setFilterName, getStringLength
+*/
+void filterNodeAdded( void *indexData, const StateDataType *node )
+  {
+  // variables
+  HashFilterType *filter = (HashFilterType *)indexData;
+  
+  setFilterName( filter, node->name, getStringLength( node->name ) );
+  
+  filter->itemCount++;
+  }
+
+/*
+Name: filterNodeRemoved
+Process: index hook of membership filter, bits can not be cleared
+         (other names may share them), so removed names are counted,
+         filter is rebuilt without them once they outnumber names 
+         in table and reach rebuild count
+Function input/parameters: filter (void *), node (const StateDataType *)
+Function output/parameters: updated filter (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: rebuildHashFilter
+*/
+void filterNodeRemoved( void *indexData, const StateDataType *node )
+  {
+  // variables
+  HashFilterType *filter = (HashFilterType *)indexData;
+  
+  filter->itemCount--;
+  filter->staleCount++;
+  
+  if( filter->staleCount > filter->itemCount 
+                               && filter->staleCount >= filter->rebuildCount )
+    {
+    // node is still in use, leave it out
+    rebuildHashFilter( filter, node );
+    }
+  }
+
+/*
+Name: findItem
+Process: finds item in hash table, returns
+Function input/parameters: provided search data (const StateDataType),
+                           heap (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: state data set to struct (StateDataType),
+                          or search parameter set to empty node if not found
+Device input/---: none
+Device output/---: none
+Dependencies: findItemIndex, setEmptyHeapNode
+*/
+StateDataType findItem( const ProbingHashType *hash, StateDataType searchItem )
+  {
+  // variables
+  int index;
+  StateDataType emptyNode;
+  
+  // call findItemIndex to seach and find the wanted item
+  index = findItemIndex( hash, searchItem );
+  
+  if( index != ITEM_NOT_FOUND )
+    {
+    // return data set to struct or search parameter set to empty node	
+    return hash->array[index];
+    }
+  
+  // otherwise item was not found
+  // create empty node
+  setEmptyHashNode( &emptyNode );
+  
+  // return set to empty node	
+  return emptyNode;
+  	
+  }
+
+/*
+Name: findItemIndex
+Process: finds item index, using probe loop bound to heap data,
+         names rejected by membership filter, if enabled, 
+         are not probed for,
+         otherwise, 
+         returns ITEM_NOT_FOUND if search fails after tableSize attempts,
+         displays index probing attempts if enabled
+Function input/parameters: provided search data (const StateDataType),
+                           heap (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: index or ITEM_NOT_FOUND (int) as specified
+Device input/---: none
+Device output/monitor: displays probing action, provided in sample run file
+Dependencies: getHashIndex, getStringLength, checkHashFilter, 
+              bound findItemIndex
+*/
+int findItemIndex( const ProbingHashType *hash, StateDataType searchItem )
+  {
+  // variables
+  int nameLength = getStringLength( searchItem.name );
+  
+  // filter rejects most names not in table, one block read
+  if( hash->filter != NULL 
+               && !checkHashFilter( hash->filter, searchItem.name, nameLength ) )
+    {
+    return ITEM_NOT_FOUND;
+    }
+  
+  // probe with loop bound at creation
+  return hash->probeFunctions->findItemIndex( hash, 
+                    getHashIndex( *hash, searchItem ), searchItem.name, 
+                                                                 nameLength );
+  }
+
+/*
+Name: findItemIndexChained
+Process: finds item index in list of chained bucket of given hash index,
+         nodes of bucket are mostly in one slab, so list walk 
+         stays within a few cache lines
+Function input/parameters: hash (const ProbingHashType *), 
+                           hash index (int),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: index or ITEM_NOT_FOUND (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareChainName
+*/
+int findItemIndexChained( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength )
+  {
+  // variables
+  const HashBucketType *bucket = &hash->chains->buckets[ hashIndex ];
+  const HashTreeLinkType *links = hash->chains->links;
+  int index, node = bucket->root;
+  
+  // longer names are never in table
+  if( nameLength > STD_STR_LEN - 1 )
+    {
+    return ITEM_NOT_FOUND;
+    }
+  
+  for( index = 0; index < bucket->count; index++ )
+    {
+    if( compareChainName( name, nameLength, &hash->array[ node ] ) == 0 )
+      {
+      return node;
+      }
+    
+    node = links[ node ].right;
+    }
+  
+  return ITEM_NOT_FOUND;
+  }
+
+/*
+Name: findItemIndexTreeChained
+Process: finds item index in chained bucket of given hash index,
+         compares each node of inline array, or searches bucket tree
+         by name, so search is no longer than TREE_BUCKET_INLINE_COUNT
+         compares, or O(log n) for a bucket of n nodes
+Function input/parameters: hash (const ProbingHashType *), 
+                           hash index (int),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: index or ITEM_NOT_FOUND (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareChainName
+*/
+int findItemIndexTreeChained( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength )
+  {
+  // variables
+  const HashBucketType *bucket = &hash->chains->buckets[ hashIndex ];
+  const HashTreeLinkType *links = hash->chains->links;
+  int index, node, result;
+  
+  // longer names are never in table
+  if( nameLength > STD_STR_LEN - 1 )
+    {
+    return ITEM_NOT_FOUND;
+    }
+  
+  // short bucket, inline array
+  if( bucket->count <= TREE_BUCKET_INLINE_COUNT )
+    {
+    for( index = 0; index < bucket->count; index++ )
+      {
+      if( compareChainName( name, nameLength, 
+                                  &hash->array[ bucket->nodes[ index ] ] ) == 0 )
+        {
+        return bucket->nodes[ index ];
+        }
+      }
+    
+    return ITEM_NOT_FOUND;
+    }
+  
+  // otherwise, bucket tree
+  node = bucket->root;
+  
+  while( node != NO_CHAIN_NODE )
+    {
+    result = compareChainName( name, nameLength, &hash->array[ node ] );
+    
+    if( result == 0 )
+      {
+      return node;
+      }
+    
+    node = result < 0 ? links[ node ].left : links[ node ].right;
+    }
+  
+  return ITEM_NOT_FOUND;
+  }
+
+/*
+Name: findItemIndexVerbose
+Process: finds item index from given hash index, using probing strategy 
+         provided in heap data,
+         returns ITEM_NOT_FOUND if search fails after tableSize attempts,
+         displays index probing attempts
+Function input/parameters: hash (const ProbingHashType *), 
+                           hash index (int),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: index or ITEM_NOT_FOUND (int) as specified
+Device input/---: none
+Device output/monitor: displays probing action, provided in sample run file
+Dependencies: printf, memcmp, toPower
+*/
+int findItemIndexVerbose( const ProbingHashType *hash, int hashIndex, 
+                                           const char *name, int nameLength )
+  {
+  // variables
+  int index = 0, iterations = 0;	
+  
+  // pre prime loop
+  index = hashIndex;
+  
+  if( hash->showProbing )
+    {
+    printf( "\nIndices probed: ", index );
+    }
+  
+  // loop 
+  while( iterations != hash->tableSize )
+    {       
+    // check if in use
+    if( hash->array[ index ].inUse 
+        && nameLength < STD_STR_LEN
+        && hash->array[ index ].name[ nameLength ] == NULL_CHAR
+        && memcmp( hash->array[ index ].name, name, nameLength ) == 0 )
+      {
+      // go to new line
+      if( hash->showProbing )
+        {
+        printf( "\n" );      
+        }
+              
+      // return state index
+      return index;  
+      }
+    
+    else if( hash->probeStrategy == LINEAR_PROBING )
+      {
+      // else calculate new index
+      index = hashIndex + iterations;
+      }
+      
+    else 
+      {
+      // probing index squared + hash index modded by size
+      index = hashIndex + toPower( iterations, 2 );
+      }        
+     
+    // mod the index, to verify within array
+    index = index % hash->tableSize;
+    
+    // display index    
+    if( hash->showProbing )
+      {
+      printf( "%d, ", index ); 
+      }
+      
+    // increment iterations
+    iterations++;  
+    }
+   
+  if( hash->showProbing )
+    {
+    if( iterations == 0)
+      {
+      // go to next line
+      printf( "%d" );    
+      } 
+    
+    printf( "\n" );
+    }
+  
+  // return failure
+  return ITEM_NOT_FOUND;
+  }
+    
+/*
+Name: findOpenIndex
+Process: probes from given hash index for first unused node,
+         using probe loop bound to hash data,
+         may probe as many as tableSize times,
+         displays index probing attempts if enabled,
+         chained tables give next unused node for any hash index
+Function input/parameters: hash data (const ProbingHashType *),
+                           starting hash index (int)
+Function output/parameters: none
+Function output/returned: index of unused node, or last index probed,
+                          or ITEM_NOT_FOUND if chained table has 
+                          no unused node (int)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: bound findOpenIndex
+*/
+int findOpenIndex( const ProbingHashType *hash, int hashIndex )
+  {
+  // probe with loop bound at creation
+  return hash->probeFunctions->findOpenIndex( hash, hashIndex );
+  }
+
+/*
+Name: findOpenIndexChained
+Process: finds unused node for chained table from node pool, 
+         in home slab of given hash index if it has one,
+         otherwise in first reopened slab, otherwise in first slab 
+         not full from scan slab, scan slab is moved past full slabs
+Function input/parameters: hash data (const ProbingHashType *),
+                           hash index (int)
+Function output/parameters: updated scan slab (in hash chains)
+Function output/returned: index of unused node, 
+                          or ITEM_NOT_FOUND if all nodes are in use (int)
+Device input/---: none
+Device output/---: none
+Dependencies: getSlabFreeNode
+*/
+int findOpenIndexChained( const ProbingHashType *hash, int hashIndex )
+  {
+  // variables
+  HashChainType *chains = hash->chains;
+  int node = getSlabFreeNode( hash, (int)( (long long)hashIndex 
+                               * chains->slabCount / chains->bucketCount ) );
+  
+  // home slab is full
+  if( node == NO_CHAIN_NODE && chains->openSlab != NO_CHAIN_NODE )
+    {
+    node = getSlabFreeNode( hash, chains->openSlab );
+    }
+  
+  // slabs behind scan slab were full when passed, reopened ones are
+  // listed, so scan slab only moves forward
+  while( node == NO_CHAIN_NODE && chains->scanSlab < chains->slabCount )
+    {
+    node = getSlabFreeNode( hash, chains->scanSlab );
+    
+    chains->scanSlab += node == NO_CHAIN_NODE ? 1 : 0;
+    }
+  
+  return node == NO_CHAIN_NODE ? ITEM_NOT_FOUND : node;
+  }
+
+/*
+Name: findOpenIndexVerbose
+Process: probes from given hash index for first unused node,
+         using probing strategy provided in hash data,
+         may probe as many as tableSize times,
+         displays index probing attempts
+Function input/parameters: hash data (const ProbingHashType *),
+                           starting hash index (int)
+Function output/parameters: none
+Function output/returned: index of unused node, or last index probed (int)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: toPower, printf
+*/
+int findOpenIndexVerbose( const ProbingHashType *hash, int hashIndex )
+  {
+  // variables
+  int index = hashIndex, quadraticCounter = 0, 
+                  linearCounter = 0, loopCounter = 0;
+
+  // display indicies probed
+  if( hash->showProbing )
+    {
+    printf( "\nIndices probed: %d", index );    
+    }
+        
+  // loop while value not found at current index 
+  // and value not equal to search value
+  while( hash->array[ index ].inUse && loopCounter <= hash->tableSize) 
+    {       
+    // check for probing strategy
+    // if linear
+    if( hash->probeStrategy == LINEAR_PROBING )
+      {
+      // increment index
+      linearCounter++;
+       
+      // update index 
+      index = hashIndex + linearCounter;  
+      }
+  
+    // otherwise assume quadratic
+    else 
+      {
+      // increment quadraticCounter
+      quadraticCounter++;
+        
+      // set index
+      index = ( hashIndex + toPower( quadraticCounter, 2 ));
+      }
+      
+    // mod the index, to verify within array
+    index = index % hash->tableSize;
+    
+    // display index    
+    if( hash->showProbing )
+      {
+      printf( ", %d", index );
+      }
+      
+    // increment loopcounter
+    loopCounter++;
+    }
+  
+  // return index found
+  return index;
+  }
+
+/*
+Name: getChainTreeHeight
+Process: finds height of chained bucket subtree, zero if empty
+Function input/parameters: tree links (const HashTreeLinkType *), node (int)
+Function output/parameters: none
+Function output/returned: height (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline int getChainTreeHeight( const HashTreeLinkType *links, 
+                                                                    int node )
+  {
+  return node == NO_CHAIN_NODE ? 0 : links[ node ].height;
+  }
+
+/*
+Name: getFilterNameHash
+Process: 64 bit hash of name for membership filter (FNV-1a with 
+         splitmix64 finish), independent of table hash index, so names 
+         colliding in table do not collide in filter
+Function input/parameters: name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: hash value (unsigned long long)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline unsigned long long getFilterNameHash( const char *name, 
+                                                              int nameLength )
+  {
+  // variables
+  unsigned long long hashValue = 0xCBF29CE484222325ULL;
+  int index;
+  
+  for( index = 0; index < nameLength; index++ )
+    {
+    hashValue = ( hashValue ^ (unsigned char)name[ index ] ) 
+                                                          * 0x100000001B3ULL;
+    }
+  
+  hashValue = ( hashValue ^ ( hashValue >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+  hashValue = ( hashValue ^ ( hashValue >> 27 ) ) * 0x94D049BB133111EBULL;
+  
+  return hashValue ^ ( hashValue >> 31 );
+  }
+
+/*
+Name: getHashIndex
+Process: finds hashed index for given data item,
+         sums integer values of state name characters,
+         if state name length is less than MINIMUM_HASH_LETTER_COUNT,
+         repeats going over the state letters as needed to meet this minimum
+Function input/parameters: provided search data (const StateDataType),
+                           heap (const ProbingHashType)
+Function output/parameters: none
+Function output/returned: array index generated from state name (int)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength
+*/
+int getHashIndex( const ProbingHashType hash, const StateDataType state )
+  {     
+  // hash full state name
+  return getHashIndexFromView( &hash, state.name, 
+                                          getStringLength( state.name ) );
+  }
+
+/*
+Name: getHashIndexFromView
+Process: finds hashed index for name given as pointer and length,
+         same calculation as getHashIndex, modulo bucket count for 
+         chained tables
+Function input/parameters: hash (const ProbingHashType *),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: array index generated from name (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int getHashIndexFromView( const ProbingHashType *hash, 
+                                          const char *name, int strLen )
+  {     
+  // variables
+  int sum = 0, stateIndex = 0;
+  int index = 0, loopCounter = MINIMUM_HASH_LETTER_COUNT;
+  
+  // check for empty name
+  if( strLen == 0 )
+    {
+    return 0;
+    }
+  
+  // check for state name length less than min characters
+  if( strLen > MINIMUM_HASH_LETTER_COUNT )
+    {
+    // set loop limit to min char constatnt
+    loopCounter = strLen;
+    }
+       
+  // loop up to min char/state name length
+  while( index < loopCounter )
+    {
+    // add the integer value of the character to a sum
+    sum += (int)( name[ stateIndex ] );   
+    
+    // increment my loop counter
+    index++;
+    
+    // increment string index counter, and mod by string len
+    stateIndex++;
+    stateIndex = stateIndex % strLen;
+    }
+  
+  // chained tables may have fewer buckets than nodes
+  if( hash->chains != NULL )
+    {
+    return sum % hash->chains->bucketCount;
+    }
+  
+  // return sum mod size
+  return sum % hash->tableSize;
+  }
+
+/*
+Name: getSlabFreeNode
+Process: finds unused node of slab, last removed node first,
+         otherwise next node never used
+Function input/parameters: hash (const ProbingHashType *), slab (int)
+Function output/parameters: none
+Function output/returned: index of unused node, 
+                          or NO_CHAIN_NODE if slab is full (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline int getSlabFreeNode( const ProbingHashType *hash, int slab )
+  {
+  // variables
+  const HashSlabType *slabPtr = &hash->chains->slabs[ slab ];
+  int slabStart = slab * HASH_SLAB_NODE_COUNT;
+  int slabEnd = slabStart + HASH_SLAB_NODE_COUNT;
+  
+  // free node is kept plus one, so zeroed slab has none
+  if( slabPtr->freeNode != 0 )
+    {
+    return slabPtr->freeNode - 1;
+    }
+  
+  // last slab may be short
+  slabEnd = slabEnd < hash->tableSize ? slabEnd : hash->tableSize;
+  
+  return slabStart + slabPtr->takenCount < slabEnd ? 
+                              slabStart + slabPtr->takenCount : NO_CHAIN_NODE;
+  }
+
+/*
+Name: getStringLength
+Process: utility for finding string length
+Function input/parameters: given string (const char *)
+Function output/parameters: none
+Function output/returned: length of string (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int getStringLength( const char *str )
+  {
+  // variables
+  int index = 0;
+  
+  // find the string length
+  while( str[ index ] != NULL_CHAR )
+    {
+    // increment index   
+    index++;
+    }
+  
+  // return string length	
+  return index;	
+  }
+
+/*
+Name: guardNodeWrite
+Process: tells write barrier of table, if any, that node is about 
+         to be written
+Function input/parameters: hash (const ProbingHashType *), node (int)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: barrier beforeWrite
+*/
+static inline void guardNodeWrite( const ProbingHashType *hash, 
+                                                                int nodeIndex )
+  {
+  if( hash->writeBarrier != NULL )
+    {
+    hash->writeBarrier->beforeWrite( hash->writeBarrier->barrierData, 
+                                                                 nodeIndex );
+    }
+  }
+
+/*
+Name: initializeChainedHashTable
+Process: creates hash as initializeHashTableWithOptions, node array
+         allocated from heap
+Function input/parameters: provided capacity, nodes held (int),
+                           bucket count (int),
+                           provided probe strategy (ProbeType)
+Function output/parameters: none
+Function output/returned: pointer to created hash (ProbingHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: initializeHashTableWithOptions
+*/
+ProbingHashType *initializeChainedHashTable( int capacity, int bucketCount,
+                                                             ProbeType probe )
+  {
+  return initializeHashTableWithOptions( capacity, bucketCount, probe, NULL );
+  }
+
+/*
+Name: initializeHeap
+Process: creates dynamically allocated heap, 
+         creates dynamically allocated array of empty StateDataType items,
+         initializes tableSize to given capacity,
+         initializes probe strategy to given strategy,
+         one bucket per node for chained strategies
+Function input/parameters: provided capacity (int),
+                           provided probe strategy (ProbeType)
+Function output/parameters: none
+Function output/returned: pointer to created heap (ProbingHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: initializeChainedHashTable
+*/
+ProbingHashType *initializeHashTable( int capacity, ProbeType probe )
+  {
+  return initializeChainedHashTable( capacity, capacity, probe );
+  }
+
+/*
+Name: initializeHashTableWithOptions
+Process: creates dynamically allocated hash, 
+         creates array of empty StateDataType items, allocated with 
+         page size and NUMA policy of options, or from heap if NULL,
+         all zero bytes is empty node, so array, buckets, and slabs
+         are not touched here (creation time does not grow with size),
+         initializes tableSize to given capacity,
+         initializes probe strategy to given strategy,
+         for chained strategies creates given number of empty buckets
+         and node pool of open slabs, 
+         bucket count is ignored for open addressing;
+         if any allocation fails, releases what was taken
+Function input/parameters: provided capacity, nodes held (int),
+                           bucket count (int),
+                           provided probe strategy (ProbeType),
+                           allocation options, or NULL
+                           (const HashAllocationOptionsType *)
+Function output/parameters: none
+Function output/returned: pointer to created hash, or NULL if out of 
+                          memory (ProbingHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: allocateTableMemory, sizeof, allocateTableArray, 
+              releaseTableMemory, releaseTableArray, bindProbeFunctions
+*/
+ProbingHashType *initializeHashTableWithOptions( int capacity, 
+                        int bucketCount, ProbeType probe, 
+                                  const HashAllocationOptionsType *options )
+  {
+  // variables	
+  ProbingHashType *newHash;
+  HashChainType *chains;
+  HashAllocatorType allocator = { NULL, NULL, NULL };
+  
+  // allocator of options serves whole table, heap otherwise
+  if( options != NULL && options->allocator != NULL )
+    {
+    allocator = *options->allocator;
+    }
+  	
+  // allocate memory for heap
+  newHash = (ProbingHashType *)allocateTableMemory( &allocator, 
+                          sizeof( ProbingHashType ), sizeof( long double ) );
+  
+  if( newHash == NULL )
+    {
+    return NULL;
+    }
+  
+  newHash->allocator = allocator;
+  
+  // allocate memory for array of empty (zeroed) stateDataType items,
+  // NUMA policy is set before array is first touched
+  newHash->array = (StateDataType *)allocateTableArray( 
+            capacity * sizeof( StateDataType ), options, 
+                                              &newHash->arrayAllocation );
+  
+  if( newHash->array == NULL )
+    {
+    releaseTableMemory( &allocator, newHash );
+    
+    return NULL;
+    }
+  
+  // set tableSize to given capacity
+  newHash->tableSize = capacity;
+  
+  // set prob strategy	
+  newHash->probeStrategy = probe;
+  
+  // display probing by default
+  newHash->showProbing = true;
+  
+  // no secondary indexes or write barrier
+  newHash->indexHooks = NULL;
+  newHash->writeBarrier = NULL;
+  
+  // no buckets for open addressing
+  newHash->chains = NULL;
+  
+  // no membership filter until enabled
+  newHash->filter = NULL;
+  
+  // chained buckets and slabs, all empty as zeroed
+  if( probe == TREE_CHAINING || probe == CHAINING )
+    {
+    chains = (HashChainType *)allocateTableMemory( &allocator, 
+                            sizeof( HashChainType ), sizeof( long double ) );
+    
+    if( chains == NULL )
+      {
+      releaseTableArray( newHash );
+      releaseTableMemory( &allocator, newHash );
+      
+      return NULL;
+      }
+    
+    chains->bucketCount = bucketCount > 0 ? bucketCount : 1;
+    chains->buckets = (HashBucketType *)allocateTableMemory( &allocator, 
+                     (size_t)chains->bucketCount * sizeof( HashBucketType ), 
+                                                                        64 );
+    
+    chains->links = (HashTreeLinkType *)allocateTableMemory( &allocator, 
+              (size_t)capacity * sizeof( HashTreeLinkType ), 
+                                                    sizeof( long double ) );
+    
+    chains->slabCount = ( capacity + HASH_SLAB_NODE_COUNT - 1 ) 
+                                                       / HASH_SLAB_NODE_COUNT;
+    chains->slabs = (HashSlabType *)allocateTableMemory( &allocator, 
+                         (size_t)chains->slabCount * sizeof( HashSlabType ), 
+                                                    sizeof( long double ) );
+    chains->openSlab = NO_CHAIN_NODE;
+    chains->scanSlab = 0;
+    
+    // release whatever was taken if any part is missing
+    if( chains->buckets == NULL || chains->links == NULL 
+                                                  || chains->slabs == NULL )
+      {
+      if( chains->buckets != NULL )
+        {
+        releaseTableMemory( &allocator, chains->buckets );
+        }
+      
+      if( chains->links != NULL )
+        {
+        releaseTableMemory( &allocator, chains->links );
+        }
+      
+      if( chains->slabs != NULL )
+        {
+        releaseTableMemory( &allocator, chains->slabs );
+        }
+      
+      releaseTableMemory( &allocator, chains );
+      releaseTableArray( newHash );
+      releaseTableMemory( &allocator, newHash );
+      
+      return NULL;
+      }
+    
+    newHash->chains = chains;
+    }
+  
+  // bind probe loops for strategy, display, and size
+  bindProbeFunctions( newHash );
+  
+  return newHash;
+  }
+
+/*
+Name: insertChainTree
+Process: inserts node into chained bucket subtree, ordered by 
+         compareChainNodes, rebalances on the way back up
+Function input/parameters: hash (const ProbingHashType *),
+                           subtree root (int), node (int)
+Function output/parameters: updated tree links (in hash chains)
+Function output/returned: root of updated subtree (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareChainNodes, balanceChainTree, 
+              insertChainTree (recursively)
+*/
+int insertChainTree( const ProbingHashType *hash, int root, int nodeIndex )
+  {
+  // variables
+  HashTreeLinkType *links = hash->chains->links;
+  
+  // new leaf
+  if( root == NO_CHAIN_NODE )
+    {
+    links[ nodeIndex ].left = NO_CHAIN_NODE;
+    links[ nodeIndex ].right = NO_CHAIN_NODE;
+    links[ nodeIndex ].height = 1;
+    
+    return nodeIndex;
+    }
+  
+  if( compareChainNodes( hash, nodeIndex, root ) < 0 )
+    {
+    links[ root ].left = insertChainTree( hash, links[ root ].left, nodeIndex );
+    }
+  
+  else
+    {
+    links[ root ].right = insertChainTree( hash, links[ root ].right, 
+                                                                  nodeIndex );
+    }
+  
+  return balanceChainTree( links, root );
+  }
+
+/*
+Name: linkNodeChained
+Process: takes node found by findOpenIndexChained from node pool, 
+         its data already set, adds it to front of list of bucket 
+         of given hash index
+Function input/parameters: hash data (const ProbingHashType *),
+                           hash index (int), node (int)
+Function output/parameters: updated buckets, links, and slabs 
+                            (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: takePoolNode
+*/
+void linkNodeChained( const ProbingHashType *hash, int hashIndex, 
+                                                                int nodeIndex )
+  {
+  // variables
+  HashBucketType *bucket = &hash->chains->buckets[ hashIndex ];
+  HashTreeLinkType *links = hash->chains->links;
+  
+  takePoolNode( hash, nodeIndex );
+  
+  links[ nodeIndex ].left = NO_CHAIN_NODE;
+  links[ nodeIndex ].right = NO_CHAIN_NODE;
+  
+  if( bucket->count > 0 )
+    {
+    links[ nodeIndex ].right = bucket->root;
+    links[ bucket->root ].left = nodeIndex;
+    }
+  
+  bucket->root = nodeIndex;
+  bucket->count++;
+  }
+
+/*
+Name: linkNodeTreeChained
+Process: takes node found by findOpenIndexChained from node pool, 
+         its data already set, adds it to bucket of given hash index, 
+         inline array while it has room, otherwise bucket tree, 
+         converting the inline array to a tree when it overflows
+Function input/parameters: hash data (const ProbingHashType *),
+                           hash index (int), node (int)
+Function output/parameters: updated buckets, links, and slabs
+                            (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: takePoolNode, insertChainTree
+*/
+void linkNodeTreeChained( const ProbingHashType *hash, int hashIndex, 
+                                                                int nodeIndex )
   {
   // variables
+  HashChainType *chains = hash->chains;
+  HashBucketType *bucket = &chains->buckets[ hashIndex ];
   int index;
-  char displayStr[ STD_STR_LEN ];
   
-  // display title
-  printf( "\nHASH TABLE ARRAY DUMP:\n" );
-   
-  // iterate thorugh array until hitting size
-  for( index = 0; index < hash->tableSize; index++ )
+  takePoolNode( hash, nodeIndex );
+  
+  // room in inline array
+  if( bucket->count < TREE_BUCKET_INLINE_COUNT )
     {
-    printf( " %2d) ", index );    
-        
-    // check if data is in use
-    if( hash->array[ index ].inUse )
-      {
-      dataToString( displayStr, hash->array[index] );    
-          
-      // display data at index
-      printf( "%s\n", displayStr );
-      }  
-	  
-    // otherwise
-    else
+    bucket->nodes[ bucket->count ] = nodeIndex;
+    }
+  
+  else
+    {
+    // inline array overflows, convert to tree
+    if( bucket->count == TREE_BUCKET_INLINE_COUNT )
       {
-      // display not in use at index
-      printf( "Unsused\n" );
-      }	 	
-    }  	
+      bucket->root = NO_CHAIN_NODE;
+      
+      for( index = 0; index < TREE_BUCKET_INLINE_COUNT; index++ )
+        {
+        bucket->root = insertChainTree( hash, bucket->root, 
+                                                     bucket->nodes[ index ] );
+        }
+      }
+    
+    bucket->root = insertChainTree( hash, bucket->root, nodeIndex );
+    }
+  
+  bucket->count++;
   }
 
 /*
-Name: findItem
-Process: finds item in hash table, returns
-Function input/parameters: provided search data (const StateDataType),
-                           heap (const ProbingHashType *)
-Function output/parameters: none
-Function output/returned: state data set to struct (StateDataType),
-                          or search parameter set to empty node if not found
+Name: mapTableArray
+Process: maps anonymous memory of at least given length, starting at
+         given alignment (power of two) and rounded up to it, with 
+         extra mapping flags; unaligned head and tail of a larger 
+         mapping are unmapped, huge page mappings are aligned already
+Function input/parameters: array length in bytes (size_t),
+                           alignment in bytes (size_t),
+                           extra mmap flags (int)
+Function output/parameters: length mapped (size_t *)
+Function output/returned: pointer to mapping, or NULL if mapping failed
+                          (void *)
 Device input/---: none
 Device output/---: none
-Dependencies: findItemIndex, setEmptyHeapNode
+Dependencies: mmap, munmap
 */
-StateDataType findItem( const ProbingHashType *hash, StateDataType searchItem )
+void *mapTableArray( size_t length, size_t alignment, int flags, 
+                                                       size_t *mappedLength )
   {
   // variables
-  int index;
-  StateDataType emptyNode;
+  size_t roundedLength = ( length + alignment - 1 ) & ~( alignment - 1 );
+  size_t extraLength = flags == 0 ? alignment : 0;
+  char *mapping, *aligned;
   
-  // call findItemIndex to seach and find the wanted item
-  index = findItemIndex( hash, searchItem );
+#ifndef _WIN32
+  mapping = (char *)mmap( NULL, roundedLength + extraLength, 
+                           PROT_READ | PROT_WRITE, 
+                                  MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0 );
   
-  if( index != ITEM_NOT_FOUND )
+  if( mapping == MAP_FAILED )
     {
-    // return data set to struct or search parameter set to empty node	
-    return hash->array[index];
+    *mappedLength = 0;
+    
+    return NULL;
     }
   
-  // otherwise item was not found
-  // create empty node
-  setEmptyHashNode( &emptyNode );
+  aligned = (char *)( ( (size_t)mapping + alignment - 1 ) 
+                                                    & ~( alignment - 1 ) );
   
-  // return set to empty node	
-  return emptyNode;
-  	
+  // trim to aligned range
+  if( extraLength > 0 )
+    {
+    if( aligned > mapping )
+      {
+      munmap( mapping, aligned - mapping );
+      }
+    
+    if( mapping + extraLength > aligned )
+      {
+      munmap( aligned + roundedLength, mapping + extraLength - aligned );
+      }
+    }
+  
+  *mappedLength = roundedLength;
+  
+  return aligned;
+#else
+  *mappedLength = 0;
+  
+  return NULL;
+#endif
   }
 
 /*
-Name: findItemIndex
-Process: finds item index, using probing strategy provided in heap data,
-         otherwise, 
-         returns ITEM_NOT_FOUND if search fails after tableSize attempts,
-         displays index probing attempts
-Function input/parameters: provided search data (const StateDataType),
-                           heap (const ProbingHashType *)
+Name: notifyIndexHooks
+Process: tells each secondary index hook of table that node was added
+         or is about to be removed
+Function input/parameters: hash data (const ProbingHashType *),
+                           node (const StateDataType *),
+                           added flag, false for removed (bool)
 Function output/parameters: none
-Function output/returned: index or ITEM_NOT_FOUND (int) as specified
+Function output/returned: none
 Device input/---: none
-Device output/monitor: displays probing action, provided in sample run file
-Dependencies: getHashIndex, printf, compareStates, toPower, 
-              setHeapNodeFromStruct
+Device output/---: none
+Dependencies: hook nodeAdded or nodeRemoved
 */
-int findItemIndex( const ProbingHashType *hash, StateDataType searchItem )
+void notifyIndexHooks( const ProbingHashType *hash, const StateDataType *node,
+                                                              bool nodeAdded )
   {
   // variables
-  int hashIndex = 0, index = 0, iterations = 0;	
-  ProbingHashType tempHash;
-  	
-  // get hash index
-  hashIndex = getHashIndex( *hash, searchItem );
+  HashIndexHookType *hook;
   
-  // pre prime loop
-  index = hashIndex;
+  for( hook = hash->indexHooks; hook != NULL; hook = hook->next )
+    {
+    if( nodeAdded )
+      {
+      hook->nodeAdded( hook->indexData, node );
+      }
+    
+    else
+      {
+      hook->nodeRemoved( hook->indexData, node );
+      }
+    }
+  }
+
+/*
+Name: probeItemIndex
+Process: finds item index from given hash index without display,
+         probing each of hashIndex + 0, 1, 2, ... (linear) or
+         hashIndex + 0, 2, 8, ... ( 2 * i * i, as toPower gives, quadratic)
+         up to tableSize times, steps kept incrementally so loop has
+         no multiply, masked tables (power of two size) wrap by mask,
+         others by compare and subtract; strategy and size policy are 
+         constants from each specialization, so branches on them 
+         compile out of the loop
+Function input/parameters: hash (const ProbingHashType *),
+                           hash index (int), 
+                           name (const char *), name length (int),
+                           quadratic and masked flags (const bool)
+Function output/parameters: none
+Function output/returned: index or ITEM_NOT_FOUND (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline int probeItemIndex( const ProbingHashType *hash, int hashIndex, 
+                                  const char *name, int nameLength, 
+                                  const bool quadratic, const bool masked )
+  {
+  // variables
+  const StateDataType *array = hash->array, *node;
+  unsigned long long size = (unsigned long long)hash->tableSize;
+  unsigned long long mask = size - 1, index = (unsigned long long)hashIndex;
+  unsigned long long step, increment = quadratic ? 2 : 1;
+  int charIndex;
   
-  printf( "\nIndices probed: ", index );
+  // longer names are never in table
+  if( nameLength > STD_STR_LEN - 1 )
+    {
+    return ITEM_NOT_FOUND;
+    }
   
-  // loop 
-  while( iterations != hash->tableSize )
-    {       
-    // check if in use
-    if( hash->array[ index ].inUse && 
-      compareStates( hash->array[ index ], searchItem )  == 0)
+  // keep first increment within table
+  if( !masked && size > 0 )
+    {
+    increment = increment % size;
+    }
+  
+  for( step = 1; step <= size; step++ )
+    {
+    node = &array[ index ];
+    
+    if( node->inUse && node->name[ nameLength ] == NULL_CHAR )
       {
-      // go to new line
-      printf( "\n" );      
-              
-      // return state index
-      return index;  
+      // compare inline, most probed names differ in first letters
+      for( charIndex = 0; charIndex < nameLength 
+                          && node->name[ charIndex ] == name[ charIndex ];
+                                                               charIndex++ );
+      
+      if( charIndex == nameLength )
+        {
+        return (int)index;
+        }
       }
     
-    else if( hash->probeStrategy == LINEAR_PROBING )
+    // next index
+    if( masked )
       {
-      // else calculate new index
-      index = hashIndex + iterations;
+      index = ( index + increment ) & mask;
       }
-      
-    else 
+    
+    else
       {
-      // probing index squared + hash index modded by size
-      index = hashIndex + toPower( iterations, 2 );
-      }        
-     
-    // mod the index, to verify within array
-    index = index % hash->tableSize;
+      index += increment;
+      
+      if( index >= size )
+        {
+        index -= size;
+        }
+      }
     
-    // display index    
-    printf( "%d, ", index ); 
+    // quadratic increments grow by 4 ( 2, 6, 10, ... )
+    if( quadratic )
+      {
+      increment += 4;
       
-    // increment iterations
-    iterations++;  
+      while( !masked && increment >= size )
+        {
+        increment -= size;
+        }
+      }
     }
-   
-  if( iterations == 0)
+  
+  return ITEM_NOT_FOUND;
+  }
+
+/*
+Name: probeOpenIndex
+Process: probes from given hash index for first unused node without 
+         display, same probe sequence as findOpenIndexVerbose and 
+         same steps as probeItemIndex, may probe as many as 
+         tableSize times
+Function input/parameters: hash (const ProbingHashType *),
+                           hash index (int),
+                           quadratic and masked flags (const bool)
+Function output/parameters: none
+Function output/returned: index of unused node, or last index probed (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline int probeOpenIndex( const ProbingHashType *hash, int hashIndex,
+                                  const bool quadratic, const bool masked )
+  {
+  // variables
+  const StateDataType *array = hash->array;
+  unsigned long long size = (unsigned long long)hash->tableSize;
+  unsigned long long mask = size - 1, index = (unsigned long long)hashIndex;
+  unsigned long long step, increment = quadratic ? 2 : 1;
+  
+  if( !masked && size > 0 )
+    {
+    increment = increment % size;
+    }
+  
+  for( step = 1; array[ index ].inUse && step <= size + 1; step++ )
     {
-    // go to next line
-    printf( "%d" );    
-    } 
+    if( masked )
+      {
+      index = ( index + increment ) & mask;
+      }
+    
+    else
+      {
+      index += increment;
+      
+      if( index >= size )
+        {
+        index -= size;
+        }
+      }
     
-  printf( "\n" );
+    if( quadratic )
+      {
+      increment += 4;
+      
+      while( !masked && increment >= size )
+        {
+        increment -= size;
+        }
+      }
+    }
   
-  // return failure
-  return ITEM_NOT_FOUND;
+  return (int)index;
   }
+
+/*
+Name: rebuildHashFilter
+Process: clears membership filter, sets bits of every node in use 
+         in table, except given node (about to be removed)
+Function input/parameters: filter (HashFilterType *),
+                           node left out, or NULL (const StateDataType *)
+Function output/parameters: updated filter (HashFilterType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: memset, setFilterName, getStringLength
+*/
+void rebuildHashFilter( HashFilterType *filter, 
+                                             const StateDataType *skippedNode )
+  {
+  // variables
+  const ProbingHashType *hash = filter->hashTable;
+  const StateDataType *node;
+  int index;
+  
+  memset( filter->blocks, 0, filter->blockCount * HASH_FILTER_BLOCK_WORDS 
+                                              * sizeof( unsigned long long ) );
+  
+  filter->itemCount = 0;
+  filter->staleCount = 0;
+  
+  for( index = 0; index < hash->tableSize; index++ )
+    {
+    node = &hash->array[ index ];
     
+    if( node->inUse && node != skippedNode )
+      {
+      setFilterName( filter, node->name, getStringLength( node->name ) );
+      
+      filter->itemCount++;
+      }
+    }
+  }
+
 /*
-Name: getHashIndex
-Process: finds hashed index for given data item,
-         sums integer values of state name characters,
-         if state name length is less than MINIMUM_HASH_LETTER_COUNT,
-         repeats going over the state letters as needed to meet this minimum
-Function input/parameters: provided search data (const StateDataType),
-                           heap (const ProbingHashType)
+Name: releaseTableArray
+Process: releases node array of table the way allocateTableArray made it
+Function input/parameters: hash (const ProbingHashType *)
 Function output/parameters: none
-Function output/returned: array index generated from state name (int)
+Function output/returned: none
 Device input/---: none
 Device output/---: none
-Dependencies: getStringLength
+Dependencies: releaseTableMemory, free, munmap
 */
-int getHashIndex( const ProbingHashType hash, const StateDataType state )
-  {     
+void releaseTableArray( const ProbingHashType *hash )
+  {
   // variables
-  int sum = 0, stateIndex = 0, strLen = 0;
-  int index = 0, loopCounter = MINIMUM_HASH_LETTER_COUNT;
-    // set sum to zero
-    // set stateIndex to zero
+  const HashAllocationType *allocation = &hash->arrayAllocation;
+  
+  if( allocation->kind == ALLOCATOR_ALLOCATION )
+    {
+    releaseTableMemory( &hash->allocator, hash->array );
     
-  // get string length
-  strLen = getStringLength( state.name );
+    return;
+    }
   
-  // check for state name length less than min characters
-  if( strLen > MINIMUM_HASH_LETTER_COUNT )
+#ifndef _WIN32
+  if( allocation->kind != HEAP_ALLOCATION )
     {
-    // set loop limit to min char constatnt
-    loopCounter = strLen;
+    munmap( hash->array, allocation->mappedLength );
+    
+    return;
     }
-       
-  // loop up to min char/state name length
-  while( index < loopCounter )
+#endif
+  
+  free( hash->array );
+  }
+
+/*
+Name: releaseTableMemory
+Process: returns memory to allocator of table it came from, 
+         or to heap if allocator has none; nothing for allocators
+         without release (regions free all memory at once)
+Function input/parameters: allocator (const HashAllocatorType *),
+                           memory (void *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: allocator release, free
+*/
+void releaseTableMemory( const HashAllocatorType *allocator, void *memory )
+  {
+  if( allocator->allocate == NULL )
     {
-    // add the integer value of the character to a sum
-    sum += (int)( state.name[ stateIndex ] );   
+    free( memory );
+    }
+  
+  else if( allocator->release != NULL )
+    {
+    allocator->release( allocator->allocatorData, memory );
+    }
+  }
+
+/*
+Name: removeChainTree
+Process: removes node from chained bucket subtree, a node with two
+         subtrees is replaced by the first node of its right subtree,
+         rebalances on the way back up
+Function input/parameters: hash (const ProbingHashType *),
+                           subtree root (int), node (int)
+Function output/parameters: updated tree links (in hash chains)
+Function output/returned: root of updated subtree (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareChainNodes, removeChainTreeMinimum, balanceChainTree,
+              removeChainTree (recursively)
+*/
+int removeChainTree( const ProbingHashType *hash, int root, int nodeIndex )
+  {
+  // variables
+  HashTreeLinkType *links = hash->chains->links;
+  int minimum, right;
+  
+  if( root == NO_CHAIN_NODE )
+    {
+    return NO_CHAIN_NODE;
+    }
+  
+  if( root == nodeIndex )
+    {
+    if( links[ root ].left == NO_CHAIN_NODE )
+      {
+      return links[ root ].right;
+      }
     
-    // increment my loop counter
-    index++;
+    if( links[ root ].right == NO_CHAIN_NODE )
+      {
+      return links[ root ].left;
+      }
     
-    // increment string index counter, and mod by string len
-    stateIndex++;
-    stateIndex = stateIndex % strLen;
+    // replace by first node of right subtree
+    right = removeChainTreeMinimum( links, links[ root ].right, &minimum );
     
+    links[ minimum ].left = links[ root ].left;
+    links[ minimum ].right = right;
+    
+    return balanceChainTree( links, minimum );
     }
-    // end loop
   
-  // return sum mod size
-  return sum % hash.tableSize;
+  if( compareChainNodes( hash, nodeIndex, root ) < 0 )
+    {
+    links[ root ].left = removeChainTree( hash, links[ root ].left, nodeIndex );
+    }
+  
+  else
+    {
+    links[ root ].right = removeChainTree( hash, links[ root ].right, 
+                                                                  nodeIndex );
+    }
+  
+  return balanceChainTree( links, root );
   }
 
 /*
-Name: getStringLength
-Process: utility for finding string length
-Function input/parameters: given string (const char *)
-Function output/parameters: none
-Function output/returned: length of string (int)
+Name: removeChainTreeMinimum
+Process: removes first node of chained bucket subtree, 
+         rebalances on the way back up
+Function input/parameters: tree links (HashTreeLinkType *), 
+                           subtree root (int)
+Function output/parameters: updated tree links (HashTreeLinkType *),
+                            node removed (int *)
+Function output/returned: root of updated subtree (int)
 Device input/---: none
 Device output/---: none
-Dependencies: none
+Dependencies: balanceChainTree, removeChainTreeMinimum (recursively)
 */
-int getStringLength( const char *str )
+int removeChainTreeMinimum( HashTreeLinkType *links, int node, int *minimum )
   {
-  // variables
-  int index = 0;
-  
-  // find the string length
-  while( str[ index ] != NULL_CHAR )
+  if( links[ node ].left == NO_CHAIN_NODE )
     {
-    // increment index   
-    index++;
+    *minimum = node;
+    
+    return links[ node ].right;
     }
   
-  // return string length	
-  return index;	
+  links[ node ].left = removeChainTreeMinimum( links, links[ node ].left, 
+                                                                    minimum );
+  
+  return balanceChainTree( links, node );
   }
 
 /*
-Name: initializeHeap
-Process: creates dynamically allocated heap, 
-         creates dynamically allocated array of empty StateDataType items,
-         initializes tableSize to given capacity,
-         initializes probe strategy to given strategy
-Function input/parameters: provided capacity (int),
-                           provided probe strategy (ProbeType)
-Function output/parameters: none
-Function output/returned: pointer to created heap (ProbingHashType *)
+Name: removeHashIndexHook
+Process: detaches secondary index hook from table
+Function input/parameters: hash data (ProbingHashType *), 
+                           hook (HashIndexHookType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: true if hook was attached, false otherwise (bool)
 Device input/---: none
 Device output/---: none
-Dependencies: malloc, sizeof, setEmptyHeapNode, 
+Dependencies: none
 */
-ProbingHashType *initializeHashTable( int capacity, ProbeType probe )
+bool removeHashIndexHook( ProbingHashType *hash, HashIndexHookType *hook )
   {
-  // variables	
-  ProbingHashType *newHash;
-  int index;
-  	
-  // allocate memory for heap
-  newHash = ( ProbingHashType *)malloc( sizeof( ProbingHashType ) );
-  
-  // allocate memory for array of empty stateDataType items
-  newHash->array = (StateDataType *)malloc( 
-            capacity * sizeof( StateDataType ) );
-  
-  // set tableSize to given capacity
-  newHash->tableSize = capacity;
-  
-  // set prob strategy	
-  newHash->probeStrategy = probe;
+  // variables
+  HashIndexHookType **linkPtr = &hash->indexHooks;
   
-  // set all index's to empty
-  for( index = 0; index < capacity; index++ )
+  // find link to hook, unlink
+  while( *linkPtr != NULL )
     {
-    setEmptyHashNode( &newHash->array[index] );
+    if( *linkPtr == hook )
+      {
+      *linkPtr = hook->next;
+      hook->next = NULL;
+      
+      return true;
+      }
+    
+    linkPtr = &( *linkPtr )->next;
     }
   
-  return newHash;
+  return false;
   }
 
 /*
 Name: removeState
 Process: finds item in hash table, removes, 
          sets array location to unused (but does not set any other data),
+         chained nodes are unlinked from bucket for reuse,
          returns removed state
 Function input/parameters: provided search data (const StateDataType),
                            heap (const ProbingHashType)
@@ -519,7 +2526,8 @@ Function output/parameters: returned state (StateDataType *)
 Function output/returned: Boolean result of action (bool)
 Device input/---: none
 Device output/---: none
-Dependencies: findItemIndex, setHeapNodeFromStruct
+Dependencies: findItemIndex, guardNodeWrite, setHeapNodeFromStruct,
+              notifyIndexHooks, bound unlinkNode
 */
 bool removeState( StateDataType *removedState, 
                   const StateDataType toBeRemoved, const ProbingHashType hash )
@@ -536,7 +2544,17 @@ bool removeState( StateDataType *removedState,
     // move data to removedState
     setHashNodeFromStruct( removedState, hash.array[index] );
   
+    // indexes drop node while its data is still set
+    notifyIndexHooks( &hash, &hash.array[ index ], false );
+  
+    // chained node leaves its bucket, while its name is still set
+    if( hash.probeFunctions->unlinkNode != NULL )
+      {
+      hash.probeFunctions->unlinkNode( &hash, index );
+      }
+  
     // sets array location to unused
+    guardNodeWrite( &hash, index );
     hash.array[ index ].inUse = UNUSED_NODE;
   
     // return sucess	
@@ -547,6 +2565,90 @@ bool removeState( StateDataType *removedState,
   return false;
   }
 
+/*
+Name: returnPoolNode
+Process: puts removed node back in its slab for reuse, 
+         slab joins front of open slab list if it was full and 
+         open slab scan has passed it
+Function input/parameters: hash (const ProbingHashType *), node (int)
+Function output/parameters: updated slabs and links (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getSlabFreeNode
+*/
+void returnPoolNode( const ProbingHashType *hash, int nodeIndex )
+  {
+  // variables
+  HashChainType *chains = hash->chains;
+  int slab = nodeIndex / HASH_SLAB_NODE_COUNT;
+  HashSlabType *slabPtr = &chains->slabs[ slab ];
+  
+  // full slab opens again, scan finds it if not yet passed
+  if( getSlabFreeNode( hash, slab ) == NO_CHAIN_NODE 
+                                                 && slab < chains->scanSlab )
+    {
+    slabPtr->listed = true;
+    slabPtr->previous = NO_CHAIN_NODE;
+    slabPtr->next = chains->openSlab;
+    
+    if( chains->openSlab != NO_CHAIN_NODE )
+      {
+      chains->slabs[ chains->openSlab ].previous = slab;
+      }
+    
+    chains->openSlab = slab;
+    }
+  
+  chains->links[ nodeIndex ].right = slabPtr->freeNode - 1;
+  slabPtr->freeNode = nodeIndex + 1;
+  }
+
+/*
+Name: rotateChainTree
+Process: rotates chained bucket subtree left (right child becomes root)
+         or right (left child becomes root), updates heights
+Function input/parameters: tree links (HashTreeLinkType *), 
+                           subtree root (int), left rotation flag (bool)
+Function output/parameters: updated tree links (HashTreeLinkType *)
+Function output/returned: new subtree root (int)
+Device input/---: none
+Device output/---: none
+Dependencies: getChainTreeHeight
+*/
+int rotateChainTree( HashTreeLinkType *links, int node, bool rotateLeft )
+  {
+  // variables
+  int pivot, leftHeight, rightHeight;
+  
+  if( rotateLeft )
+    {
+    pivot = links[ node ].right;
+    links[ node ].right = links[ pivot ].left;
+    links[ pivot ].left = node;
+    }
+  
+  else
+    {
+    pivot = links[ node ].left;
+    links[ node ].left = links[ pivot ].right;
+    links[ pivot ].right = node;
+    }
+  
+  // old root is now child of pivot
+  leftHeight = getChainTreeHeight( links, links[ node ].left );
+  rightHeight = getChainTreeHeight( links, links[ node ].right );
+  links[ node ].height = 1 + ( leftHeight > rightHeight 
+                                                 ? leftHeight : rightHeight );
+  
+  leftHeight = getChainTreeHeight( links, links[ pivot ].left );
+  rightHeight = getChainTreeHeight( links, links[ pivot ].right );
+  links[ pivot ].height = 1 + ( leftHeight > rightHeight 
+                                                 ? leftHeight : rightHeight );
+  
+  return pivot;
+  }
+
 /*
 Name: setEmptyHeapNode
 Process: sets given node values to empty string, zero values,
@@ -574,6 +2676,38 @@ void setEmptyHashNode( StateDataType *node )
 
 
 
+/*
+Name: setFilterName
+Process: sets bits of name in membership filter, same block and bits
+         as checkHashFilter reads
+Function input/parameters: filter (HashFilterType *),
+                           name (const char *), name length (int)
+Function output/parameters: updated filter (HashFilterType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getFilterNameHash
+*/
+static inline void setFilterName( HashFilterType *filter, const char *name, 
+                                                              int nameLength )
+  {
+  // variables
+  unsigned long long hashValue = getFilterNameHash( name, nameLength );
+  unsigned long long bitHash = hashValue * 0x9E3779B97F4A7C15ULL;
+  unsigned long long *block = &filter->blocks[ HASH_FILTER_BLOCK_WORDS
+        * ( ( ( hashValue >> 32 ) * (unsigned long long)filter->blockCount ) 
+                                                                    >> 32 ) ];
+  unsigned long long bit;
+  int bitIndex;
+  
+  for( bitIndex = 0; bitIndex < HASH_FILTER_BITS_PER_NAME; bitIndex++ )
+    {
+    bit = ( bitHash >> ( 64 - 9 * ( bitIndex + 1 ) ) ) & 511;
+    
+    block[ bit >> 6 ] |= 1ULL << ( bit & 63 );
+    }
+  }
+
 /*
 Name: setHeapNodeFromData
 Process: sets given values into a given heap struct, 
@@ -619,6 +2753,94 @@ void setHashNodeFromStruct( StateDataType *nodePtr,
                 source.lowestTemp, source.highestTemp, source.inUse );
   }
 
+/*
+Name: setHashTableVerbose
+Process: turns display of probing process on or off for the table,
+         tables are created with display on
+Function input/parameters: hash data (ProbingHashType *),
+                           display flag (bool)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void setHashTableVerbose( ProbingHashType *hash, bool showProbing )
+  {
+  // set display flag
+  hash->showProbing = showProbing;
+  
+  // display changes which probe loops are used
+  bindProbeFunctions( hash );
+  }
+
+/*
+Name: setHashWriteBarrier
+Process: attaches write barrier to table, or detaches it if NULL
+Function input/parameters: hash data (ProbingHashType *),
+                           barrier, or NULL (HashWriteBarrierType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void setHashWriteBarrier( ProbingHashType *hash, 
+                                            HashWriteBarrierType *barrier )
+  {
+  hash->writeBarrier = barrier;
+  }
+
+/*
+Name: setTableArrayPolicy
+Process: sets NUMA memory policy of mapped node array (mbind system
+         call, no NUMA library needed): preferred local node, 
+         interleaved over all allowed nodes, or bound to given node
+Function input/parameters: array (void *), mapped length (size_t),
+                           options (const HashAllocationOptionsType *)
+Function output/parameters: none
+Function output/returned: true if policy was set, false if unsupported
+                          or node is invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: syscall
+*/
+bool setTableArrayPolicy( void *array, size_t length, 
+                                  const HashAllocationOptionsType *options )
+  {
+#if defined( __linux__ ) && defined( SYS_mbind )
+  // variables
+  unsigned long nodeMask = 0;
+  unsigned long maskBits = sizeof( nodeMask ) * 8;
+  int mode = NUMA_POLICY_PREFERRED;
+  
+  // interleave over every node, kernel keeps only allowed ones
+  if( options->numaPolicy == NUMA_INTERLEAVE )
+    {
+    mode = NUMA_POLICY_INTERLEAVE;
+    nodeMask = ~0UL;
+    }
+  
+  else if( options->numaPolicy == NUMA_BIND )
+    {
+    if( options->numaNode < 0 || (unsigned long)options->numaNode >= maskBits )
+      {
+      return false;
+      }
+    
+    mode = NUMA_POLICY_BIND;
+    nodeMask = 1UL << options->numaNode;
+    }
+  
+  // empty preferred mask is local node
+  return syscall( SYS_mbind, array, length, mode, 
+                    nodeMask != 0 ? &nodeMask : NULL, 
+                                  nodeMask != 0 ? maskBits + 1 : 0, 0 ) == 0;
+#else
+  return false;
+#endif
+  }
+
 /*
 Name: showHashTableStatus
 Process: displays array <D>ata values and <U>unused values 
@@ -715,6 +2937,57 @@ void showHashTableStatus( const ProbingHashType hash)
   	
   }
 
+/*
+Name: takePoolNode
+Process: takes node found by getSlabFreeNode from its slab, 
+         slab leaves open slab list, if listed, once it is full
+Function input/parameters: hash (const ProbingHashType *), node (int)
+Function output/parameters: updated slabs (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getSlabFreeNode
+*/
+void takePoolNode( const ProbingHashType *hash, int nodeIndex )
+  {
+  // variables
+  HashChainType *chains = hash->chains;
+  int slab = nodeIndex / HASH_SLAB_NODE_COUNT;
+  HashSlabType *slabPtr = &chains->slabs[ slab ];
+  
+  // removed node, or next node never used
+  if( nodeIndex == slabPtr->freeNode - 1 )
+    {
+    slabPtr->freeNode = chains->links[ nodeIndex ].right + 1;
+    }
+  
+  else
+    {
+    slabPtr->takenCount++;
+    }
+  
+  // full slab leaves open list
+  if( slabPtr->listed && getSlabFreeNode( hash, slab ) == NO_CHAIN_NODE )
+    {
+    slabPtr->listed = false;
+    
+    if( slabPtr->previous != NO_CHAIN_NODE )
+      {
+      chains->slabs[ slabPtr->previous ].next = slabPtr->next;
+      }
+    
+    else
+      {
+      chains->openSlab = slabPtr->next;
+      }
+    
+    if( slabPtr->next != NO_CHAIN_NODE )
+      {
+      chains->slabs[ slabPtr->next ].previous = slabPtr->previous;
+      }
+    }
+  }
+
 /*
 Name: toPower
 Process: recursively calculates result of given base to given exponent,
@@ -738,3 +3011,142 @@ int toPower( int base, int exponent )
   // return failure	
   return 0;	
   }
+
+/*
+Name: unlinkNodeChained
+Process: removes node from list of its bucket, found again from 
+         node name, then puts node back in node pool
+Function input/parameters: hash data (const ProbingHashType *), node (int)
+Function output/parameters: updated buckets, links, and slabs 
+                            (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getHashIndexFromView, getStringLength, returnPoolNode
+*/
+void unlinkNodeChained( const ProbingHashType *hash, int nodeIndex )
+  {
+  // variables
+  HashTreeLinkType *links = hash->chains->links;
+  const char *name = hash->array[ nodeIndex ].name;
+  HashBucketType *bucket = &hash->chains->buckets[ 
+                 getHashIndexFromView( hash, name, getStringLength( name ) ) ];
+  int previous = links[ nodeIndex ].left, next = links[ nodeIndex ].right;
+  
+  if( previous != NO_CHAIN_NODE )
+    {
+    links[ previous ].right = next;
+    }
+  
+  else
+    {
+    bucket->root = next;
+    }
+  
+  if( next != NO_CHAIN_NODE )
+    {
+    links[ next ].left = previous;
+    }
+  
+  bucket->count--;
+  
+  returnPoolNode( hash, nodeIndex );
+  }
+
+/*
+Name: unlinkNodeTreeChained
+Process: removes node from its bucket, found again from node name,
+         converting bucket tree back to inline array once it fits,
+         then puts node back in node pool
+Function input/parameters: hash data (const ProbingHashType *), node (int)
+Function output/parameters: updated buckets, links, and slabs 
+                            (in hash chains)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: getHashIndexFromView, getStringLength, removeChainTree,
+              collectChainTree, returnPoolNode
+*/
+void unlinkNodeTreeChained( const ProbingHashType *hash, int nodeIndex )
+  {
+  // variables
+  HashChainType *chains = hash->chains;
+  const char *name = hash->array[ nodeIndex ].name;
+  HashBucketType *bucket = &chains->buckets[ 
+                 getHashIndexFromView( hash, name, getStringLength( name ) ) ];
+  int index;
+  
+  // inline array, move last node into place
+  if( bucket->count <= TREE_BUCKET_INLINE_COUNT )
+    {
+    for( index = 0; bucket->nodes[ index ] != nodeIndex; index++ );
+    
+    bucket->nodes[ index ] = bucket->nodes[ bucket->count - 1 ];
+    }
+  
+  else
+    {
+    bucket->root = removeChainTree( hash, bucket->root, nodeIndex );
+    
+    // tree fits inline array again
+    if( bucket->count - 1 == TREE_BUCKET_INLINE_COUNT )
+      {
+      collectChainTree( chains->links, bucket->root, bucket->nodes, 0 );
+      }
+    }
+  
+  bucket->count--;
+  
+  returnPoolNode( hash, nodeIndex );
+  }
+
+/*
+Name: upsertItem
+Process: replaces temperatures of item with same name in table, 
+         index hooks told node was removed then added, 
+         adds item as addItemFromStruct if name is not in table
+Function input/parameters: hash data (ProbingHashType *), 
+                           new item (StateDataType)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: result of operation,
+                          false if item could not be added (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: findItemIndex, guardNodeWrite, notifyIndexHooks, 
+              addItemFromStruct
+*/
+bool upsertItem( ProbingHashType *hash, StateDataType newItem )
+  {
+  // variables
+  int index;
+  StateDataType *nodePtr;
+  
+  // check for no prob strategy first
+  if( hash->probeStrategy == NO_PROBING )
+    {
+    return false;
+    }
+  
+  index = findItemIndex( hash, newItem );
+  
+  // new name, added as usual
+  if( index == ITEM_NOT_FOUND )
+    {
+    return addItemFromStruct( hash, newItem );
+    }
+  
+  nodePtr = &hash->array[ index ];
+  
+  guardNodeWrite( hash, index );
+  
+  notifyIndexHooks( hash, nodePtr, false );
+  
+  // name and bucket unchanged, node stays linked
+  nodePtr->averageTemp = newItem.averageTemp;
+  nodePtr->lowestTemp = newItem.lowestTemp;
+  nodePtr->highestTemp = newItem.highestTemp;
+  
+  notifyIndexHooks( hash, nodePtr, true );
+  
+  return true;
+  }
@@ -7,14 +7,38 @@
 #include <stdlib.h>
 
 // constants
-typedef enum { NO_PROBING, LINEAR_PROBING = 101, 
-                                            QUADRATIC_PROBING = 202 } ProbeType;
+typedef enum { NO_PROBING, LINEAR_PROBING = 101, QUADRATIC_PROBING = 202, 
+                           TREE_CHAINING = 303, CHAINING = 404 } ProbeType;
 extern const int MINIMUM_HASH_LETTER_COUNT;
 extern const int ITEM_NOT_FOUND;
 extern const bool USED_NODE;
 extern const bool UNUSED_NODE;
 
+// nodes held in inline array of chained bucket, 
+// buckets holding more are kept as balanced trees
+#define TREE_BUCKET_INLINE_COUNT 6
+
+// nodes per slab of chained table node pool
+#define HASH_SLAB_NODE_COUNT 16
+
+// page size asked for node array, huge pages cut TLB misses of 
+// random probes on large tables
+typedef enum { STANDARD_PAGES, HUGE_PAGES_2MB, HUGE_PAGES_1GB 
+                                                         } HashPageSizeType;
+
+// NUMA placement asked for node array, local to allocating thread,
+// interleaved over all nodes, or bound to one node
+typedef enum { NUMA_DEFAULT, NUMA_LOCAL, NUMA_INTERLEAVE, NUMA_BIND 
+                                                       } HashNumaPolicyType;
+
+// how node array was allocated, so it is released the same way
+typedef enum { HEAP_ALLOCATION, MAPPED_ALLOCATION, 
+               TRANSPARENT_HUGE_ALLOCATION, HUGE_PAGE_ALLOCATION,
+                            ALLOCATOR_ALLOCATION } HashAllocationKindType;
+
 // data structures
+
+// table node, all zero bytes is an empty node (not in use)
 typedef struct StateStruct
    {
     char name[ STD_STR_LEN ];
@@ -24,6 +48,167 @@ typedef struct StateStruct
     bool inUse;
    } StateDataType;
 
+// memory source for all allocations of a table, allocate returns 
+// zeroed memory of given size and alignment, or NULL if out of memory,
+// release may be NULL for regions (arenas) freed all at once
+typedef struct HashAllocatorStruct
+   {
+    void *( *allocate )( void *allocatorData, size_t size, 
+                                                          size_t alignment );
+
+    void ( *release )( void *allocatorData, void *memory );
+
+    void *allocatorData;
+   } HashAllocatorType;
+
+// node array allocation options, all zero is plain heap allocation,
+// allocator, if given, serves whole table and page size and NUMA 
+// options are then ignored
+typedef struct HashAllocationOptionsStruct
+   {
+    HashPageSizeType pageSize;
+
+    HashNumaPolicyType numaPolicy;
+
+    int numaNode;
+
+    const HashAllocatorType *allocator;
+   } HashAllocationOptionsType;
+
+// node array allocation made, huge pages fall back to transparent 
+// huge pages, then standard pages, NUMA policy is a hint
+typedef struct HashAllocationStruct
+   {
+    HashAllocationKindType kind;
+
+    size_t mappedLength;
+
+    bool numaPlaced;
+   } HashAllocationType;
+
+struct HashStruct;
+
+// secondary index kept in sync with nodes added to and removed from
+// table, hooks are chained and owned by their index
+typedef struct HashIndexHookStruct
+   {
+    void ( *nodeAdded )( void *indexData, const StateDataType *node );
+
+    void ( *nodeRemoved )( void *indexData, const StateDataType *node );
+
+    void *indexData;
+
+    struct HashIndexHookStruct *next;
+   } HashIndexHookType;
+
+// told before any node of table is written, with index of node, 
+// so copy on write snapshots can keep the page of node first
+typedef struct HashWriteBarrierStruct
+   {
+    void ( *beforeWrite )( void *barrierData, int nodeIndex );
+
+    void *barrierData;
+   } HashWriteBarrierType;
+
+// chained bucket, for TREE_CHAINING node indices in short inline array
+// while count is at most TREE_BUCKET_INLINE_COUNT, otherwise root of 
+// balanced tree of nodes ordered by name (as compareStates), then by
+// node index; for CHAINING root is first node of list
+typedef struct HashBucketStruct
+   {
+    int count;
+
+    int root;
+
+    int nodes[ TREE_BUCKET_INLINE_COUNT ];
+   } HashBucketType;
+
+// tree links of chained node, or previous (left) and next (right) node
+// of list, parallel to table array; unused nodes link to next unused
+// node of their slab through right links
+typedef struct HashTreeLinkStruct
+   {
+    int left, right, height;
+   } HashTreeLinkType;
+
+// slab of HASH_SLAB_NODE_COUNT nodes of table array, removed nodes
+// are reused first (free node is first of them plus one, zero if
+// none), then nodes never used, in order (taken count of them);
+// all zero is a slab of unused nodes, so slabs need no setup;
+// slabs reopened behind open slab scan are linked in open slab list
+typedef struct HashSlabStruct
+   {
+    int freeNode;
+
+    int takenCount;
+
+    bool listed;
+
+    int previous, next;
+   } HashSlabType;
+
+// chained storage, nodes are pooled in slabs of the table array,
+// each bucket takes nodes from its home slab while it has unused
+// nodes, so nodes of a bucket are mostly contiguous, then from 
+// first reopened slab, then from first slab not full at or after
+// scan slab, which only moves forward; bucket count may be less than
+// table size, so load factor (nodes per bucket) may be above 1.0
+typedef struct HashChainStruct
+   {
+    HashBucketType *buckets;
+
+    int bucketCount;
+
+    HashTreeLinkType *links;
+
+    HashSlabType *slabs;
+
+    int slabCount;
+
+    int openSlab;
+
+    int scanSlab;
+   } HashChainType;
+
+// blocked Bloom filter over names in table, each name sets bits in one
+// 512 bit block (one cache line), checked before probing so most
+// missing names are rejected with one block read; kept in sync by its
+// own index hook, rebuilt once removed names outnumber names in table
+typedef struct HashFilterStruct
+   {
+    unsigned long long *blocks;
+
+    int blockCount;
+
+    int itemCount;
+
+    int staleCount;
+
+    int rebuildCount;
+
+    struct HashStruct *hashTable;
+
+    HashIndexHookType hook;
+   } HashFilterType;
+
+// probe loops bound to a table, chosen by bindProbeFunctions,
+// chained strategies also link nodes into and out of their buckets
+// (NULL for open addressing)
+typedef struct HashProbeStruct
+   {
+    int ( *findItemIndex )( const struct HashStruct *hashTable, int hashIndex,
+                                           const char *name, int nameLength );
+
+    int ( *findOpenIndex )( const struct HashStruct *hashTable, 
+                                                              int hashIndex );
+
+    void ( *linkNode )( const struct HashStruct *hashTable, int hashIndex,
+                                                              int nodeIndex );
+
+    void ( *unlinkNode )( const struct HashStruct *hashTable, 
+                                                              int nodeIndex );
+   } HashProbeType;
+
 typedef struct HashStruct
    {
     StateDataType *array;
@@ -31,10 +216,61 @@ typedef struct HashStruct
     int tableSize;
 
     ProbeType probeStrategy;
+
+    bool showProbing;
+
+    const HashProbeType *probeFunctions;
+
+    HashIndexHookType *indexHooks;
+
+    HashWriteBarrierType *writeBarrier;
+
+    HashChainType *chains;
+
+    HashFilterType *filter;
+
+    HashAllocationType arrayAllocation;
+
+    HashAllocatorType allocator;
    } ProbingHashType;
 
 // prototypes
 
+/*
+Name: addHashIndexHook
+Process: attaches secondary index hook to table, hook is then told of 
+         every node added or removed until removed with 
+         removeHashIndexHook, which must be done before table is cleared
+Function input/parameters: hash data (ProbingHashType *), 
+                           hook (HashIndexHookType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void addHashIndexHook( ProbingHashType *hashTable, HashIndexHookType *hook );
+
+/*
+Name: addItemAtIndex
+Process: adds item to given unused node of open addressing table, 
+         as when a saved table is put back node for node, 
+         name is truncated to fit if needed
+Function input/parameters: hash data (ProbingHashType *), node (int),
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: false if table is chained or has no probing,
+                          or node is out of table or in use (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: guardNodeWrite, notifyIndexHooks
+*/
+bool addItemAtIndex( ProbingHashType *hash, int index, 
+                                  const char *name, int nameLength, 
+                                  double avgTemp, double lowTemp, 
+                                  double highTemp );
+
 /*
 Name: addItemFromData
 Process: adds item to hash table using data input,
@@ -51,32 +287,91 @@ Dependencies: setHashNodeFromData, addItemFromStruct
 bool addItemFromData( ProbingHashType *hashTable, const char *stateName, 
                               double avgTemp, double lowTemp, double highTemp );
 
+/*
+Name: addItemFromHashedView
+Process: adds item to hash table using name given as pointer and length
+         with its hash index already calculated (by getHashIndexFromView
+         on the name truncated to STD_STR_LEN - 1), so hashing
+         may be done ahead of time, for example on other threads
+Function input/parameters: hash data (ProbingHashType *), hash index (int),
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: result of operation (bool)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: findOpenIndex, printf, dataToString
+*/
+bool addItemFromHashedView( ProbingHashType *hashTable, int hashIndex,
+                                  const char *name, int nameLength, 
+                                  double avgTemp, double lowTemp, 
+                                  double highTemp );
+
 /*
 Name: addItemFromStruct
 Process: adds item to hash table using struct input,
          uses probing as specified in hash data,
-         may probe as many as tableSize times
+         may probe as many as tableSize times,
+         chained tables add to bucket of hash index
 Function input/parameters: hash data (ProbingHashType *), 
                            new item (StateDataType)
 Function output/parameters: updated hash table data (ProbingHashType *)
-Function output/returned: result of operation (bool)
+Function output/returned: result of operation,
+                          false if chained table has no unused node (bool)
 Device input/---: none
 Device output/monitor: probing process displayed
-Dependencies: getHashIndex, toPower, printf, dataToString,
+Dependencies: getHashIndex, findOpenIndex, printf, dataToString,
               setHashNodeFromStruct
 */
 bool addItemFromStruct( ProbingHashType *hashTable, StateDataType newItem );
 
+/*
+Name: addItemFromView
+Process: adds item to hash table using name given as pointer and length
+         (not NULL_CHAR terminated), name is copied once, directly into
+         the table node, truncated to fit if needed
+Function input/parameters: hash data (ProbingHashType *), 
+                           state name (const char *), name length (int),
+                           average, lowest, and highest temperatures (double)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: result of operation (bool)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: getHashIndexFromView, addItemFromHashedView
+*/
+bool addItemFromView( ProbingHashType *hashTable, const char *name, 
+                                  int nameLength, double avgTemp, 
+                                  double lowTemp, double highTemp );
+
+/*
+Name: bindProbeFunctions
+Process: binds probe loops to table once, from its probe strategy,
+         display setting, and table size (power of two sizes use masking
+         in place of modulo), so loops have no strategy branches,
+         chained tables always use their bucket functions,
+         called by initializeHashTable and setHashTableVerbose,
+         and must be called again if those fields are changed directly
+Function input/parameters: hash data (ProbingHashType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void bindProbeFunctions( ProbingHashType *hashTable );
+
 /*
 Name: clearHashTable
-Process: clear hash table array, sets size to zero,
-         sets probing to NO_PROBING, deallocates hash struct
+Process: clear hash table array, chained buckets, and filter, 
+         sets size to zero,
+         sets probing to NO_PROBING, deallocates hash struct,
+         all returned to allocator of table
 Function input/parameters: hash data (ProbingHashType *)
 Function output/parameters: updated hash table data (ProbingHashType *)
 Function output/returned: none
 Device input/---: none
 Device output/---: none
-Dependencies: free
+Dependencies: releaseTableArray, releaseTableMemory
 */
 void clearHashTable( ProbingHashType *hashTable );
 
@@ -121,6 +416,18 @@ Dependencies: sprintf, or other options
 */
 void dataToString( char *outStr, const StateDataType state );
 
+/*
+Name: disableHashFilter
+Process: detaches and releases membership filter of table, if any
+Function input/parameters: hash data (ProbingHashType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, releaseTableMemory
+*/
+void disableHashFilter( ProbingHashType *hashTable );
+
 /*
 Name: displayHashTable
 Process: array data dump of numbered data to screen, 
@@ -134,6 +441,23 @@ Dependencies: printf, dataToString
 */
 void displayHashTable( const ProbingHashType *hashTable );
 
+/*
+Name: enableHashFilter
+Process: creates membership filter of table sized for expected number 
+         of items (at least items already in table), fills it from 
+         table, attaches it so adds and removes keep it in sync; 
+         replaces filter already enabled
+Function input/parameters: hash data (ProbingHashType *),
+                           expected items (int)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: true if enabled, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: disableHashFilter, allocateTableMemory, releaseTableMemory, 
+              rebuildHashFilter, addHashIndexHook
+*/
+bool enableHashFilter( ProbingHashType *hashTable, int expectedItems );
+
 /*
 Name: findItem
 Process: finds item in hash table, returns
@@ -150,20 +474,41 @@ StateDataType findItem( const ProbingHashType *hashTable, StateDataType searchIt
 
 /*
 Name: findItemIndex
-Process: finds item index, using probing strategy provided in hash data,
+Process: finds item index, using probe loop bound to hash data,
+         names rejected by membership filter, if enabled, 
+         are not probed for,
          otherwise, 
          returns ITEM_NOT_FOUND if search fails after tableSize attempts,
-         displays index probing attempts
+         displays index probing attempts if enabled
 Function input/parameters: provided search data (const StateDataType),
                            hash (const ProbingHashType *)
 Function output/parameters: none
 Function output/returned: index or ITEM_NOT_FOUND (int) as specified
 Device input/---: none
 Device output/monitor: displays probing action, provided in sample run file
-Dependencies: getHashIndex, printf, compareStates, toPower, 
-              setHashNodeFromStruct
+Dependencies: getHashIndex, getStringLength, checkHashFilter, 
+              bound findItemIndex
 */
 int findItemIndex( const ProbingHashType *hashTable, StateDataType searchItem );
+
+/*
+Name: findOpenIndex
+Process: probes from given hash index for first unused node,
+         using probe loop bound to hash data,
+         may probe as many as tableSize times,
+         displays index probing attempts if enabled,
+         chained tables give next unused node for any hash index
+Function input/parameters: hash data (const ProbingHashType *),
+                           starting hash index (int)
+Function output/parameters: none
+Function output/returned: index of unused node, or last index probed,
+                          or ITEM_NOT_FOUND if chained table has 
+                          no unused node (int)
+Device input/---: none
+Device output/monitor: probing process displayed if enabled
+Dependencies: bound findOpenIndex
+*/
+int findOpenIndex( const ProbingHashType *hashTable, int hashIndex );
     
 /*
 Name: getHashIndex
@@ -181,6 +526,22 @@ Dependencies: getStringLength
 */
 int getHashIndex( const ProbingHashType hashTable, const StateDataType state );
 
+/*
+Name: getHashIndexFromView
+Process: finds hashed index for name given as pointer and length,
+         same calculation as getHashIndex, modulo bucket count for 
+         chained tables
+Function input/parameters: hash (const ProbingHashType *),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: array index generated from name (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int getHashIndexFromView( const ProbingHashType *hashTable, 
+                                          const char *name, int nameLength );
+
 /*
 Name: getStringLength
 Process: utility for finding string length
@@ -198,21 +559,87 @@ Name: initializeHash
 Process: creates dynamically allocated hash, 
          creates dynamically allocated array of empty StateDataType items,
          initializes tableSize to given capacity,
-         initializes probe strategy to given strategy
+         initializes probe strategy to given strategy,
+         creates one empty bucket per node for chained strategies,
+         binds probe loops
 Function input/parameters: provided capacity (int),
                            provided probe strategy (ProbeType)
 Function output/parameters: none
 Function output/returned: pointer to created hash (ProbingHashType *)
 Device input/---: none
 Device output/---: none
-Dependencies: malloc, sizeof, setEmptyHashNode, 
+Dependencies: initializeChainedHashTable
 */
 ProbingHashType *initializeHashTable( int capacity, ProbeType probe );
 
+/*
+Name: initializeChainedHashTable
+Process: creates hash as initializeHashTable, with given number of 
+         buckets for chained strategies, so table may hold more
+         nodes than buckets, bucket count is ignored for 
+         open addressing
+Function input/parameters: provided capacity, nodes held (int),
+                           bucket count (int),
+                           provided probe strategy (ProbeType)
+Function output/parameters: none
+Function output/returned: pointer to created hash (ProbingHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: initializeHashTableWithOptions
+*/
+ProbingHashType *initializeChainedHashTable( int capacity, int bucketCount,
+                                                            ProbeType probe );
+
+/*
+Name: initializeHashTableWithOptions
+Process: creates hash as initializeChainedHashTable, node array 
+         allocated with given page size and NUMA policy; huge pages 
+         not reserved fall back to transparent huge pages (madvise), 
+         then standard pages, NUMA policy is applied before array is 
+         first touched, ignored where unsupported; NULL options 
+         allocate from heap; nodes of all zero bytes are empty, 
+         so array is not touched here, pages fault in when used;
+         with allocator in options, table, its buckets, and any filter 
+         are taken from it, so a region allocator can drop the table
+         without clearHashTable; if any allocation fails, what was
+         taken is released
+Function input/parameters: provided capacity, nodes held (int),
+                           bucket count (int),
+                           provided probe strategy (ProbeType),
+                           allocation options, or NULL
+                           (const HashAllocationOptionsType *)
+Function output/parameters: none
+Function output/returned: pointer to created hash, or NULL if out of 
+                          memory (ProbingHashType *),
+                          array allocation made in arrayAllocation
+Device input/---: none
+Device output/---: none
+Dependencies: allocateTableMemory, sizeof, allocateTableArray, 
+              releaseTableMemory, releaseTableArray, bindProbeFunctions
+*/
+ProbingHashType *initializeHashTableWithOptions( int capacity, 
+                        int bucketCount, ProbeType probe, 
+                                 const HashAllocationOptionsType *options );
+
+/*
+Name: removeHashIndexHook
+Process: detaches secondary index hook from table
+Function input/parameters: hash data (ProbingHashType *), 
+                           hook (HashIndexHookType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: true if hook was attached, false otherwise (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+bool removeHashIndexHook( ProbingHashType *hashTable, 
+                                                   HashIndexHookType *hook );
+
 /*
 Name: removeState
 Process: finds item in hash table, removes, 
          sets array location to unused (but does not set any other data),
+         chained nodes are unlinked from bucket for reuse,
          returns removed state
 Function input/parameters: provided search data (const StateDataType),
                            hash (const ProbingHashType)
@@ -269,6 +696,37 @@ Dependencies: setHashNodeFromData
 void setHashNodeFromStruct( StateDataType *nodePtr, 
                                                    const StateDataType source );
 
+/*
+Name: setHashTableVerbose
+Process: turns display of probing process on or off for the table,
+         tables are created with display on,
+         rebinds probe loops to match
+Function input/parameters: hash data (ProbingHashType *),
+                           display flag (bool)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: bindProbeFunctions
+*/
+void setHashTableVerbose( ProbingHashType *hashTable, bool showProbing );
+
+/*
+Name: setHashWriteBarrier
+Process: attaches write barrier to table, or detaches it if NULL,
+         barrier is told of every node about to be written until
+         detached, which must be done before table is cleared
+Function input/parameters: hash data (ProbingHashType *),
+                           barrier, or NULL (HashWriteBarrierType *)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void setHashWriteBarrier( ProbingHashType *hashTable, 
+                                           HashWriteBarrierType *barrier );
+
 /*
 Name: showHashTableStatus
 Process: displays array <D>ata values and <U>unused values 
@@ -299,4 +757,21 @@ Dependencies: toPower (recursively)
 */
 int toPower( int base, int exponent );
 
+/*
+Name: upsertItem
+Process: replaces temperatures of item with same name in table, 
+         index hooks told node was removed then added, 
+         adds item as addItemFromStruct if name is not in table
+Function input/parameters: hash data (ProbingHashType *),
+                           new item (StateDataType)
+Function output/parameters: updated hash table data (ProbingHashType *)
+Function output/returned: result of operation,
+                          false if item could not be added (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: findItemIndex, guardNodeWrite, notifyIndexHooks, 
+              addItemFromStruct
+*/
+bool upsertItem( ProbingHashType *hashTable, StateDataType newItem );
+
 #endif   // HASH_UTILITIES_H
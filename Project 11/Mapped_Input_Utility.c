@@ -0,0 +1,356 @@
+/*
+Memory mapped file input utility, function implementations
+*/
+
+// header files
+#include "Mapped_Input_Utility.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "Scan_Utility.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+    /*
+    Name: checkForEndOfMap
+    process: checks to see if end of mapped data has been encountered,
+             returns true if EOF has been encountered, false otherwise
+    Function input/parameters: mapped file (const MappedFileType *)
+    Function output/parameters: none
+    Function output/returned: result of specified test (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    bool checkForEndOfMap( const MappedFileType *mappedFile )
+       {
+        // return end of file flag
+        return mappedFile->endOfFileFlag;
+       }
+
+    /*
+    Name: closeMappedFile
+    process: unmaps (or frees) file data and releases mapped file struct,
+             returns true if successful, false otherwise
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: none
+    Function output/returned: success of operation (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: munmap, free
+    */
+    bool closeMappedFile( MappedFileType *mappedFile )
+       {
+        // check for valid mapped file
+        if( mappedFile == NULL )
+           {
+            return false;
+           }
+
+        // release file data
+#ifndef _WIN32
+        if( mappedFile->isMapped )
+           {
+            // function: munmap
+            munmap( (void *)mappedFile->data, mappedFile->length );
+           }
+
+        else
+#endif
+           {
+            // function: free
+            free( (void *)mappedFile->data );
+           }
+
+        // release struct
+           // function: free
+        free( mappedFile );
+
+        // return successful operation
+        return true;
+       }
+
+    /*
+    Name: getMapParseStatus
+    process: provides status of first failed number conversion in mapping,
+             PARSE_SUCCESS if none has failed
+    Function input/parameters: mapped file (const MappedFileType *)
+    Function output/parameters: byte offset of failed number,
+                                if any (size_t *)
+    Function output/returned: first failed parse status (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    ParseStatusType getMapParseStatus( const MappedFileType *mappedFile,
+                                                           size_t *errorOffset )
+       {
+        // set offset, return status
+        *errorOffset = mappedFile->parseErrorOffset;
+
+        return mappedFile->parseStatus;
+       }
+
+    /*
+    Name: openMappedFile
+    process: maps whole file read only, advises kernel of sequential access,
+             returns NULL if file cannot be opened or mapped
+    Function input/parameters: file name (c-string)
+    Function output/parameters: none
+    Function output/returned: pointer to mapped file (MappedFileType *)
+    Device input/file: file mapped
+    Device output/monitor: none
+    Dependencies: open, fstat, mmap, madvise, close, malloc
+    */
+    MappedFileType *openMappedFile( const char *fileName )
+       {
+        // initialize variables
+        MappedFileType *mappedFile;
+        void *data = NULL;
+        size_t length = 0;
+        bool isMapped = false;
+
+#ifdef _WIN32
+        // no mmap, read whole file into memory
+        FILE *filePtr = fopen( fileName, "rb" );
+
+        if( filePtr == NULL )
+           {
+            return NULL;
+           }
+
+        fseek( filePtr, 0, SEEK_END );
+        length = (size_t)ftell( filePtr );
+        fseek( filePtr, 0, SEEK_SET );
+
+        data = malloc( length + 1 );
+        length = fread( data, 1, length, filePtr );
+        fclose( filePtr );
+#else
+        struct stat fileStats;
+        int fileDescriptor = open( fileName, O_RDONLY );
+
+        if( fileDescriptor < 0 )
+           {
+            return NULL;
+           }
+
+        // get file size
+           // function: fstat
+        if( fstat( fileDescriptor, &fileStats ) != 0 )
+           {
+            close( fileDescriptor );
+
+            return NULL;
+           }
+
+        length = (size_t)fileStats.st_size;
+
+        // map non empty file, mapping stays valid after close
+        if( length > 0 )
+           {
+            // function: mmap
+            data = mmap( NULL, length, PROT_READ, MAP_PRIVATE, 
+                                                          fileDescriptor, 0 );
+
+            if( data == MAP_FAILED )
+               {
+                close( fileDescriptor );
+
+                return NULL;
+               }
+
+            // read ahead aggressively, drop pages behind the cursor
+               // function: madvise
+            madvise( data, length, MADV_SEQUENTIAL );
+
+            isMapped = true;
+           }
+
+        close( fileDescriptor );
+#endif
+
+        // create mapped file
+           // function: malloc
+        mappedFile = (MappedFileType *)malloc( sizeof( MappedFileType ) );
+
+        mappedFile->data = (const char *)data;
+        mappedFile->length = length;
+        mappedFile->position = 0;
+        mappedFile->endOfFileFlag = false;
+        mappedFile->isMapped = isMapped;
+        mappedFile->parseStatus = PARSE_SUCCESS;
+        mappedFile->parseErrorOffset = 0;
+
+        // return new mapped file
+        return mappedFile;
+       }
+
+    /*
+    Name: readCharacterFromMap
+    process: ignores leading unprintable characters, including space,
+             captures first printable character
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: updated mapped file (MappedFileType *)
+    Function output/returned: character found if successful, '0' otherwise
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: skipWhiteSpace
+    */
+    char readCharacterFromMap( MappedFileType *mappedFile )
+       {
+        // skip white space, including space
+           // function: skipWhiteSpace
+        mappedFile->position = (size_t)( skipWhiteSpace( 
+                           mappedFile->data + mappedFile->position,
+                           mappedFile->data + mappedFile->length, true )
+                                                         - mappedFile->data );
+
+        // check for end of file found
+        if( mappedFile->position >= mappedFile->length )
+           {
+            mappedFile->endOfFileFlag = true;
+
+            return '0';
+           }
+
+        // return, consume character
+        mappedFile->position++;
+
+        return mappedFile->data[ mappedFile->position - 1 ];
+       }
+
+    /*
+    Name: readDoubleFromMap
+    process: ignores leading unprintable characters,
+             captures first contiguous double value directly from mapping,
+             records first failed conversion and its position
+             (see getMapParseStatus)
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: updated mapped file (MappedFileType *)
+    Function output/returned: double value found if successful, zero otherwise
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: skipWhiteSpace, parseDoubleFromSpan
+    */
+    double readDoubleFromMap( MappedFileType *mappedFile )
+       {
+        // initialize variables
+        const char *startPtr, *endPtr;
+        double doubleVal;
+        ParseStatusType status;
+
+        // skip white space, including space
+           // function: skipWhiteSpace
+        mappedFile->position = (size_t)( skipWhiteSpace( 
+                           mappedFile->data + mappedFile->position,
+                           mappedFile->data + mappedFile->length, true )
+                                                         - mappedFile->data );
+
+        // check for end of file found
+        if( mappedFile->position >= mappedFile->length )
+           {
+            mappedFile->endOfFileFlag = true;
+
+            return 0.0;
+           }
+
+        // convert in place, bounded by end of mapping
+           // function: parseDoubleFromSpan
+        startPtr = mappedFile->data + mappedFile->position;
+        status = parseDoubleFromSpan( startPtr, 
+                 mappedFile->data + mappedFile->length, &doubleVal, &endPtr );
+
+        // keep first failure and where it happened
+        if( status != PARSE_SUCCESS && mappedFile->parseStatus == PARSE_SUCCESS )
+           {
+            mappedFile->parseStatus = status;
+            mappedFile->parseErrorOffset = mappedFile->position;
+           }
+
+        // consume converted characters
+        mappedFile->position += (size_t)( endPtr - startPtr );
+
+        // return acquired value
+        return doubleVal;
+       }
+
+    /*
+    Name: readViewToDelimiterFromMap
+    process: ignores leading white space, including space character,
+             sets view to series of characters up to specified character,
+             any non printable character, or MAX_STR_LEN - 1 characters,
+             consumes the stopping character
+    Function input/parameters: mapped file (MappedFileType *), delimiter (char)
+    Function output/parameters: view into mapped data (StringViewType *)
+    Function output/returned: success of operation (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: skipWhiteSpace, findDelimiterOrControl
+    */
+    bool readViewToDelimiterFromMap( MappedFileType *mappedFile,
+                                     char delimiter, StringViewType *view )
+       {
+        // initialize variables
+        size_t position = mappedFile->position;
+        size_t startPosition, endPosition;
+
+        // set empty view
+        view->start = mappedFile->data + position;
+        view->length = 0;
+
+        // check for data accessible
+        if( mappedFile->endOfFileFlag )
+           {
+            return false;
+           }
+
+        // skip white space, including space
+           // function: skipWhiteSpace
+        position = (size_t)( skipWhiteSpace( mappedFile->data + position,
+                                  mappedFile->data + mappedFile->length, true )
+                                                         - mappedFile->data );
+
+        // check for end of file found
+        if( position >= mappedFile->length )
+           {
+            mappedFile->position = position;
+            mappedFile->endOfFileFlag = true;
+
+            return false;
+           }
+
+        // scan to delimiter, non printable, or full string
+           // function: findDelimiterOrControl
+        startPosition = position;
+        endPosition = mappedFile->length;
+
+        if( endPosition - startPosition > MAX_STR_LEN - 1 )
+           {
+            endPosition = startPosition + MAX_STR_LEN - 1;
+           }
+
+        position = (size_t)( findDelimiterOrControl( 
+                                    mappedFile->data + startPosition,
+                                    mappedFile->data + endPosition, delimiter )
+                                                         - mappedFile->data );
+
+        // set view
+        view->start = mappedFile->data + startPosition;
+        view->length = (int)( position - startPosition );
+
+        // consume stopping character
+        if( position < mappedFile->length )
+           {
+            position++;
+           }
+
+        mappedFile->position = position;
+
+        // return successful operation
+        return true;
+       }
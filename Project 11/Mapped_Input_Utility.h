@@ -0,0 +1,141 @@
+/*
+Memory mapped file input utility, function prototypes
+
+Maps an entire input file read only and tokenizes it in place;
+string fields are returned as pointer and length views into the mapping,
+so no characters are copied until the caller stores them.
+Falls back to reading the whole file into memory where mmap is unavailable.
+*/
+
+// PreProcessor test
+#ifndef MAPPED_INPUT_UTILITY_H
+#define MAPPED_INPUT_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include <stddef.h>
+#include "StandardConstants.h"
+#include "Number_Parse_Utility.h"
+
+// data structures
+
+    // non terminated string, points into mapped file data
+    typedef struct StringViewStruct
+       {
+        const char *start;
+        int length;
+       } StringViewType;
+
+    // mapped file with read position
+    typedef struct MappedFileStruct
+       {
+        const char *data;
+        size_t length;
+        size_t position;
+        bool endOfFileFlag;
+        bool isMapped;
+        ParseStatusType parseStatus;
+        size_t parseErrorOffset;
+       } MappedFileType;
+
+// function prototypes
+
+    /*
+    Name: checkForEndOfMap
+    process: checks to see if end of mapped data has been encountered,
+             returns true if EOF has been encountered, false otherwise
+    Function input/parameters: mapped file (const MappedFileType *)
+    Function output/parameters: none
+    Function output/returned: result of specified test (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    bool checkForEndOfMap( const MappedFileType *mappedFile );
+
+    /*
+    Name: closeMappedFile
+    process: unmaps (or frees) file data and releases mapped file struct,
+             returns true if successful, false otherwise
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: none
+    Function output/returned: success of operation (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: munmap, free
+    */
+    bool closeMappedFile( MappedFileType *mappedFile );
+
+    /*
+    Name: getMapParseStatus
+    process: provides status of first failed number conversion in mapping,
+             PARSE_SUCCESS if none has failed
+    Function input/parameters: mapped file (const MappedFileType *)
+    Function output/parameters: byte offset of failed number,
+                                if any (size_t *)
+    Function output/returned: first failed parse status (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    ParseStatusType getMapParseStatus( const MappedFileType *mappedFile,
+                                                          size_t *errorOffset );
+
+    /*
+    Name: openMappedFile
+    process: maps whole file read only, advises kernel of sequential access,
+             returns NULL if file cannot be opened or mapped
+    Function input/parameters: file name (c-string)
+    Function output/parameters: none
+    Function output/returned: pointer to mapped file (MappedFileType *)
+    Device input/file: file mapped
+    Device output/monitor: none
+    Dependencies: open, fstat, mmap, madvise, close, malloc
+    */
+    MappedFileType *openMappedFile( const char *fileName );
+
+    /*
+    Name: readCharacterFromMap
+    process: ignores leading unprintable characters, including space,
+             captures first printable character
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: updated mapped file (MappedFileType *)
+    Function output/returned: character found if successful, '0' otherwise
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    char readCharacterFromMap( MappedFileType *mappedFile );
+
+    /*
+    Name: readDoubleFromMap
+    process: ignores leading unprintable characters,
+             captures first contiguous double value directly from mapping,
+             records first failed conversion and its position
+             (see getMapParseStatus)
+    Function input/parameters: mapped file (MappedFileType *)
+    Function output/parameters: updated mapped file (MappedFileType *)
+    Function output/returned: double value found if successful, zero otherwise
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: skipWhiteSpace, parseDoubleFromSpan
+    */
+    double readDoubleFromMap( MappedFileType *mappedFile );
+
+    /*
+    Name: readViewToDelimiterFromMap
+    process: ignores leading white space, including space character,
+             sets view to series of characters up to specified character,
+             any non printable character, or MAX_STR_LEN - 1 characters,
+             consumes the stopping character
+    Function input/parameters: mapped file (MappedFileType *), delimiter (char)
+    Function output/parameters: view into mapped data (StringViewType *)
+    Function output/returned: success of operation (bool)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    bool readViewToDelimiterFromMap( MappedFileType *mappedFile,
+                                     char delimiter, StringViewType *view );
+
+#endif  // MAPPED_INPUT_UTILITY_H
@@ -0,0 +1,689 @@
+/*
+Name index utility, function implementations
+*/
+
+// header files
+#include "Name_Index_Utility.h"
+#include <stdlib.h>
+#include <string.h>
+
+// local function prototypes, used only in this file
+
+    bool addRadixChild( RadixNodeType *node, RadixNodeType *child,
+                                                               int position );
+    bool addRadixState( RadixNodeType *node, const StateDataType *state );
+    void clearRadixTree( RadixNodeType *node );
+    int collectRadixStates( const RadixNodeType *node,
+                    const StateDataType **results, int filled, int maxResults );
+    RadixNodeType *createRadixNode( const char *label, int labelLength );
+    int findRadixChild( const RadixNodeType *node, char firstChar );
+    int getCommonLength( const char *one, int oneLength, const char *other,
+                                                             int otherLength );
+    bool insertRadixName( RadixNodeType *node, const char *name,
+                                 int nameLength, const StateDataType *state );
+    void mergeRadixChild( RadixNodeType *node );
+    void nameIndexNodeAdded( void *indexData, const StateDataType *node );
+    void nameIndexNodeRemoved( void *indexData, const StateDataType *node );
+    bool removeRadixName( RadixNodeType *node, const char *name,
+                                 int nameLength, const StateDataType *state );
+    bool splitRadixNode( RadixNodeType *node, int labelLength );
+
+/*
+Name: addRadixChild
+Process: inserts child at given position of node's sorted children,
+         growing children array as needed
+Function input/parameters: node (RadixNodeType *),
+                           child (RadixNodeType *), position (int)
+Function output/parameters: updated node (RadixNodeType *)
+Function output/returned: true if added, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: realloc, memmove
+*/
+bool addRadixChild( RadixNodeType *node, RadixNodeType *child, int position )
+   {
+    RadixNodeType **grownChildren;
+    int newCapacity;
+
+    if( node->childCount == node->childCapacity )
+       {
+        newCapacity = node->childCapacity > 0 ? node->childCapacity * 2
+                                                   : MIN_RADIX_NODE_CAPACITY;
+        grownChildren = (RadixNodeType **)realloc( node->children,
+                                      newCapacity * sizeof( RadixNodeType * ) );
+
+        if( grownChildren == NULL )
+           {
+            return false;
+           }
+
+        node->children = grownChildren;
+        node->childCapacity = newCapacity;
+       }
+
+    memmove( &node->children[ position + 1 ], &node->children[ position ],
+                ( node->childCount - position ) * sizeof( RadixNodeType * ) );
+
+    node->children[ position ] = child;
+    node->childCount++;
+
+    return true;
+   }
+
+/*
+Name: addRadixState
+Process: adds state to those whose name ends at node, after any already
+         there, growing states array as needed
+Function input/parameters: node (RadixNodeType *),
+                           state (const StateDataType *)
+Function output/parameters: updated node (RadixNodeType *)
+Function output/returned: true if added, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: realloc
+*/
+bool addRadixState( RadixNodeType *node, const StateDataType *state )
+   {
+    const StateDataType **grownStates;
+    int newCapacity;
+
+    if( node->stateCount == node->stateCapacity )
+       {
+        newCapacity = node->stateCapacity > 0 ? node->stateCapacity * 2
+                                                   : MIN_RADIX_NODE_CAPACITY;
+        grownStates = (const StateDataType **)realloc( (void *)node->states,
+                              newCapacity * sizeof( const StateDataType * ) );
+
+        if( grownStates == NULL )
+           {
+            return false;
+           }
+
+        node->states = grownStates;
+        node->stateCapacity = newCapacity;
+       }
+
+    node->states[ node->stateCount ] = state;
+    node->stateCount++;
+
+    return true;
+   }
+
+/*
+Name: clearNameIndex
+Process: detaches index from its table, releases index and its tree,
+         must be called before table is cleared
+Function input/parameters: index (NameIndexType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, clearRadixTree, free
+*/
+void clearNameIndex( NameIndexType *index )
+   {
+    removeHashIndexHook( index->hash, &index->hook );
+
+    clearRadixTree( index->root );
+
+    free( index );
+   }
+
+/*
+Name: clearRadixTree
+Process: releases node, its arrays, and all nodes below it
+Function input/parameters: node (RadixNodeType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free, clearRadixTree (recursively)
+*/
+void clearRadixTree( RadixNodeType *node )
+   {
+    int childIndex;
+
+    for( childIndex = 0; childIndex < node->childCount; childIndex++ )
+       {
+        clearRadixTree( node->children[ childIndex ] );
+       }
+
+    free( node->children );
+    free( (void *)node->states );
+    free( node );
+   }
+
+/*
+Name: collectRadixStates
+Process: fills results with states at and below node, in name order,
+         node's own states first, then each child's in order,
+         stopping once maxResults are filled
+Function input/parameters: node (const RadixNodeType *),
+                           results already filled (int),
+                           maximum results to fill (int)
+Function output/parameters: states found (const StateDataType **)
+Function output/returned: results filled (int)
+Device input/---: none
+Device output/---: none
+Dependencies: collectRadixStates (recursively)
+*/
+int collectRadixStates( const RadixNodeType *node,
+                     const StateDataType **results, int filled, int maxResults )
+   {
+    int index;
+
+    for( index = 0; index < node->stateCount && filled < maxResults; index++ )
+       {
+        results[ filled ] = node->states[ index ];
+        filled++;
+       }
+
+    for( index = 0; index < node->childCount && filled < maxResults; index++ )
+       {
+        filled = collectRadixStates( node->children[ index ], results,
+                                                         filled, maxResults );
+       }
+
+    return filled;
+   }
+
+/*
+Name: createNameIndex
+Process: builds index over names of states in use in table,
+         then attaches index to table so later adds and removes
+         keep it in sync
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, index attached
+                            (ProbingHashType *)
+Function output/returned: pointer to index,
+                          or NULL if out of memory (NameIndexType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, createRadixNode, insertRadixName, getStringLength,
+              addHashIndexHook, clearRadixTree, free
+*/
+NameIndexType *createNameIndex( ProbingHashType *hash )
+   {
+    NameIndexType *index;
+    const StateDataType *node;
+    int nodeIndex;
+
+    index = (NameIndexType *)malloc( sizeof( NameIndexType ) );
+
+    if( index == NULL )
+       {
+        return NULL;
+       }
+
+    index->root = createRadixNode( "", 0 );
+
+    if( index->root == NULL )
+       {
+        free( index );
+
+        return NULL;
+       }
+
+    index->complete = true;
+    index->hash = hash;
+
+    for( nodeIndex = 0; nodeIndex < hash->tableSize; nodeIndex++ )
+       {
+        node = &hash->array[ nodeIndex ];
+
+        if( node->inUse && !insertRadixName( index->root, node->name,
+                                       getStringLength( node->name ), node ) )
+           {
+            clearRadixTree( index->root );
+            free( index );
+
+            return NULL;
+           }
+       }
+
+    // keep in sync from here on
+    index->hook.nodeAdded = nameIndexNodeAdded;
+    index->hook.nodeRemoved = nameIndexNodeRemoved;
+    index->hook.indexData = index;
+
+    addHashIndexHook( hash, &index->hook );
+
+    return index;
+   }
+
+/*
+Name: createRadixNode
+Process: creates tree node with given label, no children or states
+Function input/parameters: label (const char *), label length (int)
+Function output/parameters: none
+Function output/returned: pointer to node,
+                          or NULL if out of memory (RadixNodeType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, memcpy
+*/
+RadixNodeType *createRadixNode( const char *label, int labelLength )
+   {
+    RadixNodeType *node = (RadixNodeType *)malloc( sizeof( RadixNodeType ) );
+
+    if( node == NULL )
+       {
+        return NULL;
+       }
+
+    memcpy( node->label, label, labelLength );
+
+    node->labelLength = labelLength;
+    node->children = NULL;
+    node->childCount = 0;
+    node->childCapacity = 0;
+    node->states = NULL;
+    node->stateCount = 0;
+    node->stateCapacity = 0;
+    node->subtreeCount = 0;
+
+    return node;
+   }
+
+/*
+Name: findNamePrefix
+Process: finds states whose names start with given prefix (pointer and
+         length, case sensitive), in name order as compareStates,
+         fills up to maxResults of them; walks prefix, then visits
+         only tree nodes holding filled results
+Function input/parameters: index (const NameIndexType *),
+                           prefix (const char *), prefix length (int),
+                           maximum results to fill (int)
+Function output/parameters: states found (const StateDataType **),
+                            may be NULL if maxResults is zero
+Function output/returned: number of states with prefix,
+                          may be more than maxResults (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findRadixChild, getCommonLength, collectRadixStates
+*/
+int findNamePrefix( const NameIndexType *index, const char *prefix,
+                  int prefixLength, const StateDataType **results,
+                                                              int maxResults )
+   {
+    const RadixNodeType *node = index->root, *child;
+    int position, commonLength;
+
+    while( prefixLength > 0 )
+       {
+        position = findRadixChild( node, prefix[ 0 ] );
+
+        if( position == node->childCount
+                    || node->children[ position ]->label[ 0 ] != prefix[ 0 ] )
+           {
+            return 0;
+           }
+
+        child = node->children[ position ];
+        commonLength = getCommonLength( child->label, child->labelLength,
+                                                      prefix, prefixLength );
+
+        // prefix ends within label, or label differs
+        if( commonLength == prefixLength )
+           {
+            node = child;
+            prefixLength = 0;
+           }
+
+        else if( commonLength < child->labelLength )
+           {
+            return 0;
+           }
+
+        else
+           {
+            node = child;
+            prefix += commonLength;
+            prefixLength -= commonLength;
+           }
+       }
+
+    if( maxResults > 0 )
+       {
+        collectRadixStates( node, results, 0, maxResults );
+       }
+
+    return node->subtreeCount;
+   }
+
+/*
+Name: findRadixChild
+Process: binary search of node's children for first child whose label
+         starts at or after given character
+Function input/parameters: node (const RadixNodeType *),
+                           first character (char)
+Function output/parameters: none
+Function output/returned: position, or child count if none (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int findRadixChild( const RadixNodeType *node, char firstChar )
+   {
+    int low = 0, high = node->childCount, middle;
+
+    while( low < high )
+       {
+        middle = low + ( high - low ) / 2;
+
+        if( node->children[ middle ]->label[ 0 ] < firstChar )
+           {
+            low = middle + 1;
+           }
+
+        else
+           {
+            high = middle;
+           }
+       }
+
+    return low;
+   }
+
+/*
+Name: getCommonLength
+Process: finds length of common start of two character runs
+Function input/parameters: one and other run (const char *),
+                           their lengths (int)
+Function output/parameters: none
+Function output/returned: common length (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int getCommonLength( const char *one, int oneLength, const char *other,
+                                                              int otherLength )
+   {
+    int index = 0;
+
+    while( index < oneLength && index < otherLength
+                                             && one[ index ] == other[ index ] )
+       {
+        index++;
+       }
+
+    return index;
+   }
+
+/*
+Name: insertRadixName
+Process: adds state under node by rest of its name (after node's label),
+         following child with same first character, splitting its label
+         where the name leaves it, or adding new leaf child
+Function input/parameters: node (RadixNodeType *),
+                           rest of name (const char *), its length (int),
+                           state (const StateDataType *)
+Function output/parameters: updated tree (RadixNodeType *)
+Function output/returned: true if added, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: addRadixState, findRadixChild, getCommonLength,
+              splitRadixNode, createRadixNode, addRadixChild, free,
+              insertRadixName (recursively)
+*/
+bool insertRadixName( RadixNodeType *node, const char *name, int nameLength,
+                                                 const StateDataType *state )
+   {
+    RadixNodeType *child;
+    int position, commonLength;
+    bool added;
+
+    // name ends here
+    if( nameLength == 0 )
+       {
+        added = addRadixState( node, state );
+       }
+
+    else
+       {
+        position = findRadixChild( node, name[ 0 ] );
+
+        // follow child sharing first character
+        if( position < node->childCount
+                        && node->children[ position ]->label[ 0 ] == name[ 0 ] )
+           {
+            child = node->children[ position ];
+            commonLength = getCommonLength( child->label, child->labelLength,
+                                                          name, nameLength );
+
+            added = ( commonLength == child->labelLength
+                                 || splitRadixNode( child, commonLength ) )
+                     && insertRadixName( child, &name[ commonLength ],
+                                          nameLength - commonLength, state );
+           }
+
+        // otherwise, new leaf for rest of name
+        else
+           {
+            child = createRadixNode( name, nameLength );
+            added = child != NULL && addRadixState( child, state );
+
+            if( added )
+               {
+                child->subtreeCount = 1;
+
+                added = addRadixChild( node, child, position );
+               }
+
+            if( !added && child != NULL )
+               {
+                free( (void *)child->states );
+                free( child );
+               }
+           }
+       }
+
+    if( added )
+       {
+        node->subtreeCount++;
+       }
+
+    return added;
+   }
+
+/*
+Name: mergeRadixChild
+Process: joins node having no states and one child with that child,
+         so every node without states has at least two children
+Function input/parameters: node (RadixNodeType *)
+Function output/parameters: updated node (RadixNodeType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: memcpy, free
+*/
+void mergeRadixChild( RadixNodeType *node )
+   {
+    RadixNodeType *child = node->children[ 0 ];
+
+    memcpy( &node->label[ node->labelLength ], child->label,
+                                                        child->labelLength );
+    node->labelLength += child->labelLength;
+
+    free( node->children );
+    free( (void *)node->states );
+
+    node->children = child->children;
+    node->childCount = child->childCount;
+    node->childCapacity = child->childCapacity;
+    node->states = child->states;
+    node->stateCount = child->stateCount;
+    node->stateCapacity = child->stateCapacity;
+
+    free( child );
+   }
+
+/*
+Name: nameIndexNodeAdded
+Process: index hook, adds node by its name; if out of memory,
+         node is left out and index is marked incomplete
+Function input/parameters: index (void *), node (const StateDataType *)
+Function output/parameters: updated index (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: insertRadixName, getStringLength
+*/
+void nameIndexNodeAdded( void *indexData, const StateDataType *node )
+   {
+    NameIndexType *index = (NameIndexType *)indexData;
+
+    if( !insertRadixName( index->root, node->name,
+                                       getStringLength( node->name ), node ) )
+       {
+        index->complete = false;
+       }
+   }
+
+/*
+Name: nameIndexNodeRemoved
+Process: index hook, removes node by its name, node data must still be
+         set; nodes left out when added are ignored
+Function input/parameters: index (void *), node (const StateDataType *)
+Function output/parameters: updated index (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeRadixName, getStringLength
+*/
+void nameIndexNodeRemoved( void *indexData, const StateDataType *node )
+   {
+    NameIndexType *index = (NameIndexType *)indexData;
+
+    removeRadixName( index->root, node->name,
+                                         getStringLength( node->name ), node );
+   }
+
+/*
+Name: removeRadixName
+Process: removes state under node by rest of its name (after node's
+         label), then releases child left with nothing below it,
+         or merges child left with no states and one child
+Function input/parameters: node (RadixNodeType *),
+                           rest of name (const char *), its length (int),
+                           state (const StateDataType *)
+Function output/parameters: updated tree (RadixNodeType *)
+Function output/returned: true if removed, false if not found (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: findRadixChild, memcmp, memmove, clearRadixTree,
+              mergeRadixChild, removeRadixName (recursively)
+*/
+bool removeRadixName( RadixNodeType *node, const char *name, int nameLength,
+                                                 const StateDataType *state )
+   {
+    RadixNodeType *child;
+    int position;
+
+    // name ends here, keep order of other states
+    if( nameLength == 0 )
+       {
+        for( position = 0; position < node->stateCount
+                             && node->states[ position ] != state; position++ );
+
+        if( position == node->stateCount )
+           {
+            return false;
+           }
+
+        memmove( (void *)&node->states[ position ],
+                 (const void *)&node->states[ position + 1 ],
+          ( node->stateCount - position - 1 ) * sizeof( const StateDataType * ) );
+
+        node->stateCount--;
+        node->subtreeCount--;
+
+        return true;
+       }
+
+    position = findRadixChild( node, name[ 0 ] );
+
+    if( position == node->childCount )
+       {
+        return false;
+       }
+
+    child = node->children[ position ];
+
+    if( child->labelLength > nameLength
+                  || memcmp( child->label, name, child->labelLength ) != 0
+                  || !removeRadixName( child, &name[ child->labelLength ],
+                                 nameLength - child->labelLength, state ) )
+       {
+        return false;
+       }
+
+    node->subtreeCount--;
+
+    // nothing left below child
+    if( child->subtreeCount == 0 )
+       {
+        clearRadixTree( child );
+
+        memmove( &node->children[ position ], &node->children[ position + 1 ],
+            ( node->childCount - position - 1 ) * sizeof( RadixNodeType * ) );
+
+        node->childCount--;
+       }
+
+    else if( child->stateCount == 0 && child->childCount == 1 )
+       {
+        mergeRadixChild( child );
+       }
+
+    return true;
+   }
+
+/*
+Name: splitRadixNode
+Process: splits node's label at given length, rest of label moves to
+         new only child, which takes node's children and states
+Function input/parameters: node (RadixNodeType *), label length kept (int)
+Function output/parameters: updated node (RadixNodeType *)
+Function output/returned: true if split, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: createRadixNode, malloc, free
+*/
+bool splitRadixNode( RadixNodeType *node, int labelLength )
+   {
+    RadixNodeType *lower, **newChildren;
+
+    lower = createRadixNode( &node->label[ labelLength ],
+                                          node->labelLength - labelLength );
+    newChildren = (RadixNodeType **)malloc( MIN_RADIX_NODE_CAPACITY
+                                                  * sizeof( RadixNodeType * ) );
+
+    if( lower == NULL || newChildren == NULL )
+       {
+        free( lower );
+        free( newChildren );
+
+        return false;
+       }
+
+    lower->children = node->children;
+    lower->childCount = node->childCount;
+    lower->childCapacity = node->childCapacity;
+    lower->states = node->states;
+    lower->stateCount = node->stateCount;
+    lower->stateCapacity = node->stateCapacity;
+    lower->subtreeCount = node->subtreeCount;
+
+    newChildren[ 0 ] = lower;
+
+    node->labelLength = labelLength;
+    node->children = newChildren;
+    node->childCount = 1;
+    node->childCapacity = MIN_RADIX_NODE_CAPACITY;
+    node->states = NULL;
+    node->stateCount = 0;
+    node->stateCapacity = 0;
+
+    return true;
+   }
@@ -0,0 +1,103 @@
+/*
+Name index utility, function prototypes
+
+Radix tree (compressed trie) over names of states in a hash table,
+kept in sync with the table through an index hook, so prefix queries
+walk the prefix once, then visit only the tree nodes holding results;
+each tree node keeps the number of states below it, so match counts
+need no walk. States must be added and removed only through table
+functions while indexed.
+*/
+
+// PreProcessor test
+#ifndef NAME_INDEX_UTILITY_H
+#define NAME_INDEX_UTILITY_H
+
+// header files
+#include "HashUtilities.h"
+
+// constants
+
+    // smallest number of children or states allocated per tree node
+    static const int MIN_RADIX_NODE_CAPACITY = 2;
+
+// data structures
+
+    // radix tree node, label is edge from parent, states are those whose
+    // name ends here, children are sorted by first label character
+    typedef struct RadixNodeStruct
+       {
+        char label[ STD_STR_LEN ];
+        int labelLength;
+        struct RadixNodeStruct **children;
+        int childCount;
+        int childCapacity;
+        const StateDataType **states;
+        int stateCount;
+        int stateCapacity;
+        int subtreeCount;
+       } RadixNodeType;
+
+    // radix tree over table names, attached to table by hook
+    typedef struct NameIndexStruct
+       {
+        RadixNodeType *root;
+        bool complete;
+        ProbingHashType *hash;
+        HashIndexHookType hook;
+       } NameIndexType;
+
+// function prototypes
+
+/*
+Name: clearNameIndex
+Process: detaches index from its table, releases index and its tree,
+         must be called before table is cleared
+Function input/parameters: index (NameIndexType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, clearRadixTree, free
+*/
+void clearNameIndex( NameIndexType *index );
+
+/*
+Name: createNameIndex
+Process: builds index over names of states in use in table,
+         then attaches index to table so later adds and removes
+         keep it in sync
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, index attached
+                            (ProbingHashType *)
+Function output/returned: pointer to index,
+                          or NULL if out of memory (NameIndexType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, createRadixNode, insertRadixName, getStringLength,
+              addHashIndexHook, clearRadixTree, free
+*/
+NameIndexType *createNameIndex( ProbingHashType *hash );
+
+/*
+Name: findNamePrefix
+Process: finds states whose names start with given prefix (pointer and
+         length, case sensitive), in name order as compareStates,
+         fills up to maxResults of them; walks prefix, then visits
+         only tree nodes holding filled results
+Function input/parameters: index (const NameIndexType *),
+                           prefix (const char *), prefix length (int),
+                           maximum results to fill (int)
+Function output/parameters: states found (const StateDataType **),
+                            may be NULL if maxResults is zero
+Function output/returned: number of states with prefix,
+                          may be more than maxResults (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findRadixChild, getCommonLength, collectRadixStates
+*/
+int findNamePrefix( const NameIndexType *index, const char *prefix,
+                 int prefixLength, const StateDataType **results,
+                                                             int maxResults );
+
+#endif  // NAME_INDEX_UTILITY_H
@@ -0,0 +1,256 @@
+/*
+Number parse utility, function implementations
+*/
+
+// header files
+#include "Number_Parse_Utility.h"
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// local global constants, used only in this file
+
+    // largest mantissa held exactly by a double, 2^53
+    const uint64_t MAX_EXACT_MANTISSA = 9007199254740992ULL;
+
+    // most significant digits accumulated in 64 bits
+    const int MAX_MANTISSA_DIGITS = 19;
+
+    // largest power of ten held exactly by a double
+    const int MAX_EXACT_POWER = 22;
+
+    // exponent clamp, well past double range
+    const int MAX_EXPONENT_MAGNITUDE = 100000;
+
+    // exact powers of ten, 10^0 through 10^22
+    const double EXACT_POWERS_OF_TEN[] = 
+       {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+       };
+
+    /*
+    Name: getParseStatusString
+    process: provides display text for given parse status
+    Function input/parameters: parse status (ParseStatusType)
+    Function output/parameters: none
+    Function output/returned: status description (const char *)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    const char *getParseStatusString( ParseStatusType status )
+       {
+        switch( status )
+           {
+            case PARSE_SUCCESS:
+               return "success";
+
+            case PARSE_END_OF_DATA:
+               return "end of data";
+
+            case PARSE_NO_DIGITS:
+               return "no digits in number";
+
+            case PARSE_BAD_EXPONENT:
+               return "exponent has no digits";
+
+            case PARSE_TOO_LONG:
+               return "number too long";
+
+            case PARSE_OUT_OF_RANGE:
+               return "number out of range";
+           }
+
+        return "unknown parse status";
+       }
+
+    /*
+    Name: parseDoubleFromSpan
+    process: converts number at start of span, format is
+             optional sign, digits with optional decimal point
+             (at least one digit), optional exponent (e or E, 
+             optional sign, digits); no leading white space is skipped
+    Function input/parameters: span start and end (const char *)
+    Function output/parameters: value found, zero on failure (double *),
+                                pointer past last character used,
+                                span start on failure (const char **)
+    Function output/returned: status of conversion (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: strtod, localeconv (fallback only)
+    */
+    ParseStatusType parseDoubleFromSpan( const char *start, const char *end,
+                                        double *value, const char **stopPtr )
+       {
+        // initialize variables
+        const char *current = start;
+        uint64_t mantissa = 0;
+        int significantDigits = 0, digitCount = 0;
+        int exponent = 0, exponentValue = 0;
+        bool negative = false, negativeExponent = false, truncated = false;
+        char numberStr[ HUGE_STR_LEN ];
+        char decimalPoint = PERIOD;
+        char *convertEndPtr;
+        int index;
+        double result;
+
+        // set failure outputs
+        *value = 0.0;
+        *stopPtr = start;
+
+        // check for empty span
+        if( current >= end )
+           {
+            return PARSE_END_OF_DATA;
+           }
+
+        // optional sign
+        if( *current == DASH || *current == '+' )
+           {
+            negative = *current == DASH;
+            current++;
+           }
+
+        // integer digits, keep first 19 significant, scale for the rest
+        while( current < end && *current >= '0' && *current <= '9' )
+           {
+            if( significantDigits < MAX_MANTISSA_DIGITS )
+               {
+                mantissa = mantissa * 10 + (uint64_t)( *current - '0' );
+
+                if( mantissa != 0 )
+                   {
+                    significantDigits++;
+                   }
+               }
+
+            else
+               {
+                exponent++;
+                truncated = truncated || *current != '0';
+               }
+
+            digitCount++;
+            current++;
+           }
+
+        // fraction digits, each kept digit moves decimal exponent down
+        if( current < end && *current == PERIOD )
+           {
+            current++;
+
+            while( current < end && *current >= '0' && *current <= '9' )
+               {
+                if( significantDigits < MAX_MANTISSA_DIGITS )
+                   {
+                    mantissa = mantissa * 10 + (uint64_t)( *current - '0' );
+                    exponent--;
+
+                    if( mantissa != 0 )
+                       {
+                        significantDigits++;
+                       }
+                   }
+
+                else
+                   {
+                    truncated = truncated || *current != '0';
+                   }
+
+                digitCount++;
+                current++;
+               }
+           }
+
+        // check for at least one digit
+        if( digitCount == 0 )
+           {
+            return PARSE_NO_DIGITS;
+           }
+
+        // optional exponent, must have digits
+        if( current < end && ( *current == 'e' || *current == 'E' ) )
+           {
+            current++;
+
+            if( current < end && ( *current == DASH || *current == '+' ) )
+               {
+                negativeExponent = *current == DASH;
+                current++;
+               }
+
+            if( current >= end || *current < '0' || *current > '9' )
+               {
+                return PARSE_BAD_EXPONENT;
+               }
+
+            while( current < end && *current >= '0' && *current <= '9' )
+               {
+                if( exponentValue < MAX_EXPONENT_MAGNITUDE )
+                   {
+                    exponentValue = exponentValue * 10 + ( *current - '0' );
+                   }
+
+                current++;
+               }
+
+            exponent += negativeExponent ? -exponentValue : exponentValue;
+           }
+
+        // fast path, both operands exact so one rounding gives exact result
+        if( !truncated && mantissa <= MAX_EXACT_MANTISSA
+                 && exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER )
+           {
+            result = (double)mantissa;
+
+            if( exponent < 0 )
+               {
+                result /= EXACT_POWERS_OF_TEN[ -exponent ];
+               }
+
+            else
+               {
+                result *= EXACT_POWERS_OF_TEN[ exponent ];
+               }
+
+            *value = negative ? -result : result;
+            *stopPtr = current;
+
+            return PARSE_SUCCESS;
+           }
+
+        // fallback, bounded copy for strtod in current locale
+        if( current - start >= HUGE_STR_LEN )
+           {
+            return PARSE_TOO_LONG;
+           }
+
+           // function: localeconv
+        decimalPoint = localeconv()->decimal_point[ 0 ];
+
+        for( index = 0; start + index < current; index++ )
+           {
+            numberStr[ index ] = start[ index ] == PERIOD ? 
+                                                decimalPoint : start[ index ];
+           }
+
+        numberStr[ index ] = NULL_CHAR;
+
+           // function: strtod
+        errno = 0;
+        result = strtod( numberStr, &convertEndPtr );
+
+        // check for overflow, underflow to zero is accepted
+        if( errno == ERANGE && isinf( result ) )
+           {
+            return PARSE_OUT_OF_RANGE;
+           }
+
+        *value = result;
+        *stopPtr = current;
+
+        return PARSE_SUCCESS;
+       }
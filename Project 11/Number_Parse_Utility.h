@@ -0,0 +1,60 @@
+/*
+Number parse utility, function prototypes
+
+Locale independent conversion of decimal text held in memory
+(pointer and end, not NULL_CHAR terminated) to double.
+Values with at most 19 significant digits and a small decimal exponent,
+which covers every temperature field in the input files, are converted
+exactly with a single correctly rounded multiply or divide (Clinger);
+anything else falls back to strtod on a bounded copy
+with the locale decimal point substituted.
+*/
+
+// PreProcessor test
+#ifndef NUMBER_PARSE_UTILITY_H
+#define NUMBER_PARSE_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include "StandardConstants.h"
+
+// data structures
+
+    // result of a number conversion
+    typedef enum { PARSE_SUCCESS, PARSE_END_OF_DATA, PARSE_NO_DIGITS,
+                   PARSE_BAD_EXPONENT, PARSE_TOO_LONG,
+                                          PARSE_OUT_OF_RANGE } ParseStatusType;
+
+// function prototypes
+
+    /*
+    Name: getParseStatusString
+    process: provides display text for given parse status
+    Function input/parameters: parse status (ParseStatusType)
+    Function output/parameters: none
+    Function output/returned: status description (const char *)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: none
+    */
+    const char *getParseStatusString( ParseStatusType status );
+
+    /*
+    Name: parseDoubleFromSpan
+    process: converts number at start of span, format is
+             optional sign, digits with optional decimal point
+             (at least one digit), optional exponent (e or E, 
+             optional sign, digits); no leading white space is skipped
+    Function input/parameters: span start and end (const char *)
+    Function output/parameters: value found, zero on failure (double *),
+                                pointer past last character used,
+                                span start on failure (const char **)
+    Function output/returned: status of conversion (ParseStatusType)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: strtod, localeconv (fallback only)
+    */
+    ParseStatusType parseDoubleFromSpan( const char *start, const char *end,
+                                       double *value, const char **stopPtr );
+
+#endif  // NUMBER_PARSE_UTILITY_H
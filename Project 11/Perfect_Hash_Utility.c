@@ -0,0 +1,502 @@
+/*
+Perfect hash utility, function implementations
+*/
+
+// header files
+#include "Perfect_Hash_Utility.h"
+#include <stdlib.h>
+#include <string.h>
+
+// local data structures, used only in this file
+
+    // key being frozen, node points into source table
+    typedef struct FrozenKeyStruct
+       {
+        const StateDataType *node;
+        int nodeIndex;
+        int nameLength;
+        uint64_t hash;
+       } FrozenKeyType;
+
+// local function prototypes, used only in this file
+
+    int compareFrozenKeys( const void *onePtr, const void *otherPtr );
+    int getFrozenSlot( uint64_t hash, int slotCount, 
+                                                  uint32_t first, uint32_t second );
+    bool placeFrozenBuckets( FrozenHashType *frozen, FrozenKeyType *keys, 
+                                                               int *slotOfKey );
+
+/*
+Name: clearFrozenHashTable
+Process: releases frozen table and its arrays
+Function input/parameters: frozen table (FrozenHashType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearFrozenHashTable( FrozenHashType *frozen )
+   {
+    if( frozen != NULL )
+       {
+        free( frozen->array );
+        free( frozen->displacements );
+        free( frozen );
+       }
+   }
+
+/*
+Name: compareFrozenKeys
+Process: orders keys by hash, then name, then table index, for qsort
+Function input/parameters: pointers to keys (const void *)
+Function output/parameters: none
+Function output/returned: negative, zero, or positive as first key
+                          sorts before, with, or after second (int)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp
+*/
+int compareFrozenKeys( const void *onePtr, const void *otherPtr )
+   {
+    const FrozenKeyType *one = (const FrozenKeyType *)onePtr;
+    const FrozenKeyType *other = (const FrozenKeyType *)otherPtr;
+    int nameResult;
+
+    if( one->hash != other->hash )
+       {
+        return one->hash < other->hash ? -1 : 1;
+       }
+
+    nameResult = strcmp( one->node->name, other->node->name );
+
+    return nameResult != 0 ? nameResult : one->nodeIndex - other->nodeIndex;
+   }
+
+/*
+Name: findFrozenItem
+Process: finds state by name in frozen table
+Function input/parameters: frozen table (const FrozenHashType *),
+                           state name (const char *)
+Function output/parameters: none
+Function output/returned: pointer to state in frozen table, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength, findFrozenItemFromView
+*/
+const StateDataType *findFrozenItem( const FrozenHashType *frozen, 
+                                                       const char *stateName )
+   {
+    return findFrozenItemFromView( frozen, stateName, 
+                                              getStringLength( stateName ) );
+   }
+
+/*
+Name: findFrozenItemFromView
+Process: finds state by name given as pointer and length in frozen table,
+         names longer than STD_STR_LEN - 1 are truncated 
+         as they would be in the table
+Function input/parameters: frozen table (const FrozenHashType *),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: pointer to state in frozen table, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: getFrozenNameHash, getFrozenSlot, memcmp
+*/
+const StateDataType *findFrozenItemFromView( const FrozenHashType *frozen, 
+                                             const char *name, int nameLength )
+   {
+    uint64_t hash;
+    int bucket;
+    const StateDataType *node;
+
+    if( frozen->slotCount == 0 )
+       {
+        return NULL;
+       }
+
+    if( nameLength > STD_STR_LEN - 1 )
+       {
+        nameLength = STD_STR_LEN - 1;
+       }
+
+    // one hash, one slot, one name check
+    hash = getFrozenNameHash( name, nameLength, frozen->seed );
+    bucket = (int)( hash % (uint64_t)frozen->bucketCount );
+    node = &frozen->array[ getFrozenSlot( hash, frozen->slotCount,
+                                   frozen->displacements[ 2 * bucket ],
+                                   frozen->displacements[ 2 * bucket + 1 ] ) ];
+
+    if( node->name[ nameLength ] == NULL_CHAR 
+                             && memcmp( node->name, name, nameLength ) == 0 )
+       {
+        return node;
+       }
+
+    return NULL;
+   }
+
+/*
+Name: freezeHashTable
+Process: builds minimal perfect hash table over states in use in given
+         table, states are copied, so given table may be changed or
+         cleared afterward; where a name is in table more than once,
+         keeps the state findItem would return
+Function input/parameters: hash table (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: pointer to frozen table, or NULL if no
+                          perfect hash was found (FrozenHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, getFrozenNameHash, qsort, findItemIndex,
+              placeFrozenBuckets, free
+*/
+FrozenHashType *freezeHashTable( const ProbingHashType *hash )
+   {
+    FrozenHashType *frozen = (FrozenHashType *)malloc( sizeof( FrozenHashType ) );
+    ProbingHashType quietHash = *hash;
+    FrozenKeyType *keys;
+    int *slotOfKey;
+    int index, keyCount = 0, distinctCount = 0, attempt;
+    bool placed = false;
+
+    frozen->array = NULL;
+    frozen->displacements = NULL;
+    frozen->slotCount = 0;
+    frozen->bucketCount = 0;
+    frozen->seed = 0;
+
+    // gather keys in use
+    keys = (FrozenKeyType *)malloc( ( hash->tableSize + 1 ) 
+                                                    * sizeof( FrozenKeyType ) );
+
+    for( index = 0; index < hash->tableSize; index++ )
+       {
+        if( hash->array[ index ].inUse )
+           {
+            keys[ keyCount ].node = &hash->array[ index ];
+            keys[ keyCount ].nodeIndex = index;
+            keys[ keyCount ].nameLength = getStringLength( 
+                                                    hash->array[ index ].name );
+            keys[ keyCount ].hash = getFrozenNameHash( 
+                                hash->array[ index ].name, 
+                                           keys[ keyCount ].nameLength, 0 );
+            keyCount++;
+           }
+       }
+
+    // one state per name, the one the table finds
+    qsort( keys, keyCount, sizeof( FrozenKeyType ), compareFrozenKeys );
+
+    setHashTableVerbose( &quietHash, false );
+
+    for( index = 0; index < keyCount; index++ )
+       {
+        if( distinctCount > 0 && keys[ index ].hash 
+                                          == keys[ distinctCount - 1 ].hash
+             && strcmp( keys[ index ].node->name, 
+                               keys[ distinctCount - 1 ].node->name ) == 0 )
+           {
+            if( findItemIndex( &quietHash, *keys[ index ].node ) 
+                                                    == keys[ index ].nodeIndex )
+               {
+                keys[ distinctCount - 1 ] = keys[ index ];
+               }
+           }
+
+        else
+           {
+            keys[ distinctCount ] = keys[ index ];
+            distinctCount++;
+           }
+       }
+
+    frozen->slotCount = distinctCount;
+    frozen->bucketCount = ( distinctCount + FROZEN_KEYS_PER_BUCKET - 1 ) 
+                                                     / FROZEN_KEYS_PER_BUCKET;
+    slotOfKey = (int *)malloc( ( distinctCount + 1 ) * sizeof( int ) );
+    frozen->displacements = (uint32_t *)calloc( 2 * frozen->bucketCount + 2, 
+                                                          sizeof( uint32_t ) );
+
+    // new seed whenever some bucket cannot be placed
+    for( attempt = 0; attempt < FROZEN_SEED_ATTEMPTS && !placed 
+                                               && distinctCount > 0; attempt++ )
+       {
+        frozen->seed = 0x9E3779B97F4A7C15ULL * ( attempt + 1 );
+
+        for( index = 0; index < distinctCount; index++ )
+           {
+            keys[ index ].hash = getFrozenNameHash( keys[ index ].node->name, 
+                                   keys[ index ].nameLength, frozen->seed );
+           }
+
+        placed = placeFrozenBuckets( frozen, keys, slotOfKey );
+       }
+
+    // copy states into their slots
+    if( placed || distinctCount == 0 )
+       {
+        frozen->array = (StateDataType *)malloc( 
+                              ( distinctCount + 1 ) * sizeof( StateDataType ) );
+
+        for( index = 0; index < distinctCount; index++ )
+           {
+            frozen->array[ slotOfKey[ index ] ] = *keys[ index ].node;
+           }
+       }
+
+    else
+       {
+        clearFrozenHashTable( frozen );
+        frozen = NULL;
+       }
+
+    free( slotOfKey );
+    free( keys );
+
+    return frozen;
+   }
+
+/*
+Name: getFrozenNameHash
+Process: seeded 64 bit hash of name (FNV-1a with splitmix64 finish)
+Function input/parameters: name (const char *), name length (int),
+                           seed (uint64_t)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+uint64_t getFrozenNameHash( const char *name, int nameLength, uint64_t seed )
+   {
+    uint64_t hash = 0xCBF29CE484222325ULL ^ seed;
+    int index;
+
+    for( index = 0; index < nameLength; index++ )
+       {
+        hash = ( hash ^ (unsigned char)name[ index ] ) * 0x100000001B3ULL;
+       }
+
+    hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return hash ^ ( hash >> 31 );
+   }
+
+/*
+Name: getFrozenSlot
+Process: finds slot of key from its hash and its bucket's displacement 
+         pair: ( f1 + first * f2 + second ) mod slot count,
+         f1 and f2 taken from high bits of hash
+Function input/parameters: key hash (uint64_t), slot count (int),
+                           displacement pair (uint32_t)
+Function output/parameters: none
+Function output/returned: slot index (int)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+int getFrozenSlot( uint64_t hash, int slotCount, 
+                                               uint32_t first, uint32_t second )
+   {
+    uint64_t offset = ( hash >> 32 ) % (uint64_t)slotCount;
+    uint64_t step = ( ( hash * 0x9E3779B97F4A7C15ULL ) >> 32 ) 
+                                                      % (uint64_t)slotCount;
+
+    return (int)( ( offset + first * step + second ) % (uint64_t)slotCount );
+   }
+
+/*
+Name: placeFrozenBuckets
+Process: groups keys into buckets by hash, then places buckets largest
+         first, trying displacement pairs in order until every key of
+         bucket lands in a distinct free slot (each second displacement
+         moves every key one slot on, so slots are only divided out once
+         per first displacement), single key buckets take remaining 
+         free slots directly
+Function input/parameters: frozen table with seed, slot and bucket counts 
+                           set (FrozenHashType *), 
+                           keys with hashes for seed (FrozenKeyType *)
+Function output/parameters: displacements set (FrozenHashType *),
+                            slot of each key (int *)
+Function output/returned: false if some bucket could not be placed (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: calloc, malloc, getFrozenSlot, free
+*/
+bool placeFrozenBuckets( FrozenHashType *frozen, FrozenKeyType *keys, 
+                                                                int *slotOfKey )
+   {
+    int slotCount = frozen->slotCount, bucketCount = frozen->bucketCount;
+    int *bucketStarts = (int *)calloc( bucketCount + 2, sizeof( int ) );
+    int *bucketKeys = (int *)malloc( slotCount * sizeof( int ) );
+    int *sizeStarts, *bucketOrder;
+    bool *slotTaken = (bool *)calloc( slotCount, sizeof( bool ) );
+    int index, orderIndex, bucket, bucketSize, maxBucketSize = 0;
+    int member, other, slot, freeSlot = 0;
+    long long attempt, maxAttempts = (long long)slotCount * slotCount;
+    uint32_t first, second;
+    bool distinct, fits, success = true;
+
+    if( maxAttempts > FROZEN_DISPLACEMENT_ATTEMPTS )
+       {
+        maxAttempts = FROZEN_DISPLACEMENT_ATTEMPTS;
+       }
+
+    // counting sort keys by bucket
+    for( index = 0; index < slotCount; index++ )
+       {
+        bucketStarts[ keys[ index ].hash % bucketCount + 1 ]++;
+       }
+
+    for( bucket = 0; bucket < bucketCount; bucket++ )
+       {
+        if( bucketStarts[ bucket + 1 ] > maxBucketSize )
+           {
+            maxBucketSize = bucketStarts[ bucket + 1 ];
+           }
+
+        bucketStarts[ bucket + 1 ] += bucketStarts[ bucket ];
+       }
+
+    // bucket starts used as fill cursors, then shifted back
+    for( index = 0; index < slotCount; index++ )
+       {
+        bucket = (int)( keys[ index ].hash % bucketCount );
+
+        bucketKeys[ bucketStarts[ bucket ] ] = index;
+        bucketStarts[ bucket ]++;
+       }
+
+    for( bucket = bucketCount; bucket > 0; bucket-- )
+       {
+        bucketStarts[ bucket ] = bucketStarts[ bucket - 1 ];
+       }
+
+    bucketStarts[ 0 ] = 0;
+
+    // counting sort buckets by size, largest first
+    sizeStarts = (int *)calloc( maxBucketSize + 2, sizeof( int ) );
+    bucketOrder = (int *)malloc( ( bucketCount + 1 ) * sizeof( int ) );
+
+    for( bucket = 0; bucket < bucketCount; bucket++ )
+       {
+        bucketSize = bucketStarts[ bucket + 1 ] - bucketStarts[ bucket ];
+        sizeStarts[ maxBucketSize - bucketSize + 1 ]++;
+       }
+
+    for( index = 0; index < maxBucketSize + 1; index++ )
+       {
+        sizeStarts[ index + 1 ] += sizeStarts[ index ];
+       }
+
+    for( bucket = 0; bucket < bucketCount; bucket++ )
+       {
+        bucketSize = bucketStarts[ bucket + 1 ] - bucketStarts[ bucket ];
+        bucketOrder[ sizeStarts[ maxBucketSize - bucketSize ] ] = bucket;
+        sizeStarts[ maxBucketSize - bucketSize ]++;
+       }
+
+    // place buckets
+    for( orderIndex = 0; orderIndex < bucketCount && success; orderIndex++ )
+       {
+        bucket = bucketOrder[ orderIndex ];
+        bucketSize = bucketStarts[ bucket + 1 ] - bucketStarts[ bucket ];
+        frozen->displacements[ 2 * bucket ] = 0;
+        frozen->displacements[ 2 * bucket + 1 ] = 0;
+
+        // single key takes next free slot
+        if( bucketSize == 1 )
+           {
+            while( slotTaken[ freeSlot ] )
+               {
+                freeSlot++;
+               }
+
+            member = bucketKeys[ bucketStarts[ bucket ] ];
+            second = (uint32_t)( ( freeSlot - getFrozenSlot( 
+                                  keys[ member ].hash, slotCount, 0, 0 ) 
+                                                + slotCount ) % slotCount );
+
+            frozen->displacements[ 2 * bucket + 1 ] = second;
+            slotOfKey[ member ] = freeSlot;
+            slotTaken[ freeSlot ] = true;
+           }
+
+        else if( bucketSize > 1 )
+           {
+            fits = false;
+            attempt = 0;
+
+            // pairs repeat after slot count squared
+            for( first = 0; !fits && attempt < maxAttempts; first++ )
+               {
+                // base slots for this first displacement must differ
+                distinct = true;
+
+                for( index = bucketStarts[ bucket ]; 
+                       index < bucketStarts[ bucket + 1 ] && distinct; index++ )
+                   {
+                    member = bucketKeys[ index ];
+                    slotOfKey[ member ] = getFrozenSlot( keys[ member ].hash, 
+                                                       slotCount, first, 0 );
+
+                    for( other = bucketStarts[ bucket ]; 
+                                          other < index && distinct; other++ )
+                       {
+                        distinct = slotOfKey[ bucketKeys[ other ] ] 
+                                                        != slotOfKey[ member ];
+                       }
+                   }
+
+                // second displacement shifts every base slot by one
+                for( second = 0; distinct && !fits && second < (uint32_t)slotCount
+                                  && attempt < maxAttempts; second++, attempt++ )
+                   {
+                    fits = true;
+
+                    for( index = bucketStarts[ bucket ]; 
+                           index < bucketStarts[ bucket + 1 ] && fits; index++ )
+                       {
+                        slot = slotOfKey[ bucketKeys[ index ] ] + (int)second;
+                        slot = slot >= slotCount ? slot - slotCount : slot;
+
+                        fits = !slotTaken[ slot ];
+                       }
+
+                    if( fits )
+                       {
+                        frozen->displacements[ 2 * bucket ] = first;
+                        frozen->displacements[ 2 * bucket + 1 ] = second;
+                       }
+                   }
+
+                attempt += distinct ? 0 : slotCount;
+               }
+
+            // take slots
+            for( index = bucketStarts[ bucket ]; 
+                             index < bucketStarts[ bucket + 1 ] && fits; index++ )
+               {
+                member = bucketKeys[ index ];
+                slotOfKey[ member ] = getFrozenSlot( keys[ member ].hash, 
+                                      slotCount, first - 1, second - 1 );
+                slotTaken[ slotOfKey[ member ] ] = true;
+               }
+
+            success = fits;
+           }
+       }
+
+    free( bucketOrder );
+    free( sizeStarts );
+    free( slotTaken );
+    free( bucketKeys );
+    free( bucketStarts );
+
+    return success;
+   }
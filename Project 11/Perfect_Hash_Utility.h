@@ -0,0 +1,116 @@
+/*
+Perfect hash utility, function prototypes
+
+Freezes the keys of a hash table into an immutable minimal perfect hash
+table (CHD: hash, bucket, and displace), one slot per distinct key,
+so every lookup is one hash, one slot access, and one name check.
+*/
+
+// PreProcessor test
+#ifndef PERFECT_HASH_UTILITY_H
+#define PERFECT_HASH_UTILITY_H
+
+// header files
+#include <stdint.h>
+#include "HashUtilities.h"
+
+// constants
+
+    // average keys per displacement bucket
+    static const int FROZEN_KEYS_PER_BUCKET = 4;
+
+    // seeds tried before freezing gives up
+    static const int FROZEN_SEED_ATTEMPTS = 32;
+
+    // displacements tried per bucket before trying next seed
+    static const long long FROZEN_DISPLACEMENT_ATTEMPTS = 16777216;
+
+// data structures
+
+    // immutable minimal perfect hash table
+    typedef struct FrozenHashStruct
+       {
+        StateDataType *array;
+        int slotCount;
+        int bucketCount;
+        uint32_t *displacements;
+        uint64_t seed;
+       } FrozenHashType;
+
+// function prototypes
+
+/*
+Name: clearFrozenHashTable
+Process: releases frozen table and its arrays
+Function input/parameters: frozen table (FrozenHashType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: free
+*/
+void clearFrozenHashTable( FrozenHashType *frozen );
+
+/*
+Name: findFrozenItem
+Process: finds state by name in frozen table
+Function input/parameters: frozen table (const FrozenHashType *),
+                           state name (const char *)
+Function output/parameters: none
+Function output/returned: pointer to state in frozen table, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength, findFrozenItemFromView
+*/
+const StateDataType *findFrozenItem( const FrozenHashType *frozen, 
+                                                      const char *stateName );
+
+/*
+Name: findFrozenItemFromView
+Process: finds state by name given as pointer and length in frozen table,
+         names longer than STD_STR_LEN - 1 are truncated 
+         as they would be in the table
+Function input/parameters: frozen table (const FrozenHashType *),
+                           name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: pointer to state in frozen table, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: getFrozenSlot, memcmp
+*/
+const StateDataType *findFrozenItemFromView( const FrozenHashType *frozen, 
+                                            const char *name, int nameLength );
+
+/*
+Name: freezeHashTable
+Process: builds minimal perfect hash table over states in use in given
+         table, states are copied, so given table may be changed or
+         cleared afterward; where a name is in table more than once,
+         keeps the state findItem would return
+Function input/parameters: hash table (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: pointer to frozen table, or NULL if no
+                          perfect hash was found (FrozenHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, getFrozenNameHash, qsort, findItemIndex,
+              placeFrozenBuckets, free
+*/
+FrozenHashType *freezeHashTable( const ProbingHashType *hash );
+
+/*
+Name: getFrozenNameHash
+Process: seeded 64 bit hash of name (FNV-1a with splitmix64 finish)
+Function input/parameters: name (const char *), name length (int),
+                           seed (uint64_t)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+uint64_t getFrozenNameHash( const char *name, int nameLength, uint64_t seed );
+
+#endif  // PERFECT_HASH_UTILITY_H
@@ -0,0 +1,249 @@
+/*
+Structural character scan utility, function implementations
+*/
+
+// header files
+#include "Scan_Utility.h"
+
+// vector width selection, bit scan needs GCC/Clang builtins
+#if defined( __AVX2__ ) && defined( __GNUC__ )
+#include <immintrin.h>
+#define SCAN_USE_AVX2
+#elif defined( __SSE2__ ) && defined( __GNUC__ )
+#include <emmintrin.h>
+#define SCAN_USE_SSE2
+#endif
+
+    /*
+    Name: findDelimiterOrControl
+    process: finds first character in range that is the given delimiter
+             or a non printable (control) character, such as CR or LF
+    Function input/parameters: range start and end (const char *),
+                               delimiter (char)
+    Function output/parameters: none
+    Function output/returned: pointer to character found, end if none
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    const char *findDelimiterOrControl( const char *start, const char *end,
+                                                               char delimiter )
+       {
+        // initialize variables
+        const char *current = start;
+
+#if defined( SCAN_USE_AVX2 )
+        const __m256i delimiters = _mm256_set1_epi8( delimiter );
+        const __m256i controlLimit = _mm256_set1_epi8( SPACE - 1 );
+        __m256i block, hits;
+        unsigned int mask;
+
+        // 32 bytes at a time, control is unsigned byte <= SPACE - 1
+        while( end - current >= 32 )
+           {
+            block = _mm256_loadu_si256( (const __m256i *)current );
+            hits = _mm256_or_si256( _mm256_cmpeq_epi8( block, delimiters ),
+                    _mm256_cmpeq_epi8( _mm256_max_epu8( block, controlLimit ),
+                                                              controlLimit ) );
+            mask = (unsigned int)_mm256_movemask_epi8( hits );
+
+            if( mask != 0 )
+               {
+                return current + __builtin_ctz( mask );
+               }
+
+            current += 32;
+           }
+#elif defined( SCAN_USE_SSE2 )
+        const __m128i delimiters = _mm_set1_epi8( delimiter );
+        const __m128i controlLimit = _mm_set1_epi8( SPACE - 1 );
+        __m128i block, hits;
+        unsigned int mask;
+
+        // 16 bytes at a time, control is unsigned byte <= SPACE - 1
+        while( end - current >= 16 )
+           {
+            block = _mm_loadu_si128( (const __m128i *)current );
+            hits = _mm_or_si128( _mm_cmpeq_epi8( block, delimiters ),
+                          _mm_cmpeq_epi8( _mm_max_epu8( block, controlLimit ),
+                                                              controlLimit ) );
+            mask = (unsigned int)_mm_movemask_epi8( hits );
+
+            if( mask != 0 )
+               {
+                return current + __builtin_ctz( mask );
+               }
+
+            current += 16;
+           }
+#endif
+
+        // remaining characters, one at a time
+        while( current < end && *current != delimiter 
+                                   && (unsigned char)*current >= (unsigned)SPACE )
+           {
+            current++;
+           }
+
+        return current;
+       }
+
+    /*
+    Name: scanFieldBoundaries
+    process: records position of every delimiter and NEWLINE_CHAR
+             in range, in order, stopping when boundary list is full
+    Function input/parameters: range start and end (const char *),
+                               delimiter (char), list capacity (int)
+    Function output/parameters: boundary positions (const char **)
+    Function output/returned: number of boundaries recorded (int)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    int scanFieldBoundaries( const char *start, const char *end, 
+                             char delimiter, const char **boundaries,
+                                                            int maxBoundaries )
+       {
+        // initialize variables
+        const char *current = start;
+        int count = 0;
+
+#if defined( SCAN_USE_AVX2 )
+        const __m256i delimiters = _mm256_set1_epi8( delimiter );
+        const __m256i newlines = _mm256_set1_epi8( NEWLINE_CHAR );
+        __m256i block;
+        unsigned int mask;
+
+        // whole blocks while every hit is sure to fit
+        while( end - current >= 32 && maxBoundaries - count >= 32 )
+           {
+            block = _mm256_loadu_si256( (const __m256i *)current );
+            mask = (unsigned int)_mm256_movemask_epi8( _mm256_or_si256( 
+                                      _mm256_cmpeq_epi8( block, delimiters ),
+                                      _mm256_cmpeq_epi8( block, newlines ) ) );
+
+            // emit each set bit, lowest first
+            while( mask != 0 )
+               {
+                boundaries[ count ] = current + __builtin_ctz( mask );
+                count++;
+                mask &= mask - 1;
+               }
+
+            current += 32;
+           }
+#elif defined( SCAN_USE_SSE2 )
+        const __m128i delimiters = _mm_set1_epi8( delimiter );
+        const __m128i newlines = _mm_set1_epi8( NEWLINE_CHAR );
+        __m128i block;
+        unsigned int mask;
+
+        // whole blocks while every hit is sure to fit
+        while( end - current >= 16 && maxBoundaries - count >= 16 )
+           {
+            block = _mm_loadu_si128( (const __m128i *)current );
+            mask = (unsigned int)_mm_movemask_epi8( _mm_or_si128( 
+                                           _mm_cmpeq_epi8( block, delimiters ),
+                                           _mm_cmpeq_epi8( block, newlines ) ) );
+
+            // emit each set bit, lowest first
+            while( mask != 0 )
+               {
+                boundaries[ count ] = current + __builtin_ctz( mask );
+                count++;
+                mask &= mask - 1;
+               }
+
+            current += 16;
+           }
+#endif
+
+        // remaining characters, one at a time
+        while( current < end && count < maxBoundaries )
+           {
+            if( *current == delimiter || *current == NEWLINE_CHAR )
+               {
+                boundaries[ count ] = current;
+                count++;
+               }
+
+            current++;
+           }
+
+        return count;
+       }
+
+    /*
+    Name: skipWhiteSpace
+    process: skips non printable characters, and space if flag set
+    Function input/parameters: range start and end (const char *),
+                               skip space flag (bool)
+    Function output/parameters: none
+    Function output/returned: pointer to first character not skipped,
+                              end if none
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    const char *skipWhiteSpace( const char *start, const char *end,
+                                                               bool skipSpace )
+       {
+        // initialize variables
+        const char *current = start;
+        unsigned char limit = skipSpace ? SPACE : SPACE - 1;
+
+        // quick exit, fields usually start right away
+        if( current < end && (unsigned char)*current > limit )
+           {
+            return current;
+           }
+
+#if defined( SCAN_USE_AVX2 )
+        const __m256i limits = _mm256_set1_epi8( (char)limit );
+        __m256i block;
+        unsigned int mask;
+
+        // 32 bytes at a time, find first unsigned byte above limit
+        while( end - current >= 32 )
+           {
+            block = _mm256_loadu_si256( (const __m256i *)current );
+            mask = ~(unsigned int)_mm256_movemask_epi8( _mm256_cmpeq_epi8( 
+                                   _mm256_max_epu8( block, limits ), limits ) );
+
+            if( mask != 0 )
+               {
+                return current + __builtin_ctz( mask );
+               }
+
+            current += 32;
+           }
+#elif defined( SCAN_USE_SSE2 )
+        const __m128i limits = _mm_set1_epi8( (char)limit );
+        __m128i block;
+        unsigned int mask;
+
+        // 16 bytes at a time, find first unsigned byte above limit
+        while( end - current >= 16 )
+           {
+            block = _mm_loadu_si128( (const __m128i *)current );
+            mask = ~(unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( 
+                                    _mm_max_epu8( block, limits ), limits ) )
+                                                                      & 0xFFFFu;
+
+            if( mask != 0 )
+               {
+                return current + __builtin_ctz( mask );
+               }
+
+            current += 16;
+           }
+#endif
+
+        // remaining characters, one at a time
+        while( current < end && (unsigned char)*current <= limit )
+           {
+            current++;
+           }
+
+        return current;
+       }
@@ -0,0 +1,68 @@
+/*
+Structural character scan utility, function prototypes
+
+Finds field delimiters, line ends and white space in memory
+16 bytes (SSE2) or 32 bytes (AVX2) at a time where the compiler
+targets those instruction sets, one byte at a time otherwise.
+All scans are bounded by the given end pointer, so data need not be
+NULL_CHAR terminated.
+*/
+
+// PreProcessor test
+#ifndef SCAN_UTILITY_H
+#define SCAN_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include <stddef.h>
+#include "StandardConstants.h"
+
+// function prototypes
+
+    /*
+    Name: findDelimiterOrControl
+    process: finds first character in range that is the given delimiter
+             or a non printable (control) character, such as CR or LF
+    Function input/parameters: range start and end (const char *),
+                               delimiter (char)
+    Function output/parameters: none
+    Function output/returned: pointer to character found, end if none
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    const char *findDelimiterOrControl( const char *start, const char *end,
+                                                              char delimiter );
+
+    /*
+    Name: scanFieldBoundaries
+    process: records position of every delimiter and NEWLINE_CHAR
+             in range, in order, stopping when boundary list is full
+    Function input/parameters: range start and end (const char *),
+                               delimiter (char), list capacity (int)
+    Function output/parameters: boundary positions (const char **)
+    Function output/returned: number of boundaries recorded (int)
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    int scanFieldBoundaries( const char *start, const char *end, 
+                             char delimiter, const char **boundaries,
+                                                           int maxBoundaries );
+
+    /*
+    Name: skipWhiteSpace
+    process: skips non printable characters, and space if flag set
+    Function input/parameters: range start and end (const char *),
+                               skip space flag (bool)
+    Function output/parameters: none
+    Function output/returned: pointer to first character not skipped,
+                              end if none
+    Device input/file: none
+    Device output/monitor: none
+    Dependencies: SSE2/AVX2 intrinsics when available
+    */
+    const char *skipWhiteSpace( const char *start, const char *end,
+                                                              bool skipSpace );
+
+#endif  // SCAN_UTILITY_H
@@ -0,0 +1,399 @@
+/*
+Snapshot utility, function implementations
+*/
+
+// header files
+#include "Snapshot_Utility.h"
+#include <stdlib.h>
+#include <string.h>
+
+// local function prototypes, used only in this file
+
+    SnapshotPageType *copySnapshotPage( const SnapshotSetType *set,
+                                                             int pageIndex );
+    void snapshotBeforeWrite( void *barrierData, int nodeIndex );
+
+/*
+Name: attachHashSnapshots
+Process: creates empty snapshot set of open addressing table and
+         attaches it to table as its write barrier
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, barrier attached
+                            (ProbingHashType *)
+Function output/returned: pointer to snapshot set, or NULL if table
+                          is chained or out of memory (SnapshotSetType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free, pthread_mutex_init,
+              setHashWriteBarrier
+*/
+SnapshotSetType *attachHashSnapshots( ProbingHashType *hash )
+   {
+    SnapshotSetType *set;
+
+    if( hash->chains != NULL )
+       {
+        return NULL;
+       }
+
+    set = (SnapshotSetType *)malloc( sizeof( SnapshotSetType ) );
+
+    if( set == NULL )
+       {
+        return NULL;
+       }
+
+    set->pageCount = ( hash->tableSize + SNAPSHOT_PAGE_NODES - 1 )
+                                                        / SNAPSHOT_PAGE_NODES;
+    set->pageEpochs = (unsigned long long *)calloc( set->pageCount + 1,
+                                               sizeof( unsigned long long ) );
+
+    if( set->pageEpochs == NULL )
+       {
+        free( set );
+
+        return NULL;
+       }
+
+    set->hash = hash;
+    set->snapshots = NULL;
+    set->snapshotCount = 0;
+    set->epoch = 0;
+    set->heldPageCount = 0;
+    set->copiedPageCount = 0;
+
+    pthread_mutex_init( &set->lock, NULL );
+
+    set->barrier.beforeWrite = snapshotBeforeWrite;
+    set->barrier.barrierData = set;
+
+    setHashWriteBarrier( hash, &set->barrier );
+
+    return set;
+   }
+
+/*
+Name: copySnapshotPage
+Process: copies nodes of given page of table, last page may hold
+         fewer than SNAPSHOT_PAGE_NODES nodes
+Function input/parameters: snapshot set (const SnapshotSetType *),
+                           page index (int)
+Function output/parameters: none
+Function output/returned: pointer to page copy, no references yet,
+                          or NULL if out of memory (SnapshotPageType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, memcpy
+*/
+SnapshotPageType *copySnapshotPage( const SnapshotSetType *set,
+                                                              int pageIndex )
+   {
+    int firstNode = pageIndex * SNAPSHOT_PAGE_NODES;
+    int nodeCount = set->hash->tableSize - firstNode < SNAPSHOT_PAGE_NODES ?
+                       set->hash->tableSize - firstNode : SNAPSHOT_PAGE_NODES;
+    SnapshotPageType *page = (SnapshotPageType *)malloc(
+         sizeof( SnapshotPageType ) + nodeCount * sizeof( StateDataType ) );
+
+    if( page != NULL )
+       {
+        page->refCount = 0;
+
+        memcpy( page->nodes, &set->hash->array[ firstNode ],
+                                          nodeCount * sizeof( StateDataType ) );
+       }
+
+    return page;
+   }
+
+/*
+Name: createHashSnapshot
+Process: takes snapshot of table as it is now, no nodes are copied;
+         must be called on thread writing table, or under its write lock
+Function input/parameters: snapshot set (SnapshotSetType *)
+Function output/parameters: updated snapshot set (SnapshotSetType *)
+Function output/returned: pointer to snapshot, or NULL if out of memory
+                          (HashSnapshotType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free, pthread_mutex_lock,
+              pthread_mutex_unlock
+*/
+HashSnapshotType *createHashSnapshot( SnapshotSetType *set )
+   {
+    HashSnapshotType *snapshot = (HashSnapshotType *)malloc(
+                                                  sizeof( HashSnapshotType ) );
+
+    if( snapshot == NULL )
+       {
+        return NULL;
+       }
+
+    // zeroed directory, large ones come untouched from the system
+    snapshot->pages = (SnapshotPageType **)calloc( set->pageCount + 1,
+                                                sizeof( SnapshotPageType * ) );
+
+    if( snapshot->pages == NULL )
+       {
+        free( snapshot );
+
+        return NULL;
+       }
+
+    snapshot->set = set;
+    snapshot->complete = true;
+    snapshot->previous = NULL;
+
+    pthread_mutex_lock( &set->lock );
+
+    // pages copied before now are not copies for this snapshot
+    set->epoch++;
+    snapshot->epoch = set->epoch;
+
+    snapshot->next = set->snapshots;
+
+    if( set->snapshots != NULL )
+       {
+        set->snapshots->previous = snapshot;
+       }
+
+    set->snapshots = snapshot;
+    set->snapshotCount++;
+
+    pthread_mutex_unlock( &set->lock );
+
+    return snapshot;
+   }
+
+/*
+Name: detachHashSnapshots
+Process: releases snapshots still held, detaches set from its table
+         and releases set, must be called before table is cleared
+Function input/parameters: snapshot set (SnapshotSetType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: releaseHashSnapshot, setHashWriteBarrier,
+              pthread_mutex_destroy, free
+*/
+void detachHashSnapshots( SnapshotSetType *set )
+   {
+    while( set->snapshots != NULL )
+       {
+        releaseHashSnapshot( set->snapshots );
+       }
+
+    setHashWriteBarrier( set->hash, NULL );
+
+    pthread_mutex_destroy( &set->lock );
+
+    free( set->pageEpochs );
+    free( set );
+   }
+
+/*
+Name: findSnapshotItem
+Process: finds item with name of search item as table held it when
+         snapshot was taken, probing same nodes as findItemIndex
+Function input/parameters: snapshot (HashSnapshotType *),
+                           search item (StateDataType)
+Function output/parameters: found item, if found (StateDataType *)
+Function output/returned: true if found, false otherwise (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength, getHashIndexFromView, getSnapshotNode
+*/
+bool findSnapshotItem( HashSnapshotType *snapshot, StateDataType searchItem,
+                                                    StateDataType *foundItem )
+   {
+    const ProbingHashType *hash = snapshot->set->hash;
+    StateDataType node;
+    int nameLength = getStringLength( searchItem.name );
+    int size = hash->tableSize, index, step;
+    int increment = hash->probeStrategy == LINEAR_PROBING ? 1 : 2;
+
+    // longer names are never in table
+    if( nameLength > STD_STR_LEN - 1 || size == 0 )
+       {
+        return false;
+       }
+
+    index = getHashIndexFromView( hash, searchItem.name, nameLength );
+    increment = increment % size;
+
+    // same steps as probeItemIndex, quadratic increments grow by 4
+    for( step = 1; step <= size; step++ )
+       {
+        getSnapshotNode( snapshot, index, &node );
+
+        if( node.inUse && node.name[ nameLength ] == NULL_CHAR
+                    && memcmp( node.name, searchItem.name, nameLength ) == 0 )
+           {
+            *foundItem = node;
+
+            return true;
+           }
+
+        index += increment;
+
+        if( index >= size )
+           {
+            index -= size;
+           }
+
+        if( hash->probeStrategy != LINEAR_PROBING )
+           {
+            increment = ( increment + 4 ) % size;
+           }
+       }
+
+    return false;
+   }
+
+/*
+Name: getSnapshotNode
+Process: copies node at given index as table held it when snapshot
+         was taken, from page copy of snapshot, or from table if page
+         is unchanged since
+Function input/parameters: snapshot (HashSnapshotType *),
+                           node index (int)
+Function output/parameters: node (StateDataType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_mutex_unlock
+*/
+void getSnapshotNode( HashSnapshotType *snapshot, int nodeIndex,
+                                                        StateDataType *node )
+   {
+    SnapshotPageType *page;
+
+    // writer copies page under lock before writing it, so table node
+    // read under lock is unchanged since snapshot
+    pthread_mutex_lock( &snapshot->set->lock );
+
+    page = snapshot->pages[ nodeIndex / SNAPSHOT_PAGE_NODES ];
+
+    *node = page != NULL ? page->nodes[ nodeIndex % SNAPSHOT_PAGE_NODES ]
+                         : snapshot->set->hash->array[ nodeIndex ];
+
+    pthread_mutex_unlock( &snapshot->set->lock );
+   }
+
+/*
+Name: releaseHashSnapshot
+Process: removes snapshot from its set and releases it, freeing page
+         copies no other snapshot holds
+Function input/parameters: snapshot (HashSnapshotType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_mutex_unlock, free
+*/
+void releaseHashSnapshot( HashSnapshotType *snapshot )
+   {
+    SnapshotSetType *set = snapshot->set;
+    SnapshotPageType *page;
+    int pageIndex;
+
+    pthread_mutex_lock( &set->lock );
+
+    if( snapshot->previous != NULL )
+       {
+        snapshot->previous->next = snapshot->next;
+       }
+
+    else
+       {
+        set->snapshots = snapshot->next;
+       }
+
+    if( snapshot->next != NULL )
+       {
+        snapshot->next->previous = snapshot->previous;
+       }
+
+    set->snapshotCount--;
+
+    for( pageIndex = 0; pageIndex < set->pageCount; pageIndex++ )
+       {
+        page = snapshot->pages[ pageIndex ];
+
+        if( page != NULL )
+           {
+            page->refCount--;
+
+            if( page->refCount == 0 )
+               {
+                free( page );
+
+                set->heldPageCount--;
+               }
+           }
+       }
+
+    pthread_mutex_unlock( &set->lock );
+
+    free( snapshot->pages );
+    free( snapshot );
+   }
+
+/*
+Name: snapshotBeforeWrite
+Process: write barrier of snapshot set, before first write to page
+         since latest snapshot copies page once and gives copy to each
+         snapshot still reading page from table; if out of memory,
+         those snapshots are marked incomplete
+Function input/parameters: snapshot set (void *), node index (int)
+Function output/parameters: updated snapshot set (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, copySnapshotPage, pthread_mutex_unlock
+*/
+void snapshotBeforeWrite( void *barrierData, int nodeIndex )
+   {
+    SnapshotSetType *set = (SnapshotSetType *)barrierData;
+    HashSnapshotType *snapshot;
+    SnapshotPageType *page = NULL;
+    int pageIndex = nodeIndex / SNAPSHOT_PAGE_NODES;
+
+    // epochs change only on writing thread, no lock needed to compare
+    if( set->pageEpochs[ pageIndex ] == set->epoch )
+       {
+        return;
+       }
+
+    pthread_mutex_lock( &set->lock );
+
+    for( snapshot = set->snapshots; snapshot != NULL;
+                                                   snapshot = snapshot->next )
+       {
+        if( snapshot->pages[ pageIndex ] == NULL )
+           {
+            // snapshots still reading page from table share one copy
+            if( page == NULL )
+               {
+                page = copySnapshotPage( set, pageIndex );
+
+                if( page == NULL )
+                   {
+                    snapshot->complete = false;
+
+                    continue;
+                   }
+
+                set->heldPageCount++;
+                set->copiedPageCount++;
+               }
+
+            snapshot->pages[ pageIndex ] = page;
+            page->refCount++;
+           }
+       }
+
+    set->pageEpochs[ pageIndex ] = set->epoch;
+
+    pthread_mutex_unlock( &set->lock );
+   }
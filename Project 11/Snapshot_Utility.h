@@ -0,0 +1,163 @@
+/*
+Snapshot utility, function prototypes
+
+Point in time snapshots of an open addressing hash table, kept by
+page granular copy on write: the table array is split into pages of
+SNAPSHOT_PAGE_NODES nodes, and a snapshot holds nothing but an empty
+page directory when taken, so taking one does no copying. The table's
+write barrier copies a page once, just before its first write after a
+snapshot is taken, and shares that copy, reference counted, among all
+snapshots still reading the page from the table; pages never written
+are read from the table itself. A copy is freed when the last
+snapshot holding it is released.
+Snapshots are taken on the thread writing the table (or under its
+write lock); reads and releases may come from any thread.
+Chained strategies move nodes through links and slabs as well as the
+array, and cannot be snapshotted.
+*/
+
+// PreProcessor test
+#ifndef SNAPSHOT_UTILITY_H
+#define SNAPSHOT_UTILITY_H
+
+// header files
+#include <pthread.h>
+#include "HashUtilities.h"
+
+// constants
+
+    // table nodes per copy on write page
+    static const int SNAPSHOT_PAGE_NODES = 64;
+
+// data structures
+
+    // copy of one page of table nodes, shared by the snapshots holding it
+    typedef struct SnapshotPageStruct
+       {
+        int refCount;
+        StateDataType nodes[];
+       } SnapshotPageType;
+
+    // snapshot of table, page directory entry is NULL while page is
+    // unchanged in table since snapshot was taken; incomplete if a
+    // page could not be copied before it was written
+    typedef struct HashSnapshotStruct
+       {
+        struct SnapshotSetStruct *set;
+        SnapshotPageType **pages;
+        bool complete;
+        unsigned long long epoch;
+        struct HashSnapshotStruct *previous;
+        struct HashSnapshotStruct *next;
+       } HashSnapshotType;
+
+    // snapshots of one table, attached to table by write barrier;
+    // page epoch is epoch at which page was last copied (or found with
+    // no snapshots), so later writes to page skip the barrier lock
+    // until next snapshot is taken
+    typedef struct SnapshotSetStruct
+       {
+        ProbingHashType *hash;
+        HashWriteBarrierType barrier;
+        pthread_mutex_t lock;
+        HashSnapshotType *snapshots;
+        int snapshotCount;
+        unsigned long long epoch;
+        unsigned long long *pageEpochs;
+        int pageCount;
+        int heldPageCount;
+        long long copiedPageCount;
+       } SnapshotSetType;
+
+// function prototypes
+
+/*
+Name: attachHashSnapshots
+Process: creates empty snapshot set of open addressing table and
+         attaches it to table as its write barrier
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, barrier attached
+                            (ProbingHashType *)
+Function output/returned: pointer to snapshot set, or NULL if table
+                          is chained or out of memory (SnapshotSetType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free, pthread_mutex_init,
+              setHashWriteBarrier
+*/
+SnapshotSetType *attachHashSnapshots( ProbingHashType *hash );
+
+/*
+Name: createHashSnapshot
+Process: takes snapshot of table as it is now, no nodes are copied;
+         must be called on thread writing table, or under its write lock
+Function input/parameters: snapshot set (SnapshotSetType *)
+Function output/parameters: updated snapshot set (SnapshotSetType *)
+Function output/returned: pointer to snapshot, or NULL if out of memory
+                          (HashSnapshotType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, calloc, free, pthread_mutex_lock,
+              pthread_mutex_unlock
+*/
+HashSnapshotType *createHashSnapshot( SnapshotSetType *set );
+
+/*
+Name: detachHashSnapshots
+Process: releases snapshots still held, detaches set from its table
+         and releases set, must be called before table is cleared
+Function input/parameters: snapshot set (SnapshotSetType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: releaseHashSnapshot, setHashWriteBarrier,
+              pthread_mutex_destroy, free
+*/
+void detachHashSnapshots( SnapshotSetType *set );
+
+/*
+Name: findSnapshotItem
+Process: finds item with name of search item as table held it when
+         snapshot was taken, probing same nodes as findItemIndex
+Function input/parameters: snapshot (HashSnapshotType *),
+                           search item (StateDataType)
+Function output/parameters: found item, if found (StateDataType *)
+Function output/returned: true if found, false otherwise (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength, getHashIndexFromView, getSnapshotNode
+*/
+bool findSnapshotItem( HashSnapshotType *snapshot, StateDataType searchItem,
+                                                   StateDataType *foundItem );
+
+/*
+Name: getSnapshotNode
+Process: copies node at given index as table held it when snapshot
+         was taken, from page copy of snapshot, or from table if page
+         is unchanged since
+Function input/parameters: snapshot (HashSnapshotType *),
+                           node index (int)
+Function output/parameters: node (StateDataType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_mutex_unlock
+*/
+void getSnapshotNode( HashSnapshotType *snapshot, int nodeIndex,
+                                                       StateDataType *node );
+
+/*
+Name: releaseHashSnapshot
+Process: removes snapshot from its set and releases it, freeing page
+         copies no other snapshot holds
+Function input/parameters: snapshot (HashSnapshotType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_mutex_unlock, free
+*/
+void releaseHashSnapshot( HashSnapshotType *snapshot );
+
+#endif  // SNAPSHOT_UTILITY_H
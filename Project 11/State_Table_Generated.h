@@ -0,0 +1,191 @@
+/*
+Generated perfect hash table, do not edit
+
+Generated by perfecthashgenerator from inData.csv, 50 keys.
+Table is const initialized, so it lives in read only memory and
+needs no initializeHashTable or uploadData at startup; regenerate
+when key list changes.
+*/
+
+// PreProcessor test
+#ifndef STATE_TABLE_GENERATED_H
+#define STATE_TABLE_GENERATED_H
+
+// header files
+#include <stdint.h>
+#include <string.h>
+#include "HashUtilities.h"
+
+// constants
+
+    static const int STATE_TABLE_SLOT_COUNT = 50;
+
+    static const int STATE_TABLE_BUCKET_COUNT = 13;
+
+    static const uint64_t STATE_TABLE_SEED = 0x9E3779B97F4A7C15ULL;
+
+    // displacement pair of each bucket
+    static const uint32_t STATE_TABLE_DISPLACEMENTS[ 26 ] =
+       {
+        0, 1, 0, 28, 0, 9, 0, 41,
+        0, 2, 34, 49, 0, 0, 0, 2,
+        3, 31, 0, 5, 15, 16, 1, 26,
+        0, 0
+       };
+
+    // states, one per slot
+    static const StateDataType STATE_TABLE_STATES[ 50 ] =
+       {
+        { "Virginia", 55.1, -30.0, 110.0, true },
+        { "Illinois", 51.7, -36.0, 117.0, true },
+        { "West Virginia", 51.8, -37.0, 112.0, true },
+        { "Tennessee", 57.6, -32.0, 113.0, true },
+        { "Colorado", 45.1, -61.0, 118.0, true },
+        { "South Dakota", 45.2, -58.0, 120.0, true },
+        { "Arkansas", 60.3, -29.0, 120.0, true },
+        { "Montana", 42.7, -70.0, 117.0, true },
+        { "Michigan", 44.4, -51.0, 112.0, true },
+        { "Vermont", 42.9, -50.0, 105.0, true },
+        { "Washington", 48.3, -48.0, 118.0, true },
+        { "Utah", 48.6, -69.0, 117.0, true },
+        { "Nebraska", 48.8, -47.0, 118.0, true },
+        { "Wyoming", 42.0, -66.0, 115.0, true },
+        { "Missouri", 63.4, -40.0, 118.0, true },
+        { "Ohio", 50.7, -39.0, 113.0, true },
+        { "Hawaii", 70.0, 12.0, 100.0, true },
+        { "Wisconsin", 43.1, -55.0, 114.0, true },
+        { "Maine", 47.9, -50.0, 105.0, true },
+        { "Texas", 64.8, -23.0, 120.0, true },
+        { "Kentucky", 55.6, -37.0, 114.0, true },
+        { "Arizona", 60.4, -40.0, 128.0, true },
+        { "Connecticut", 49.0, -32.0, 106.0, true },
+        { "Oregon", 48.4, -54.0, 119.0, true },
+        { "South Carolina", 62.4, -19.0, 111.0, true },
+        { "Georgia", 63.5, -17.0, 112.0, true },
+        { "New Mexico", 52.7, -50.0, 122.0, true },
+        { "Florida", 70.7, -2.0, 109.0, true },
+        { "North Dakota", 40.4, -60.0, 121.0, true },
+        { "Rhode Island", 50.1, -25.0, 104.0, true },
+        { "New Jersey", 43.8, -34.0, 110.0, true },
+        { "Oklahoma", 59.6, -27.0, 120.0, true },
+        { "Minnesota", 41.2, -60.0, 114.0, true },
+        { "Maryland", 54.2, -40.0, 109.0, true },
+        { "Massachusetts", 41.0, -35.0, 107.0, true },
+        { "Alaska", 62.8, -80.0, 100.0, true },
+        { "Alabama", 26.6, -27.0, 112.0, true },
+        { "New Hampshire", 49.9, -47.0, 106.0, true },
+        { "California", 59.4, -45.0, 134.0, true },
+        { "North Carolina", 59.0, -34.0, 110.0, true },
+        { "New York", 45.4, -52.0, 108.0, true },
+        { "Idaho", 51.8, -60.0, 118.0, true },
+        { "Kansas", 54.3, -40.0, 121.0, true },
+        { "Mississippi", 54.5, -19.0, 115.0, true },
+        { "Iowa", 44.4, -47.0, 118.0, true },
+        { "Indiana", 47.8, -36.0, 116.0, true },
+        { "Pennsylvania", 48.8, -42.0, 111.0, true },
+        { "Delaware", 55.3, -17.0, 110.0, true },
+        { "Nevada", 53.4, -50.0, 125.0, true },
+        { "Louisiana", 66.4, -16.0, 114.0, true }
+       };
+
+// functions
+
+/*
+Name: getStateTableHash
+Process: seeded 64 bit hash of name (FNV-1a with splitmix64 finish),
+         same as getFrozenNameHash
+Function input/parameters: name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline uint64_t getStateTableHash( const char *name, int nameLength )
+   {
+    uint64_t hash = 0xCBF29CE484222325ULL ^ STATE_TABLE_SEED;
+    int index;
+
+    for( index = 0; index < nameLength; index++ )
+       {
+        hash = ( hash ^ (unsigned char)name[ index ] ) * 0x100000001B3ULL;
+       }
+
+    hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return hash ^ ( hash >> 31 );
+   }
+
+/*
+Name: findStateTableItemFromView
+Process: finds state by name given as pointer and length,
+         one hash, one slot, one name check, names longer than
+         STD_STR_LEN - 1 are truncated as they would be in the
+         table, as findFrozenItemFromView does
+Function input/parameters: name (const char *), name length (int)
+Function output/parameters: none
+Function output/returned: pointer to state, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: getStateTableHash, memcmp
+*/
+static inline const StateDataType *findStateTableItemFromView(
+                                     const char *name, int nameLength )
+   {
+    uint64_t hash, offset, step;
+    int bucket;
+    const StateDataType *node;
+
+    if( nameLength > STD_STR_LEN - 1 )
+       {
+        nameLength = STD_STR_LEN - 1;
+       }
+
+    hash = getStateTableHash( name, nameLength );
+    bucket = (int)( hash % (uint64_t)STATE_TABLE_BUCKET_COUNT );
+    offset = ( hash >> 32 ) % (uint64_t)STATE_TABLE_SLOT_COUNT;
+    step = ( ( hash * 0x9E3779B97F4A7C15ULL ) >> 32 )
+                                        % (uint64_t)STATE_TABLE_SLOT_COUNT;
+
+    node = &STATE_TABLE_STATES[ ( offset
+                   + STATE_TABLE_DISPLACEMENTS[ 2 * bucket ] * step
+                   + STATE_TABLE_DISPLACEMENTS[ 2 * bucket + 1 ] )
+                                    % (uint64_t)STATE_TABLE_SLOT_COUNT ];
+
+    if( node->name[ nameLength ] == NULL_CHAR
+                         && memcmp( node->name, name, nameLength ) == 0 )
+       {
+        return node;
+       }
+
+    return NULL;
+   }
+
+/*
+Name: findStateTableItem
+Process: finds state by name, names longer than STD_STR_LEN - 1
+         are truncated as they would be in the table
+Function input/parameters: state name (const char *)
+Function output/parameters: none
+Function output/returned: pointer to state, 
+                          or NULL if not found (const StateDataType *)
+Device input/---: none
+Device output/---: none
+Dependencies: strlen, findStateTableItemFromView
+*/
+static inline const StateDataType *findStateTableItem(
+                                                const char *stateName )
+   {
+    size_t nameLength = strlen( stateName );
+
+    if( nameLength > STD_STR_LEN - 1 )
+       {
+        nameLength = STD_STR_LEN - 1;
+       }
+
+    return findStateTableItemFromView( stateName, (int)nameLength );
+   }
+
+#endif  // STATE_TABLE_GENERATED_H
@@ -0,0 +1,580 @@
+/*
+Temperature index utility, function implementations
+*/
+
+// header files
+#include "Temperature_Index_Utility.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local function prototypes, used only in this file
+
+    int compareAverageEntries( const void *onePtr, const void *otherPtr );
+    int compareHighestEntries( const void *onePtr, const void *otherPtr );
+    int compareLowestEntries( const void *onePtr, const void *otherPtr );
+    int compareTemperatureEntries( const StateDataType *oneNode,
+                                         const StateDataType *otherNode,
+                                                 TemperatureFieldType field );
+    int compareTemperatures( double oneTemp, double otherTemp );
+    int findEntryPosition( const TemperatureIndexType *index,
+                     TemperatureFieldType field, const StateDataType *node );
+    int findFirstAbove( const TemperatureIndexType *index,
+                                     TemperatureFieldType field, double temp );
+    int findFirstAtLeast( const TemperatureIndexType *index,
+                                     TemperatureFieldType field, double temp );
+    bool growTemperatureIndex( TemperatureIndexType *index );
+    void indexNodeAdded( void *indexData, const StateDataType *node );
+    void indexNodeRemoved( void *indexData, const StateDataType *node );
+
+/*
+Name: clearTemperatureIndex
+Process: detaches index from its table, releases index and its arrays,
+         must be called before table is cleared
+Function input/parameters: index (TemperatureIndexType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, free
+*/
+void clearTemperatureIndex( TemperatureIndexType *index )
+   {
+    int field;
+
+    removeHashIndexHook( index->hash, &index->hook );
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        free( index->entries[ field ] );
+       }
+
+    free( index );
+   }
+
+/*
+Name: compareAverageEntries
+Process: qsort comparison of index entries by average temperature
+Function input/parameters: pointers to two entries (const void *)
+Function output/parameters: none
+Function output/returned: comparison result (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatureEntries
+*/
+int compareAverageEntries( const void *onePtr, const void *otherPtr )
+   {
+    return compareTemperatureEntries( *(const StateDataType * const *)onePtr,
+                                   *(const StateDataType * const *)otherPtr,
+                                                          AVERAGE_TEMP_FIELD );
+   }
+
+/*
+Name: compareHighestEntries
+Process: qsort comparison of index entries by highest temperature
+Function input/parameters: pointers to two entries (const void *)
+Function output/parameters: none
+Function output/returned: comparison result (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatureEntries
+*/
+int compareHighestEntries( const void *onePtr, const void *otherPtr )
+   {
+    return compareTemperatureEntries( *(const StateDataType * const *)onePtr,
+                                   *(const StateDataType * const *)otherPtr,
+                                                          HIGHEST_TEMP_FIELD );
+   }
+
+/*
+Name: compareLowestEntries
+Process: qsort comparison of index entries by lowest temperature
+Function input/parameters: pointers to two entries (const void *)
+Function output/parameters: none
+Function output/returned: comparison result (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatureEntries
+*/
+int compareLowestEntries( const void *onePtr, const void *otherPtr )
+   {
+    return compareTemperatureEntries( *(const StateDataType * const *)onePtr,
+                                   *(const StateDataType * const *)otherPtr,
+                                                          LOWEST_TEMP_FIELD );
+   }
+
+/*
+Name: compareTemperatureEntries
+Process: orders index entries by field value, then by node address,
+         so every node has one exact position
+Function input/parameters: two nodes (const StateDataType *),
+                           field (TemperatureFieldType)
+Function output/parameters: none
+Function output/returned: negative, zero, or positive (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatures, getTemperatureValue
+*/
+int compareTemperatureEntries( const StateDataType *oneNode,
+                                          const StateDataType *otherNode,
+                                                  TemperatureFieldType field )
+   {
+    int result = compareTemperatures( getTemperatureValue( oneNode, field ),
+                                    getTemperatureValue( otherNode, field ) );
+
+    if( result != 0 )
+       {
+        return result;
+       }
+
+    if( (uintptr_t)oneNode != (uintptr_t)otherNode )
+       {
+        return (uintptr_t)oneNode < (uintptr_t)otherNode ? -1 : 1;
+       }
+
+    return 0;
+   }
+
+/*
+Name: compareTemperatures
+Process: total order of temperatures, not a number after all others
+Function input/parameters: two temperatures (double)
+Function output/parameters: none
+Function output/returned: negative, zero, or positive (int)
+Device input/---: none
+Device output/---: none
+Dependencies: isnan
+*/
+int compareTemperatures( double oneTemp, double otherTemp )
+   {
+    if( oneTemp < otherTemp )
+       {
+        return -1;
+       }
+
+    if( oneTemp > otherTemp )
+       {
+        return 1;
+       }
+
+    return ( isnan( oneTemp ) ? 1 : 0 ) - ( isnan( otherTemp ) ? 1 : 0 );
+   }
+
+/*
+Name: createTemperatureIndex
+Process: builds index over states in use in table, sorting each field,
+         then attaches index to table so later adds and removes
+         keep it in sync
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, index attached
+                            (ProbingHashType *)
+Function output/returned: pointer to index,
+                          or NULL if out of memory (TemperatureIndexType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, qsort, addHashIndexHook, free
+*/
+TemperatureIndexType *createTemperatureIndex( ProbingHashType *hash )
+   {
+    int (*comparisons[ TEMPERATURE_FIELD_COUNT ])( const void *,
+                                                          const void * ) =
+           { compareAverageEntries, compareLowestEntries,
+                                                    compareHighestEntries };
+    TemperatureIndexType *index;
+    int nodeIndex, field, count = 0;
+
+    index = (TemperatureIndexType *)malloc( sizeof( TemperatureIndexType ) );
+
+    if( index == NULL )
+       {
+        return NULL;
+       }
+
+    for( nodeIndex = 0; nodeIndex < hash->tableSize; nodeIndex++ )
+       {
+        count += hash->array[ nodeIndex ].inUse ? 1 : 0;
+       }
+
+    index->count = count;
+    index->capacity = count > MIN_TEMPERATURE_INDEX_CAPACITY
+                                      ? count : MIN_TEMPERATURE_INDEX_CAPACITY;
+    index->complete = true;
+    index->hash = hash;
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        index->entries[ field ] = (const StateDataType **)malloc(
+                          index->capacity * sizeof( const StateDataType * ) );
+
+        if( index->entries[ field ] == NULL )
+           {
+            while( field > 0 )
+               {
+                field--;
+
+                free( index->entries[ field ] );
+               }
+
+            free( index );
+
+            return NULL;
+           }
+       }
+
+    // gather nodes in use, sort each field
+    count = 0;
+
+    for( nodeIndex = 0; nodeIndex < hash->tableSize; nodeIndex++ )
+       {
+        if( hash->array[ nodeIndex ].inUse )
+           {
+            for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+               {
+                index->entries[ field ][ count ] = &hash->array[ nodeIndex ];
+               }
+
+            count++;
+           }
+       }
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        qsort( index->entries[ field ], count, sizeof( const StateDataType * ),
+                                                      comparisons[ field ] );
+       }
+
+    // keep in sync from here on
+    index->hook.nodeAdded = indexNodeAdded;
+    index->hook.nodeRemoved = indexNodeRemoved;
+    index->hook.indexData = index;
+
+    addHashIndexHook( hash, &index->hook );
+
+    return index;
+   }
+
+/*
+Name: findEntryPosition
+Process: binary search for position of node in field entries,
+         or where it would be inserted
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           node (const StateDataType *)
+Function output/parameters: none
+Function output/returned: position (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatureEntries
+*/
+int findEntryPosition( const TemperatureIndexType *index,
+                      TemperatureFieldType field, const StateDataType *node )
+   {
+    const StateDataType **entries = index->entries[ field ];
+    int low = 0, high = index->count, middle;
+
+    while( low < high )
+       {
+        middle = low + ( high - low ) / 2;
+
+        if( compareTemperatureEntries( entries[ middle ], node, field ) < 0 )
+           {
+            low = middle + 1;
+           }
+
+        else
+           {
+            high = middle;
+           }
+       }
+
+    return low;
+   }
+
+/*
+Name: findFirstAbove
+Process: binary search for first entry with field value above given
+         temperature
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           temperature (double)
+Function output/parameters: none
+Function output/returned: position, or count if none above (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatures, getTemperatureValue
+*/
+int findFirstAbove( const TemperatureIndexType *index,
+                                     TemperatureFieldType field, double temp )
+   {
+    const StateDataType **entries = index->entries[ field ];
+    int low = 0, high = index->count, middle;
+
+    while( low < high )
+       {
+        middle = low + ( high - low ) / 2;
+
+        if( compareTemperatures( getTemperatureValue( entries[ middle ],
+                                                     field ), temp ) <= 0 )
+           {
+            low = middle + 1;
+           }
+
+        else
+           {
+            high = middle;
+           }
+       }
+
+    return low;
+   }
+
+/*
+Name: findFirstAtLeast
+Process: binary search for first entry with field value at or above
+         given temperature
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           temperature (double)
+Function output/parameters: none
+Function output/returned: position, or count if none at or above (int)
+Device input/---: none
+Device output/---: none
+Dependencies: compareTemperatures, getTemperatureValue
+*/
+int findFirstAtLeast( const TemperatureIndexType *index,
+                                     TemperatureFieldType field, double temp )
+   {
+    const StateDataType **entries = index->entries[ field ];
+    int low = 0, high = index->count, middle;
+
+    while( low < high )
+       {
+        middle = low + ( high - low ) / 2;
+
+        if( compareTemperatures( getTemperatureValue( entries[ middle ],
+                                                      field ), temp ) < 0 )
+           {
+            low = middle + 1;
+           }
+
+        else
+           {
+            high = middle;
+           }
+       }
+
+    return low;
+   }
+
+/*
+Name: findTemperatureRange
+Process: finds states with given field between low and high temperature,
+         inclusive, in ascending order, fills up to maxResults of them;
+         two binary searches, then one copy per result
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           low and high temperatures (double),
+                           maximum results to fill (int)
+Function output/parameters: states found (const StateDataType **),
+                            may be NULL if maxResults is zero
+Function output/returned: number of states in range,
+                          may be more than maxResults (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findFirstAbove, findFirstAtLeast
+*/
+int findTemperatureRange( const TemperatureIndexType *index,
+                     TemperatureFieldType field, double lowTemp,
+                     double highTemp, const StateDataType **results,
+                                                             int maxResults )
+   {
+    int first = findFirstAtLeast( index, field, lowTemp );
+    int end = findFirstAbove( index, field, highTemp );
+    int position;
+
+    if( end <= first )
+       {
+        return 0;
+       }
+
+    for( position = first; position < end
+                                  && position - first < maxResults; position++ )
+       {
+        results[ position - first ] = index->entries[ field ][ position ];
+       }
+
+    return end - first;
+   }
+
+/*
+Name: findTopTemperatures
+Process: finds states with highest (or lowest) values of given field,
+         highest first (or lowest first)
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           number of states wanted (int),
+                           highest flag, false for lowest (bool)
+Function output/parameters: states found (const StateDataType **)
+Function output/returned: number of states filled (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findFirstAbove
+*/
+int findTopTemperatures( const TemperatureIndexType *index,
+                     TemperatureFieldType field, int count, bool highest,
+                                              const StateDataType **results )
+   {
+    // values that are not a number sort last, never returned
+    int numberCount = findFirstAbove( index, field, HUGE_VAL );
+    int position;
+
+    if( count > numberCount )
+       {
+        count = numberCount;
+       }
+
+    for( position = 0; position < count; position++ )
+       {
+        results[ position ] = index->entries[ field ][ highest
+                               ? numberCount - 1 - position : position ];
+       }
+
+    return count < 0 ? 0 : count;
+   }
+
+/*
+Name: getTemperatureValue
+Process: gets value of given temperature field of state
+Function input/parameters: state (const StateDataType *),
+                           field (TemperatureFieldType)
+Function output/parameters: none
+Function output/returned: temperature (double)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+double getTemperatureValue( const StateDataType *node,
+                                                  TemperatureFieldType field )
+   {
+    if( field == LOWEST_TEMP_FIELD )
+       {
+        return node->lowestTemp;
+       }
+
+    if( field == HIGHEST_TEMP_FIELD )
+       {
+        return node->highestTemp;
+       }
+
+    return node->averageTemp;
+   }
+
+/*
+Name: growTemperatureIndex
+Process: doubles capacity of each field's entries
+Function input/parameters: index (TemperatureIndexType *)
+Function output/parameters: updated index (TemperatureIndexType *)
+Function output/returned: true if grown, false if out of memory (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: realloc
+*/
+bool growTemperatureIndex( TemperatureIndexType *index )
+   {
+    const StateDataType **grownEntries;
+    int field, newCapacity = index->capacity * 2;
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        grownEntries = (const StateDataType **)realloc(
+                                    (void *)index->entries[ field ],
+                              newCapacity * sizeof( const StateDataType * ) );
+
+        if( grownEntries == NULL )
+           {
+            return false;
+           }
+
+        index->entries[ field ] = grownEntries;
+       }
+
+    index->capacity = newCapacity;
+
+    return true;
+   }
+
+/*
+Name: indexNodeAdded
+Process: index hook, inserts node in each field's entries at its
+         sorted position; if out of memory, node is left out and
+         index is marked incomplete
+Function input/parameters: index (void *), node (const StateDataType *)
+Function output/parameters: updated index (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: growTemperatureIndex, findEntryPosition, memmove
+*/
+void indexNodeAdded( void *indexData, const StateDataType *node )
+   {
+    TemperatureIndexType *index = (TemperatureIndexType *)indexData;
+    int field, position;
+
+    if( index->count == index->capacity && !growTemperatureIndex( index ) )
+       {
+        index->complete = false;
+
+        return;
+       }
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        position = findEntryPosition( index, field, node );
+
+        memmove( (void *)&index->entries[ field ][ position + 1 ],
+                 (const void *)&index->entries[ field ][ position ],
+              ( index->count - position ) * sizeof( const StateDataType * ) );
+
+        index->entries[ field ][ position ] = node;
+       }
+
+    index->count++;
+   }
+
+/*
+Name: indexNodeRemoved
+Process: index hook, removes node from each field's entries,
+         node data must still be set
+Function input/parameters: index (void *), node (const StateDataType *)
+Function output/parameters: updated index (void *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: findEntryPosition, memmove
+*/
+void indexNodeRemoved( void *indexData, const StateDataType *node )
+   {
+    TemperatureIndexType *index = (TemperatureIndexType *)indexData;
+    int field, position;
+
+    // left out when added
+    position = findEntryPosition( index, AVERAGE_TEMP_FIELD, node );
+
+    if( position == index->count
+               || index->entries[ AVERAGE_TEMP_FIELD ][ position ] != node )
+       {
+        return;
+       }
+
+    for( field = 0; field < TEMPERATURE_FIELD_COUNT; field++ )
+       {
+        position = findEntryPosition( index, field, node );
+
+        memmove( (void *)&index->entries[ field ][ position ],
+                 (const void *)&index->entries[ field ][ position + 1 ],
+          ( index->count - position - 1 ) * sizeof( const StateDataType * ) );
+       }
+
+    index->count--;
+   }
@@ -0,0 +1,125 @@
+/*
+Temperature index utility, function prototypes
+
+Ordered secondary index over averageTemp, lowestTemp, and highestTemp of
+states in a hash table, one sorted array of node pointers per field,
+kept in sync with the table through an index hook, so range and top k
+queries are binary searches in place of full table scans; states must
+be added and removed only through table functions while indexed.
+*/
+
+// PreProcessor test
+#ifndef TEMPERATURE_INDEX_UTILITY_H
+#define TEMPERATURE_INDEX_UTILITY_H
+
+// header files
+#include "HashUtilities.h"
+
+// constants
+
+    // temperature fields indexed
+    typedef enum { AVERAGE_TEMP_FIELD, LOWEST_TEMP_FIELD, HIGHEST_TEMP_FIELD,
+                               TEMPERATURE_FIELD_COUNT } TemperatureFieldType;
+
+    // smallest number of entries allocated per field
+    static const int MIN_TEMPERATURE_INDEX_CAPACITY = 64;
+
+// data structures
+
+    // sorted node pointers per field, ordered by value, then by address
+    typedef struct TemperatureIndexStruct
+       {
+        const StateDataType **entries[ TEMPERATURE_FIELD_COUNT ];
+        int count;
+        int capacity;
+        bool complete;
+        ProbingHashType *hash;
+        HashIndexHookType hook;
+       } TemperatureIndexType;
+
+// function prototypes
+
+/*
+Name: clearTemperatureIndex
+Process: detaches index from its table, releases index and its arrays,
+         must be called before table is cleared
+Function input/parameters: index (TemperatureIndexType *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: removeHashIndexHook, free
+*/
+void clearTemperatureIndex( TemperatureIndexType *index );
+
+/*
+Name: createTemperatureIndex
+Process: builds index over states in use in table, sorting each field,
+         then attaches index to table so later adds and removes
+         keep it in sync
+Function input/parameters: hash table (ProbingHashType *)
+Function output/parameters: updated hash table, index attached
+                            (ProbingHashType *)
+Function output/returned: pointer to index,
+                          or NULL if out of memory (TemperatureIndexType *)
+Device input/---: none
+Device output/---: none
+Dependencies: malloc, qsort, addHashIndexHook, free
+*/
+TemperatureIndexType *createTemperatureIndex( ProbingHashType *hash );
+
+/*
+Name: findTemperatureRange
+Process: finds states with given field between low and high temperature,
+         inclusive, in ascending order, fills up to maxResults of them;
+         two binary searches, then one copy per result
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           low and high temperatures (double),
+                           maximum results to fill (int)
+Function output/parameters: states found (const StateDataType **),
+                            may be NULL if maxResults is zero
+Function output/returned: number of states in range,
+                          may be more than maxResults (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findFirstAbove, findFirstAtLeast
+*/
+int findTemperatureRange( const TemperatureIndexType *index,
+                     TemperatureFieldType field, double lowTemp,
+                     double highTemp, const StateDataType **results,
+                                                             int maxResults );
+
+/*
+Name: findTopTemperatures
+Process: finds states with highest (or lowest) values of given field,
+         highest first (or lowest first)
+Function input/parameters: index (const TemperatureIndexType *),
+                           field (TemperatureFieldType),
+                           number of states wanted (int),
+                           highest flag, false for lowest (bool)
+Function output/parameters: states found (const StateDataType **)
+Function output/returned: number of states filled (int)
+Device input/---: none
+Device output/---: none
+Dependencies: findFirstAbove
+*/
+int findTopTemperatures( const TemperatureIndexType *index,
+                     TemperatureFieldType field, int count, bool highest,
+                                             const StateDataType **results );
+
+/*
+Name: getTemperatureValue
+Process: gets value of given temperature field of state
+Function input/parameters: state (const StateDataType *),
+                           field (TemperatureFieldType)
+Function output/parameters: none
+Function output/returned: temperature (double)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+double getTemperatureValue( const StateDataType *node,
+                                                 TemperatureFieldType field );
+
+#endif  // TEMPERATURE_INDEX_UTILITY_H
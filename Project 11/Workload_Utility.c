@@ -0,0 +1,316 @@
+/*
+Workload utility, function implementations
+*/
+
+// header files
+#include "Workload_Utility.h"
+#include <math.h>
+#include <stdio.h>
+#include "Benchmark_Utility.h"
+#include "Binary_Data_Utility.h"
+
+/*
+Name: makeWorkloadName
+Process: creates name for row index, the same every time for same settings,
+         rows below family count times family size are anagram families,
+         each family a shuffle of one set of upper case letters, 
+         so all members share a hash index under getHashIndex,
+         other rows are an upper case letter, random lower case letters,
+         and the row index in lower case base 26, so they are unique,
+         names are lengthened when needed to hold the row index
+Function input/parameters: settings (const WorkloadSettingsType *),
+                           row index (long long)
+Function output/parameters: name (char *)
+Function output/returned: name length (int)
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom, sqrt, log, cos
+*/
+int makeWorkloadName( char *name, const WorkloadSettingsType *settings, 
+                                                            long long rowIndex )
+   {
+    long long familyRows = settings->familyCount * settings->familySize;
+    unsigned long long state;
+    int length, nameIndex, swapIndex, digitCount = 0;
+    long long remaining = rowIndex;
+    double unitOne, unitTwo, spread;
+    char swapChar;
+
+    if( rowIndex < familyRows )
+       {
+        // family letters from family index
+        state = settings->seed ^ ( 0xA5A5A5A5ULL 
+                                     + (unsigned long long)( rowIndex 
+                                                 / settings->familySize ) );
+
+        for( nameIndex = 0; nameIndex < settings->familyNameLength; 
+                                                                 nameIndex++ )
+           {
+            name[ nameIndex ] = (char)( 'A' + nextRandom( &state ) % 26 );
+           }
+
+        // member shuffle from row index, first member unshuffled
+        state = settings->seed ^ (unsigned long long)rowIndex;
+
+        for( nameIndex = settings->familyNameLength - 1; 
+                   nameIndex > 0 && rowIndex % settings->familySize != 0;
+                                                                 nameIndex-- )
+           {
+            swapIndex = (int)( nextRandom( &state ) % ( nameIndex + 1 ) );
+            swapChar = name[ nameIndex ];
+            name[ nameIndex ] = name[ swapIndex ];
+            name[ swapIndex ] = swapChar;
+           }
+
+        name[ settings->familyNameLength ] = NULL_CHAR;
+
+        return settings->familyNameLength;
+       }
+
+    state = settings->seed ^ ( (unsigned long long)rowIndex << 1 );
+
+    // length from distribution
+    if( settings->lengthDistribution == NORMAL_LENGTHS )
+       {
+        unitOne = ( ( nextRandom( &state ) >> 11 ) + 1.0 ) 
+                                                   / 9007199254740993.0;
+        unitTwo = ( nextRandom( &state ) >> 11 ) / 9007199254740992.0;
+        spread = ( settings->maxNameLength - settings->minNameLength ) / 6.0;
+
+        length = (int)floor( ( settings->minNameLength 
+                                      + settings->maxNameLength ) / 2.0 + 0.5
+                 + spread * sqrt( -2.0 * log( unitOne ) ) 
+                                        * cos( 6.283185307179586 * unitTwo ) );
+
+        length = length < settings->minNameLength ? 
+                                        settings->minNameLength : length;
+        length = length > settings->maxNameLength ? 
+                                        settings->maxNameLength : length;
+       }
+
+    else
+       {
+        length = settings->minNameLength + (int)( nextRandom( &state ) 
+              % ( settings->maxNameLength - settings->minNameLength + 1 ) );
+       }
+
+    // room for capital letter and row index digits
+    do
+       {
+        digitCount++;
+        remaining /= 26;
+       }
+    while( remaining > 0 );
+
+    length = length < digitCount + 1 ? digitCount + 1 : length;
+
+    name[ 0 ] = (char)( 'A' + nextRandom( &state ) % 26 );
+
+    for( nameIndex = 1; nameIndex < length - digitCount; nameIndex++ )
+       {
+        name[ nameIndex ] = (char)( 'a' + nextRandom( &state ) % 26 );
+       }
+
+    for( remaining = rowIndex; nameIndex < length; nameIndex++ )
+       {
+        name[ nameIndex ] = (char)( 'a' + remaining % 26 );
+        remaining /= 26;
+       }
+
+    name[ length ] = NULL_CHAR;
+
+    return length;
+   }
+
+/*
+Name: makeWorkloadTemps
+Process: creates average, lowest, and highest temperatures for row index,
+         the same every time for same settings
+Function input/parameters: settings (const WorkloadSettingsType *),
+                           row index (long long)
+Function output/parameters: three temperatures, in tenths (double *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom
+*/
+void makeWorkloadTemps( double *temps, const WorkloadSettingsType *settings, 
+                                                            long long rowIndex )
+   {
+    unsigned long long state = settings->seed 
+                             ^ ( (unsigned long long)rowIndex * 0x2545F491ULL );
+
+    temps[ 0 ] = ( -100.0 + nextRandom( &state ) % 800 ) / 10.0;
+    temps[ 1 ] = temps[ 0 ] - 5.0 - ( nextRandom( &state ) % 600 ) / 10.0;
+    temps[ 2 ] = temps[ 0 ] + 5.0 + ( nextRandom( &state ) % 600 ) / 10.0;
+   }
+
+/*
+Name: setDefaultWorkloadSettings
+Process: sets generator settings to defaults: 100000 rows, uniform name
+         lengths 4 to 20, no anagram families (64 names of 12 letters each
+         when enabled), CSV output, no operation log, operation mix 
+         10% inserts, 80% finds, 10% removes, Zipf exponent 0.99
+Function input/parameters: none
+Function output/parameters: generator settings (WorkloadSettingsType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void setDefaultWorkloadSettings( WorkloadSettingsType *settings )
+   {
+    settings->rowCount = 100000;
+    settings->minNameLength = 4;
+    settings->maxNameLength = 20;
+    settings->lengthDistribution = UNIFORM_LENGTHS;
+    settings->familyCount = 0;
+    settings->familySize = 64;
+    settings->familyNameLength = 12;
+    settings->binaryOutput = false;
+    settings->dataFileName = "workload.csv";
+    settings->operationCount = 0;
+    settings->insertPercent = 10;
+    settings->findPercent = 80;
+    settings->removePercent = 10;
+    settings->zipfExponent = 0.99;
+    settings->opLogFileName = "workload.ops";
+    settings->seed = 20231;
+   }
+
+/*
+Name: writeOperationLog
+Process: writes operation log, one operation per line:
+         "I,name,average,lowest,highest" inserts a new row,
+         "F,name" finds and "R,name" removes a data set row
+         picked with Zipfian skew (anagram families are the hottest rows),
+         operations picked by mix percentages
+Function input/parameters: settings (const WorkloadSettingsType *)
+Function output/parameters: none
+Function output/returned: number of operations written, 
+                          or -1 on failure (long long)
+Device input/---: none
+Device output/file: operation log to HD
+Dependencies: fopen, initializeZipfGenerator, nextRandom, getZipfRank,
+              makeWorkloadName, makeWorkloadTemps, fprintf, ferror, fclose
+*/
+long long writeOperationLog( const WorkloadSettingsType *settings )
+   {
+    FILE *outFilePtr = fopen( settings->opLogFileName, "w" );
+    ZipfGeneratorType zipf;
+    unsigned long long randomState = settings->seed * 31 + 7;
+    long long opIndex, insertedCount = 0;
+    char name[ STD_STR_LEN ];
+    double temps[ 3 ];
+    int choice;
+    bool success;
+
+    if( outFilePtr == NULL )
+       {
+        return -1;
+       }
+
+    initializeZipfGenerator( &zipf, settings->rowCount, settings->zipfExponent );
+
+    for( opIndex = 0; opIndex < settings->operationCount; opIndex++ )
+       {
+        choice = (int)( nextRandom( &randomState ) % 100 );
+
+        // new rows continue after data set rows
+        if( choice < settings->insertPercent )
+           {
+            makeWorkloadName( name, settings, 
+                                         settings->rowCount + insertedCount );
+            makeWorkloadTemps( temps, settings, 
+                                         settings->rowCount + insertedCount );
+
+            fprintf( outFilePtr, "I,%s,%.1f,%.1f,%.1f\n", 
+                                      name, temps[ 0 ], temps[ 1 ], temps[ 2 ] );
+
+            insertedCount++;
+           }
+
+        else
+           {
+            makeWorkloadName( name, settings, 
+                                      getZipfRank( &zipf, &randomState ) );
+
+            fprintf( outFilePtr, "%c,%s\n", 
+                   choice < settings->insertPercent + settings->findPercent ? 
+                                                            'F' : 'R', name );
+           }
+       }
+
+    success = !ferror( outFilePtr );
+    success = fclose( outFilePtr ) == 0 && success;
+
+    return success ? opIndex : -1;
+   }
+
+/*
+Name: writeWorkloadData
+Process: writes data set rows as CSV file in uploadData format,
+         or as binary data file
+Function input/parameters: settings (const WorkloadSettingsType *)
+Function output/parameters: none
+Function output/returned: number of rows written, or -1 on failure 
+                          (long long)
+Device input/---: none
+Device output/file: data set to HD
+Dependencies: openBinaryDataWriter, fopen, makeWorkloadName, 
+              makeWorkloadTemps, writeBinaryRecord, fprintf, ferror, fclose,
+              closeBinaryDataWriter
+*/
+long long writeWorkloadData( const WorkloadSettingsType *settings )
+   {
+    BinaryDataWriterType *writer = NULL;
+    FILE *outFilePtr = NULL;
+    long long rowIndex;
+    char name[ STD_STR_LEN ];
+    double temps[ 3 ];
+    int nameLength;
+    bool success = true;
+
+    if( settings->binaryOutput )
+       {
+        writer = openBinaryDataWriter( settings->dataFileName );
+        success = writer != NULL;
+       }
+
+    else
+       {
+        outFilePtr = fopen( settings->dataFileName, "w" );
+        success = outFilePtr != NULL;
+       }
+
+    for( rowIndex = 0; rowIndex < settings->rowCount && success; rowIndex++ )
+       {
+        nameLength = makeWorkloadName( name, settings, rowIndex );
+        makeWorkloadTemps( temps, settings, rowIndex );
+
+        if( writer != NULL )
+           {
+            success = writeBinaryRecord( writer, name, nameLength, 
+                                           temps[ 0 ], temps[ 1 ], temps[ 2 ] );
+           }
+
+        else
+           {
+            success = fprintf( outFilePtr, "%s,%.1f,%.1f,%.1f\n", name, 
+                                      temps[ 0 ], temps[ 1 ], temps[ 2 ] ) > 0;
+           }
+       }
+
+    if( writer != NULL )
+       {
+        return closeBinaryDataWriter( writer, success );
+       }
+
+    if( outFilePtr != NULL )
+       {
+        success = !ferror( outFilePtr ) && success;
+        success = fclose( outFilePtr ) == 0 && success;
+       }
+
+    return success ? rowIndex : -1;
+   }
@@ -0,0 +1,128 @@
+/*
+Workload utility, function prototypes
+
+Synthetic state temperature data sets and operation logs: configurable
+row counts and name lengths, anagram families that collide under
+getHashIndex, and Zipfian skew over the rows an operation log touches.
+Rows are made from the row index and seed, so they can be rebuilt
+without keeping the data set in memory.
+*/
+
+// PreProcessor test
+#ifndef WORKLOAD_UTILITY_H
+#define WORKLOAD_UTILITY_H
+
+// header files
+#include <stdbool.h>
+#include "StandardConstants.h"
+
+// data structures
+
+    // name length distributions
+    typedef enum { UNIFORM_LENGTHS, NORMAL_LENGTHS } LengthDistributionType;
+
+    // data set and operation log settings
+    typedef struct WorkloadSettingsStruct
+       {
+        long long rowCount;
+        int minNameLength, maxNameLength;
+        LengthDistributionType lengthDistribution;
+        long long familyCount;
+        long long familySize;
+        int familyNameLength;
+        bool binaryOutput;
+        const char *dataFileName;
+        long long operationCount;
+        int insertPercent, findPercent, removePercent;
+        double zipfExponent;
+        const char *opLogFileName;
+        unsigned long long seed;
+       } WorkloadSettingsType;
+
+// function prototypes
+
+/*
+Name: makeWorkloadName
+Process: creates name for row index, the same every time for same settings,
+         rows below family count times family size are anagram families,
+         each family a shuffle of one set of upper case letters, 
+         so all members share a hash index under getHashIndex,
+         other rows are an upper case letter, random lower case letters,
+         and the row index in lower case base 26, so they are unique,
+         names are lengthened when needed to hold the row index
+Function input/parameters: settings (const WorkloadSettingsType *),
+                           row index (long long)
+Function output/parameters: name (char *)
+Function output/returned: name length (int)
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom, sqrt, log, cos
+*/
+int makeWorkloadName( char *name, const WorkloadSettingsType *settings, 
+                                                            long long rowIndex );
+
+/*
+Name: makeWorkloadTemps
+Process: creates average, lowest, and highest temperatures for row index,
+         the same every time for same settings
+Function input/parameters: settings (const WorkloadSettingsType *),
+                           row index (long long)
+Function output/parameters: three temperatures, in tenths (double *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom
+*/
+void makeWorkloadTemps( double *temps, const WorkloadSettingsType *settings, 
+                                                            long long rowIndex );
+
+/*
+Name: setDefaultWorkloadSettings
+Process: sets generator settings to defaults: 100000 rows, uniform name
+         lengths 4 to 20, no anagram families (64 names of 12 letters each
+         when enabled), CSV output, no operation log, operation mix 
+         10% inserts, 80% finds, 10% removes, Zipf exponent 0.99
+Function input/parameters: none
+Function output/parameters: generator settings (WorkloadSettingsType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void setDefaultWorkloadSettings( WorkloadSettingsType *settings );
+
+/*
+Name: writeOperationLog
+Process: writes operation log, one operation per line:
+         "I,name,average,lowest,highest" inserts a new row,
+         "F,name" finds and "R,name" removes a data set row
+         picked with Zipfian skew (anagram families are the hottest rows),
+         operations picked by mix percentages
+Function input/parameters: settings (const WorkloadSettingsType *)
+Function output/parameters: none
+Function output/returned: number of operations written, 
+                          or -1 on failure (long long)
+Device input/---: none
+Device output/file: operation log to HD
+Dependencies: fopen, initializeZipfGenerator, nextRandom, getZipfRank,
+              makeWorkloadName, makeWorkloadTemps, fprintf, ferror, fclose
+*/
+long long writeOperationLog( const WorkloadSettingsType *settings );
+
+/*
+Name: writeWorkloadData
+Process: writes data set rows as CSV file in uploadData format,
+         or as binary data file
+Function input/parameters: settings (const WorkloadSettingsType *)
+Function output/parameters: none
+Function output/returned: number of rows written, or -1 on failure 
+                          (long long)
+Device input/---: none
+Device output/file: data set to HD
+Dependencies: openBinaryDataWriter, fopen, makeWorkloadName, 
+              makeWorkloadTemps, writeBinaryRecord, fprintf, ferror, fclose,
+              closeBinaryDataWriter
+*/
+long long writeWorkloadData( const WorkloadSettingsType *settings );
+
+#endif  // WORKLOAD_UTILITY_H
@@ -0,0 +1,1163 @@
+/*
+Write ahead log utility, function implementations
+*/
+
+// header files
+#include "Write_Ahead_Log_Utility.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// constants
+
+// bytes of record before name, checksum, operation, name length
+#define WAL_RECORD_PREFIX_SIZE 6
+
+// longest record, name of STD_STR_LEN - 1 characters
+#define WAL_MAX_RECORD_SIZE \
+               ( WAL_RECORD_PREFIX_SIZE + STD_STR_LEN + 3 * sizeof( double ) )
+
+// local function prototypes, used only in this file
+
+    int compareCheckpointNodes( const void *one, const void *other );
+    int encodeWalRecord( unsigned char *record, WalOperationType operation,
+                                                 const StateDataType *item );
+    uint32_t getWalChecksum( const unsigned char *bytes, size_t length );
+    bool logWalRecord( WriteAheadLogType *wal, WalOperationType operation,
+                                                 const StateDataType *item );
+    bool readCheckpointNumber( const char *checkpointFileName,
+                                                uint64_t *checkpointNumber );
+    bool readWalHeader( FILE *inFilePtr, uint64_t *checkpointNumber );
+    int readWalRecord( FILE *inFilePtr, WalOperationType *operation,
+                                                       StateDataType *item );
+    void *runWalFlusher( void *flusherData );
+    bool syncFileName( const char *fileName );
+    void takeCheckpointNode( const StateDataType *node,
+                       const StateDataType **nodes, int count,
+                       const StateDataType **ordered, int *orderedCount );
+    bool writeCheckpointName( BinaryDataWriterType *writer,
+                                const ProbingHashType *hash,
+                                const StateDataType **nodes, int count );
+    bool writeWalBytes( int fileDescriptor, const unsigned char *bytes,
+                                                              size_t length );
+    bool writeWalHeader( int fileDescriptor, uint64_t checkpointNumber );
+
+/*
+Name: checkpointWriteAheadLog
+Process: writes every item in use in table to checkpoint file, with
+         next checkpoint number, through temporary file synced and
+         renamed over it, then empties log; node of each item is written
+         too, so recovery into open addressing table of same layout
+         puts items back in their nodes; items of a name are written in
+         order finds reach them, so loading gives them same order;
+         table must hold every change logged so far
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (const ProbingHashType *),
+                           checkpoint file name (const char *)
+Function output/parameters: updated log, emptied (WriteAheadLogType *)
+Function output/returned: number of items written,
+                          or -1 if checkpoint could not be written (int)
+Device input/---: none
+Device output/file: checkpoint and emptied log to HD
+Dependencies: syncWriteAheadLog, malloc, sprintf, openBinaryDataWriter,
+              qsort, compareCheckpointNodes, strcmp, writeCheckpointName,
+              closeBinaryDataWriter, free, syncFileName, rename,
+              pthread_mutex_lock, pthread_cond_wait, ftruncate,
+              writeWalHeader, fsync, pthread_mutex_unlock
+*/
+int checkpointWriteAheadLog( WriteAheadLogType *wal,
+                   const ProbingHashType *hash, const char *checkpointFileName )
+   {
+    BinaryDataWriterType *writer;
+    const StateDataType **nodes;
+    char *tempFileName;
+    long long writtenCount;
+    int index, nodeCount = 0, nameStart, nameEnd;
+    bool success = true;
+
+    // log must not hold records missing from checkpoint when emptied
+    if( !syncWriteAheadLog( wal ) )
+       {
+        return -1;
+       }
+
+    tempFileName = (char *)malloc( strlen( checkpointFileName ) + 5 );
+    sprintf( tempFileName, "%s.tmp", checkpointFileName );
+
+    writer = openBinaryDataWriter( tempFileName );
+
+    if( writer == NULL )
+       {
+        free( tempFileName );
+
+        return -1;
+       }
+
+    // nodes sorted by name, so items of a name are written together
+    nodes = (const StateDataType **)malloc(
+                      ( hash->tableSize + 1 ) * sizeof( const StateDataType * ) );
+    success = nodes != NULL;
+
+    for( index = 0; success && index < hash->tableSize; index++ )
+       {
+        if( hash->array[ index ].inUse )
+           {
+            nodes[ nodeCount ] = &hash->array[ index ];
+            nodeCount++;
+           }
+       }
+
+    if( success )
+       {
+        qsort( nodes, nodeCount, sizeof( const StateDataType * ),
+                                                    compareCheckpointNodes );
+       }
+
+    for( nameStart = 0; success && nameStart < nodeCount;
+                                                       nameStart = nameEnd )
+       {
+        for( nameEnd = nameStart + 1; nameEnd < nodeCount
+                  && strcmp( nodes[ nameEnd ]->name,
+                                       nodes[ nameStart ]->name ) == 0;
+                                                                 nameEnd++ );
+
+        success = writeCheckpointName( writer, hash, &nodes[ nameStart ],
+                                                       nameEnd - nameStart );
+       }
+
+    writer->header.checkpointNumber = wal->checkpointNumber + 1;
+    writer->header.tableSize = (uint64_t)hash->tableSize;
+    writer->header.probeStrategy = (uint64_t)hash->probeStrategy;
+    writtenCount = closeBinaryDataWriter( writer, success );
+
+    free( nodes );
+
+    // checkpoint replaces last one only once it is all on disk
+    success = writtenCount >= 0 && syncFileName( tempFileName )
+                              && rename( tempFileName, checkpointFileName ) == 0;
+
+    free( tempFileName );
+
+    if( !success )
+       {
+        return -1;
+       }
+
+    // crash before log is emptied leaves it older than new checkpoint,
+    // so it is not replayed
+    wal->checkpointNumber++;
+
+    pthread_mutex_lock( &wal->lock );
+
+    while( wal->flushing )
+       {
+        pthread_cond_wait( &wal->flushDone, &wal->lock );
+       }
+
+    success = !wal->failed && ftruncate( wal->fileDescriptor, 0 ) == 0
+                           && writeWalHeader( wal->fileDescriptor,
+                                                      wal->checkpointNumber )
+                           && fsync( wal->fileDescriptor ) == 0;
+
+    wal->failed = wal->failed || !success;
+
+    pthread_mutex_unlock( &wal->lock );
+
+    return success ? (int)writtenCount : -1;
+   }
+
+/*
+Name: closeWriteAheadLog
+Process: flushes and syncs records still buffered, stops flusher,
+         closes log file and releases log
+Function input/parameters: log (WriteAheadLogType *)
+Function output/parameters: none
+Function output/returned: false if a write or sync failed (bool)
+Device input/---: none
+Device output/file: buffered records to HD
+Dependencies: pthread_mutex_lock, pthread_cond_signal,
+              pthread_mutex_unlock, pthread_join, close,
+              pthread_mutex_destroy, pthread_cond_destroy, free
+*/
+bool closeWriteAheadLog( WriteAheadLogType *wal )
+   {
+    bool success;
+
+    // flusher writes what is buffered before it stops
+    pthread_mutex_lock( &wal->lock );
+
+    wal->stopping = true;
+    pthread_cond_signal( &wal->flushNeeded );
+
+    pthread_mutex_unlock( &wal->lock );
+
+    pthread_join( wal->flusher, NULL );
+
+    success = !wal->failed && close( wal->fileDescriptor ) == 0;
+
+    pthread_mutex_destroy( &wal->lock );
+    pthread_cond_destroy( &wal->flushNeeded );
+    pthread_cond_destroy( &wal->flushDone );
+
+    free( wal->buffers[ 0 ] );
+    free( wal->buffers[ 1 ] );
+    free( wal );
+
+    return success;
+   }
+
+/*
+Name: compareCheckpointNodes
+Process: compares table nodes by name, then by place in table array,
+         for qsort
+Function input/parameters: nodes (const void *, const StateDataType **)
+Function output/parameters: none
+Function output/returned: negative, zero, or positive (int)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp
+*/
+int compareCheckpointNodes( const void *one, const void *other )
+   {
+    const StateDataType *oneNode = *(const StateDataType * const *)one;
+    const StateDataType *otherNode = *(const StateDataType * const *)other;
+    int nameResult = strcmp( oneNode->name, otherNode->name );
+
+    if( nameResult != 0 )
+       {
+        return nameResult;
+       }
+
+    return oneNode < otherNode ? -1 : ( oneNode > otherNode ? 1 : 0 );
+   }
+
+/*
+Name: encodeWalRecord
+Process: writes log record of operation on item, names longer than
+         STD_STR_LEN - 1 are truncated as they would be in the table
+Function input/parameters: operation (WalOperationType),
+                           item (const StateDataType *)
+Function output/parameters: record, at least WAL_MAX_RECORD_SIZE bytes
+                            (unsigned char *)
+Function output/returned: record size in bytes (int)
+Device input/---: none
+Device output/---: none
+Dependencies: getStringLength, memcpy, getWalChecksum
+*/
+int encodeWalRecord( unsigned char *record, WalOperationType operation,
+                                                  const StateDataType *item )
+   {
+    double temps[ 3 ] = { item->averageTemp, item->lowestTemp,
+                                                         item->highestTemp };
+    int nameLength = getStringLength( item->name );
+    int recordSize;
+    uint32_t checksum;
+
+    nameLength = nameLength < STD_STR_LEN - 1 ? nameLength : STD_STR_LEN - 1;
+    recordSize = WAL_RECORD_PREFIX_SIZE + nameLength + sizeof( temps );
+
+    record[ 4 ] = (unsigned char)operation;
+    record[ 5 ] = (unsigned char)nameLength;
+
+    memcpy( &record[ WAL_RECORD_PREFIX_SIZE ], item->name, nameLength );
+    memcpy( &record[ WAL_RECORD_PREFIX_SIZE + nameLength ], temps,
+                                                            sizeof( temps ) );
+
+    // checksum finds record cut short by crash
+    checksum = getWalChecksum( &record[ 4 ], recordSize - 4 );
+    memcpy( record, &checksum, sizeof( checksum ) );
+
+    return recordSize;
+   }
+
+/*
+Name: getWalChecksum
+Process: finds FNV-1a checksum of given bytes
+Function input/parameters: bytes (const unsigned char *), length (size_t)
+Function output/parameters: none
+Function output/returned: checksum (uint32_t)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+uint32_t getWalChecksum( const unsigned char *bytes, size_t length )
+   {
+    uint32_t checksum = 2166136261u;
+    size_t index;
+
+    for( index = 0; index < length; index++ )
+       {
+        checksum = ( checksum ^ bytes[ index ] ) * 16777619u;
+       }
+
+    return checksum;
+   }
+
+/*
+Name: insertLoggedItem
+Process: adds item as addItemFromStruct, then logs insert if it was
+         added
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           new item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *)
+Function output/returned: false if item could not be added, or was
+                          added but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: addItemFromStruct, logWalRecord
+*/
+bool insertLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                                                      StateDataType newItem )
+   {
+    // change that fails leaves nothing to replay
+    return addItemFromStruct( hash, newItem )
+                                  && logWalRecord( wal, WAL_INSERT, &newItem );
+   }
+
+/*
+Name: logWalRecord
+Process: copies record of operation into active buffer, waiting for
+         flusher if buffer is full; with zero durability window, waits
+         until record is synced
+Function input/parameters: log (WriteAheadLogType *),
+                           operation (WalOperationType),
+                           item (const StateDataType *)
+Function output/parameters: updated log (WriteAheadLogType *)
+Function output/returned: false if log has failed (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_cond_signal, pthread_cond_wait,
+              encodeWalRecord, pthread_mutex_unlock
+*/
+bool logWalRecord( WriteAheadLogType *wal, WalOperationType operation,
+                                                  const StateDataType *item )
+   {
+    long long sequence;
+    bool success;
+
+    pthread_mutex_lock( &wal->lock );
+
+    while( !wal->failed
+                && wal->bufferLength + WAL_MAX_RECORD_SIZE > WAL_BUFFER_SIZE )
+       {
+        wal->urgent = true;
+        pthread_cond_signal( &wal->flushNeeded );
+        pthread_cond_wait( &wal->flushDone, &wal->lock );
+       }
+
+    if( !wal->failed )
+       {
+        // flusher sleeps while buffer is empty
+        if( wal->bufferLength == 0 )
+           {
+            pthread_cond_signal( &wal->flushNeeded );
+           }
+
+        wal->bufferLength += encodeWalRecord(
+                 &wal->buffers[ wal->activeBuffer ][ wal->bufferLength ],
+                                                            operation, item );
+        wal->loggedCount++;
+        sequence = wal->loggedCount;
+
+        if( wal->windowMicroseconds == 0
+                              || wal->bufferLength > WAL_BUFFER_SIZE / 2 )
+           {
+            wal->urgent = true;
+            pthread_cond_signal( &wal->flushNeeded );
+           }
+
+        // records logged while this waits share its sync
+        while( wal->windowMicroseconds == 0 && !wal->failed
+                                            && wal->durableCount < sequence )
+           {
+            pthread_cond_wait( &wal->flushDone, &wal->lock );
+           }
+       }
+
+    success = !wal->failed;
+
+    pthread_mutex_unlock( &wal->lock );
+
+    return success;
+   }
+
+/*
+Name: openWriteAheadLog
+Process: opens log file for appending, creating it with header if
+         missing, empty, or older than checkpoint, cutting any partly
+         written last record, and starts flusher
+Function input/parameters: log and checkpoint file names (const char *),
+                           durability window in microseconds, zero to
+                           make each change durable before it returns
+                           (long long)
+Function output/parameters: none
+Function output/returned: pointer to log, or NULL if file could not be
+                          opened, is not a log file, or follows a
+                          checkpoint newer than one on disk
+                          (WriteAheadLogType *)
+Device input/file: checkpoint header and existing log records from HD
+Device output/file: header to HD
+Dependencies: readCheckpointNumber, fopen, fseek, ftell, rewind,
+              readWalHeader, readWalRecord, fclose, open, ftruncate,
+              writeWalHeader, close, malloc, free, pthread_mutex_init,
+              pthread_cond_init, pthread_create
+*/
+WriteAheadLogType *openWriteAheadLog( const char *logFileName,
+               const char *checkpointFileName, long long windowMicroseconds )
+   {
+    WriteAheadLogType *wal;
+    FILE *inFilePtr;
+    WalOperationType operation;
+    StateDataType item;
+    uint64_t checkpointNumber, logCheckpointNumber;
+    long validLength = 0;
+    int recordSize, fileDescriptor;
+    bool success;
+
+    if( !readCheckpointNumber( checkpointFileName, &checkpointNumber ) )
+       {
+        return NULL;
+       }
+
+    inFilePtr = fopen( logFileName, "rb" );
+
+    // keep whole records of existing log, log older than checkpoint
+    // is held by it and starts again
+    if( inFilePtr != NULL )
+       {
+        fseek( inFilePtr, 0, SEEK_END );
+
+        if( ftell( inFilePtr ) > 0 )
+           {
+            rewind( inFilePtr );
+
+            if( !readWalHeader( inFilePtr, &logCheckpointNumber )
+                                  || logCheckpointNumber > checkpointNumber )
+               {
+                fclose( inFilePtr );
+
+                return NULL;
+               }
+
+            if( logCheckpointNumber == checkpointNumber )
+               {
+                validLength = sizeof( WalHeaderType );
+
+                while( ( recordSize = readWalRecord( inFilePtr, &operation,
+                                                              &item ) ) > 0 )
+                   {
+                    validLength += recordSize;
+                   }
+               }
+           }
+
+        fclose( inFilePtr );
+       }
+
+    fileDescriptor = open( logFileName, O_WRONLY | O_CREAT | O_APPEND, 0644 );
+
+    if( fileDescriptor < 0 )
+       {
+        return NULL;
+       }
+
+    success = ftruncate( fileDescriptor, validLength ) == 0
+               && ( validLength > 0
+                         || writeWalHeader( fileDescriptor, checkpointNumber ) );
+
+    wal = (WriteAheadLogType *)malloc( sizeof( WriteAheadLogType ) );
+
+    if( !success || wal == NULL )
+       {
+        close( fileDescriptor );
+        free( wal );
+
+        return NULL;
+       }
+
+    wal->fileDescriptor = fileDescriptor;
+    wal->checkpointNumber = checkpointNumber;
+    wal->buffers[ 0 ] = (unsigned char *)malloc( WAL_BUFFER_SIZE );
+    wal->buffers[ 1 ] = (unsigned char *)malloc( WAL_BUFFER_SIZE );
+    wal->activeBuffer = 0;
+    wal->bufferLength = 0;
+    wal->windowMicroseconds = windowMicroseconds > 0 ? windowMicroseconds : 0;
+    wal->flushing = false;
+    wal->urgent = false;
+    wal->stopping = false;
+    wal->failed = false;
+    wal->loggedCount = 0;
+    wal->durableCount = 0;
+    wal->syncCount = 0;
+    wal->bytesWritten = 0;
+
+    pthread_mutex_init( &wal->lock, NULL );
+    pthread_cond_init( &wal->flushNeeded, NULL );
+    pthread_cond_init( &wal->flushDone, NULL );
+
+    if( wal->buffers[ 0 ] == NULL || wal->buffers[ 1 ] == NULL
+         || pthread_create( &wal->flusher, NULL, runWalFlusher, wal ) != 0 )
+       {
+        pthread_mutex_destroy( &wal->lock );
+        pthread_cond_destroy( &wal->flushNeeded );
+        pthread_cond_destroy( &wal->flushDone );
+
+        close( fileDescriptor );
+        free( wal->buffers[ 0 ] );
+        free( wal->buffers[ 1 ] );
+        free( wal );
+
+        return NULL;
+       }
+
+    return wal;
+   }
+
+/*
+Name: readCheckpointNumber
+Process: reads number of checkpoint from its header, zero if there
+         is no checkpoint file
+Function input/parameters: checkpoint file name (const char *)
+Function output/parameters: checkpoint number (uint64_t *)
+Function output/returned: false if file is not a checkpoint (bool)
+Device input/file: checkpoint header from HD
+Device output/---: none
+Dependencies: fopen, fread, fclose, memcmp
+*/
+bool readCheckpointNumber( const char *checkpointFileName,
+                                                 uint64_t *checkpointNumber )
+   {
+    FILE *inFilePtr = fopen( checkpointFileName, "rb" );
+    BinaryDataHeaderType header;
+    bool success;
+
+    *checkpointNumber = 0;
+
+    if( inFilePtr == NULL )
+       {
+        return true;
+       }
+
+    success = fread( &header, sizeof( header ), 1, inFilePtr ) == 1;
+
+    fclose( inFilePtr );
+
+    // binary data file written by anything else has number zero
+    if( !success || memcmp( header.magic, BINARY_DATA_MAGIC,
+                                               sizeof( header.magic ) ) != 0
+         || header.version != BINARY_DATA_VERSION
+         || header.checkpointNumber == 0 )
+       {
+        return false;
+       }
+
+    *checkpointNumber = header.checkpointNumber;
+
+    return true;
+   }
+
+/*
+Name: readWalHeader
+Process: reads log header, checks magic and version
+Function input/parameters: log file (FILE *)
+Function output/parameters: number of checkpoint log follows (uint64_t *)
+Function output/returned: true if header is valid (bool)
+Device input/file: header from HD
+Device output/---: none
+Dependencies: fread, memcmp
+*/
+bool readWalHeader( FILE *inFilePtr, uint64_t *checkpointNumber )
+   {
+    WalHeaderType header;
+
+    if( fread( &header, sizeof( header ), 1, inFilePtr ) != 1
+         || memcmp( header.magic, WAL_MAGIC, sizeof( header.magic ) ) != 0
+         || header.version != WAL_VERSION )
+       {
+        return false;
+       }
+
+    *checkpointNumber = header.checkpointNumber;
+
+    return true;
+   }
+
+/*
+Name: readWalRecord
+Process: reads next log record, item is set in use
+Function input/parameters: log file (FILE *)
+Function output/parameters: operation (WalOperationType *),
+                            item (StateDataType *)
+Function output/returned: record size in bytes, or zero at end of log
+                          or at record cut short or not valid (int)
+Device input/file: record from HD
+Device output/---: none
+Dependencies: fread, memcpy, getWalChecksum, setHashNodeFromData
+*/
+int readWalRecord( FILE *inFilePtr, WalOperationType *operation,
+                                                        StateDataType *item )
+   {
+    unsigned char record[ WAL_MAX_RECORD_SIZE ];
+    char name[ STD_STR_LEN ];
+    double temps[ 3 ];
+    int nameLength, recordSize;
+    uint32_t checksum;
+
+    if( fread( record, WAL_RECORD_PREFIX_SIZE, 1, inFilePtr ) != 1 )
+       {
+        return 0;
+       }
+
+    nameLength = record[ 5 ];
+    recordSize = WAL_RECORD_PREFIX_SIZE + nameLength + sizeof( temps );
+
+    if( nameLength > STD_STR_LEN - 1
+         || fread( &record[ WAL_RECORD_PREFIX_SIZE ],
+                      recordSize - WAL_RECORD_PREFIX_SIZE, 1, inFilePtr ) != 1 )
+       {
+        return 0;
+       }
+
+    memcpy( &checksum, record, sizeof( checksum ) );
+
+    if( checksum != getWalChecksum( &record[ 4 ], recordSize - 4 )
+                  || record[ 4 ] < WAL_INSERT || record[ 4 ] > WAL_UPSERT )
+       {
+        return 0;
+       }
+
+    *operation = (WalOperationType)record[ 4 ];
+
+    memcpy( name, &record[ WAL_RECORD_PREFIX_SIZE ], nameLength );
+    name[ nameLength ] = NULL_CHAR;
+
+    memcpy( temps, &record[ WAL_RECORD_PREFIX_SIZE + nameLength ],
+                                                             sizeof( temps ) );
+
+    setHashNodeFromData( item, name, temps[ 0 ], temps[ 1 ], temps[ 2 ],
+                                                                   USED_NODE );
+
+    return recordSize;
+   }
+
+/*
+Name: recoverHashTable
+Process: loads last checkpoint into empty table, if there is one,
+         then replays log onto it up to its last whole record, unless
+         log is older than checkpoint; missing checkpoint or log is
+         an empty one
+Function input/parameters: hash table (ProbingHashType *),
+                           checkpoint and log file names (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of log records replayed, or -1 if
+                          checkpoint or log is not valid, or log follows
+                          a newer checkpoint (long long)
+Device input/file: checkpoint and log from HD
+Device output/---: none
+Dependencies: readCheckpointNumber, restoreDataFromBinary, fopen, fgetc,
+              fclose, rewind, readWalHeader, readWalRecord, removeState,
+              addItemFromStruct, upsertItem
+*/
+long long recoverHashTable( ProbingHashType *hash,
+                       const char *checkpointFileName, const char *logFileName )
+   {
+    FILE *inFilePtr;
+    WalOperationType operation;
+    StateDataType item, removed;
+    uint64_t checkpointNumber, logCheckpointNumber;
+    long long replayedCount = 0;
+
+    if( !readCheckpointNumber( checkpointFileName, &checkpointNumber )
+         || ( checkpointNumber > 0
+                  && restoreDataFromBinary( hash, checkpointFileName ) < 0 ) )
+       {
+        return -1;
+       }
+
+    inFilePtr = fopen( logFileName, "rb" );
+
+    if( inFilePtr == NULL )
+       {
+        return 0;
+       }
+
+    // empty log file was never given its header
+    if( fgetc( inFilePtr ) == EOF )
+       {
+        fclose( inFilePtr );
+
+        return 0;
+       }
+
+    rewind( inFilePtr );
+
+    if( !readWalHeader( inFilePtr, &logCheckpointNumber )
+                                  || logCheckpointNumber > checkpointNumber )
+       {
+        fclose( inFilePtr );
+
+        return -1;
+       }
+
+    // log older than checkpoint holds only changes already in it
+    while( logCheckpointNumber == checkpointNumber
+                       && readWalRecord( inFilePtr, &operation, &item ) > 0 )
+       {
+        if( operation == WAL_REMOVE )
+           {
+            removeState( &removed, item, *hash );
+           }
+
+        else if( operation == WAL_INSERT )
+           {
+            addItemFromStruct( hash, item );
+           }
+
+        else
+           {
+            upsertItem( hash, item );
+           }
+
+        replayedCount++;
+       }
+
+    fclose( inFilePtr );
+
+    return replayedCount;
+   }
+
+/*
+Name: removeLoggedItem
+Process: removes item as removeState, then logs removal if it was
+         removed
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           search item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *),
+                            removed state (StateDataType *)
+Function output/returned: false if item was not found, or was removed
+                          but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: removeState, logWalRecord
+*/
+bool removeLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                       StateDataType toBeRemoved, StateDataType *removedState )
+   {
+    return removeState( removedState, toBeRemoved, *hash )
+                           && logWalRecord( wal, WAL_REMOVE, &toBeRemoved );
+   }
+
+/*
+Name: runWalFlusher
+Process: flusher thread, waits for records, then for durability window
+         unless flush is urgent, then writes and syncs active buffer
+         while records are logged to the other one, until log closes
+Function input/parameters: log (void *)
+Function output/parameters: updated log (void *)
+Function output/returned: NULL (void *)
+Device input/---: none
+Device output/file: records to HD
+Dependencies: pthread_mutex_lock, pthread_cond_wait, clock_gettime,
+              pthread_cond_timedwait, pthread_cond_broadcast,
+              pthread_mutex_unlock, writeWalBytes, fdatasync
+*/
+void *runWalFlusher( void *flusherData )
+   {
+    WriteAheadLogType *wal = (WriteAheadLogType *)flusherData;
+    struct timespec deadline;
+    unsigned char *buffer;
+    size_t length;
+    long long targetCount;
+    bool success;
+
+    pthread_mutex_lock( &wal->lock );
+
+    while( true )
+       {
+        while( !wal->stopping && wal->bufferLength == 0 )
+           {
+            pthread_cond_wait( &wal->flushNeeded, &wal->lock );
+           }
+
+        if( wal->bufferLength == 0 )
+           {
+            break;
+           }
+
+        // gather records logged within window into one sync
+        if( !wal->urgent && !wal->stopping )
+           {
+            clock_gettime( CLOCK_REALTIME, &deadline );
+
+            deadline.tv_sec += wal->windowMicroseconds / 1000000;
+            deadline.tv_nsec += ( wal->windowMicroseconds % 1000000 ) * 1000;
+
+            if( deadline.tv_nsec >= 1000000000 )
+               {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+               }
+
+            while( !wal->urgent && !wal->stopping
+                   && pthread_cond_timedwait( &wal->flushNeeded, &wal->lock,
+                                                  &deadline ) != ETIMEDOUT );
+           }
+
+        buffer = wal->buffers[ wal->activeBuffer ];
+        length = wal->bufferLength;
+        targetCount = wal->loggedCount;
+
+        wal->activeBuffer = 1 - wal->activeBuffer;
+        wal->bufferLength = 0;
+        wal->urgent = false;
+        wal->flushing = true;
+
+        // writers waiting for space go on with the other buffer
+        pthread_cond_broadcast( &wal->flushDone );
+
+        pthread_mutex_unlock( &wal->lock );
+
+        success = writeWalBytes( wal->fileDescriptor, buffer, length )
+                                        && fdatasync( wal->fileDescriptor ) == 0;
+
+        pthread_mutex_lock( &wal->lock );
+
+        wal->flushing = false;
+
+        if( success )
+           {
+            wal->durableCount = targetCount;
+            wal->syncCount++;
+            wal->bytesWritten += length;
+           }
+
+        else
+           {
+            wal->failed = true;
+           }
+
+        pthread_cond_broadcast( &wal->flushDone );
+       }
+
+    pthread_mutex_unlock( &wal->lock );
+
+    return NULL;
+   }
+
+/*
+Name: syncFileName
+Process: syncs contents of named file to disk
+Function input/parameters: file name (const char *)
+Function output/parameters: none
+Function output/returned: true if synced (bool)
+Device input/---: none
+Device output/file: file contents to HD
+Dependencies: open, fsync, close
+*/
+bool syncFileName( const char *fileName )
+   {
+    int fileDescriptor = open( fileName, O_RDONLY );
+    bool success;
+
+    if( fileDescriptor < 0 )
+       {
+        return false;
+       }
+
+    success = fsync( fileDescriptor ) == 0;
+
+    return close( fileDescriptor ) == 0 && success;
+   }
+
+/*
+Name: syncWriteAheadLog
+Process: waits until every record logged so far is written and synced,
+         flushing now without waiting for durability window
+Function input/parameters: log (WriteAheadLogType *)
+Function output/parameters: updated log (WriteAheadLogType *)
+Function output/returned: false if a write or sync failed (bool)
+Device input/---: none
+Device output/file: buffered records to HD
+Dependencies: pthread_mutex_lock, pthread_cond_signal, pthread_cond_wait,
+              pthread_mutex_unlock
+*/
+bool syncWriteAheadLog( WriteAheadLogType *wal )
+   {
+    long long targetCount;
+    bool success;
+
+    pthread_mutex_lock( &wal->lock );
+
+    targetCount = wal->loggedCount;
+
+    if( wal->durableCount < targetCount )
+       {
+        wal->urgent = true;
+        pthread_cond_signal( &wal->flushNeeded );
+       }
+
+    while( !wal->failed && wal->durableCount < targetCount )
+       {
+        pthread_cond_wait( &wal->flushDone, &wal->lock );
+       }
+
+    success = !wal->failed;
+
+    pthread_mutex_unlock( &wal->lock );
+
+    return success;
+   }
+
+/*
+Name: upsertLoggedItem
+Process: applies item as upsertItem, then logs upsert if it was applied
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           new item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *)
+Function output/returned: false if item could not be added, or was
+                          applied but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: upsertItem, logWalRecord
+*/
+bool upsertLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                                                      StateDataType newItem )
+   {
+    return upsertItem( hash, newItem )
+                                  && logWalRecord( wal, WAL_UPSERT, &newItem );
+   }
+
+/*
+Name: takeCheckpointNode
+Process: moves given node, if it is one of nodes not yet taken, to end
+         of ordered nodes, leaving NULL in its place
+Function input/parameters: node (const StateDataType *),
+                           nodes of one name (const StateDataType **),
+                           node count (int),
+                           ordered nodes (const StateDataType **),
+                           ordered count (int *)
+Function output/parameters: updated nodes, ordered nodes
+                            (const StateDataType **),
+                            updated ordered count (int *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+void takeCheckpointNode( const StateDataType *node,
+                        const StateDataType **nodes, int count,
+                        const StateDataType **ordered, int *orderedCount )
+   {
+    int index;
+
+    for( index = 0; index < count; index++ )
+       {
+        if( nodes[ index ] == node )
+           {
+            ordered[ *orderedCount ] = node;
+            ( *orderedCount )++;
+
+            nodes[ index ] = NULL;
+
+            return;
+           }
+       }
+   }
+
+/*
+Name: writeCheckpointName
+Process: writes items of one name, with their nodes, in order finds
+         reach them: probe order from home index for open addressing,
+         inline array order for TREE_CHAINING, list order reversed for
+         CHAINING, whose lists add items at front; items in a bucket
+         tree are written in table order
+Function input/parameters: writer (BinaryDataWriterType *),
+                           hash table (const ProbingHashType *),
+                           nodes of one name, in table order
+                           (const StateDataType **), node count (int)
+Function output/parameters: updated writer (BinaryDataWriterType *),
+                            nodes, all set NULL (const StateDataType **)
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: records to HD
+Dependencies: getStringLength, writeBinaryRecord, writeBinaryNodeIndex,
+              malloc, getHashIndexFromView, takeCheckpointNode, free
+*/
+bool writeCheckpointName( BinaryDataWriterType *writer,
+                                const ProbingHashType *hash,
+                                const StateDataType **nodes, int count )
+   {
+    const HashBucketType *bucket;
+    const StateDataType **ordered, *swapped;
+    int nameLength = getStringLength( nodes[ 0 ]->name );
+    int size = hash->tableSize, orderedCount = 0;
+    int index, nodeIndex, step, increment;
+    bool success = true;
+
+    // most names are in table once
+    if( count == 1 )
+       {
+        return writeBinaryRecord( writer, nodes[ 0 ]->name, nameLength,
+                                        nodes[ 0 ]->averageTemp,
+                                        nodes[ 0 ]->lowestTemp,
+                                        nodes[ 0 ]->highestTemp )
+                && writeBinaryNodeIndex( writer,
+                                     (uint64_t)( nodes[ 0 ] - hash->array ) );
+       }
+
+    ordered = (const StateDataType **)malloc(
+                                      count * sizeof( const StateDataType * ) );
+
+    if( ordered == NULL )
+       {
+        return false;
+       }
+
+    index = getHashIndexFromView( hash, nodes[ 0 ]->name, nameLength );
+
+    if( hash->probeStrategy == CHAINING )
+       {
+        bucket = &hash->chains->buckets[ index ];
+        nodeIndex = bucket->root;
+
+        for( step = 0; step < bucket->count; step++ )
+           {
+            takeCheckpointNode( &hash->array[ nodeIndex ], nodes, count,
+                                                      ordered, &orderedCount );
+
+            nodeIndex = hash->chains->links[ nodeIndex ].right;
+           }
+
+        // last of list is loaded first
+        for( step = 0; step < orderedCount / 2; step++ )
+           {
+            swapped = ordered[ step ];
+            ordered[ step ] = ordered[ orderedCount - 1 - step ];
+            ordered[ orderedCount - 1 - step ] = swapped;
+           }
+       }
+
+    else if( hash->probeStrategy == TREE_CHAINING )
+       {
+        bucket = &hash->chains->buckets[ index ];
+
+        for( step = 0; bucket->count <= TREE_BUCKET_INLINE_COUNT
+                                            && step < bucket->count; step++ )
+           {
+            takeCheckpointNode( &hash->array[ bucket->nodes[ step ] ],
+                                        nodes, count, ordered, &orderedCount );
+           }
+       }
+
+    else
+       {
+        // same steps as table's own probe, quadratic increments grow by 4
+        increment = ( hash->probeStrategy == QUADRATIC_PROBING ? 2 : 1 )
+                                                                       % size;
+
+        for( step = 1; step <= size && orderedCount < count; step++ )
+           {
+            takeCheckpointNode( &hash->array[ index ], nodes, count,
+                                                      ordered, &orderedCount );
+
+            index = ( index + increment ) % size;
+
+            if( hash->probeStrategy == QUADRATIC_PROBING )
+               {
+                increment = ( increment + 4 ) % size;
+               }
+           }
+       }
+
+    // nodes in a bucket tree go last, in table order
+    for( index = 0; index < count && orderedCount < count; index++ )
+       {
+        if( nodes[ index ] != NULL )
+           {
+            takeCheckpointNode( nodes[ index ], nodes, count,
+                                                      ordered, &orderedCount );
+           }
+       }
+
+    for( index = 0; success && index < orderedCount; index++ )
+       {
+        success = writeBinaryRecord( writer, ordered[ index ]->name,
+                                     nameLength, ordered[ index ]->averageTemp,
+                                     ordered[ index ]->lowestTemp,
+                                     ordered[ index ]->highestTemp )
+                   && writeBinaryNodeIndex( writer,
+                                (uint64_t)( ordered[ index ] - hash->array ) );
+       }
+
+    free( ordered );
+
+    return success;
+   }
+
+/*
+Name: writeWalBytes
+Process: writes all given bytes to log file, continuing after short
+         or interrupted writes
+Function input/parameters: file descriptor (int),
+                           bytes (const unsigned char *), length (size_t)
+Function output/parameters: none
+Function output/returned: false if a write failed (bool)
+Device input/---: none
+Device output/file: bytes to HD
+Dependencies: write
+*/
+bool writeWalBytes( int fileDescriptor, const unsigned char *bytes,
+                                                               size_t length )
+   {
+    ssize_t written;
+
+    while( length > 0 )
+       {
+        written = write( fileDescriptor, bytes, length );
+
+        if( written < 0 && errno != EINTR )
+           {
+            return false;
+           }
+
+        if( written > 0 )
+           {
+            bytes += written;
+            length -= written;
+           }
+       }
+
+    return true;
+   }
+
+/*
+Name: writeWalHeader
+Process: appends log header to log file
+Function input/parameters: file descriptor (int),
+                           number of checkpoint log follows (uint64_t)
+Function output/parameters: none
+Function output/returned: false if write failed (bool)
+Device input/---: none
+Device output/file: header to HD
+Dependencies: memcpy, writeWalBytes
+*/
+bool writeWalHeader( int fileDescriptor, uint64_t checkpointNumber )
+   {
+    WalHeaderType header;
+
+    memcpy( header.magic, WAL_MAGIC, sizeof( header.magic ) );
+    header.version = WAL_VERSION;
+    header.checkpointNumber = checkpointNumber;
+
+    return writeWalBytes( fileDescriptor, (const unsigned char *)&header,
+                                                            sizeof( header ) );
+   }
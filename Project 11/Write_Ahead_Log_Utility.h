@@ -0,0 +1,253 @@
+/*
+Write ahead log utility, function prototypes
+
+Optional append only log of table changes (insert, remove, upsert),
+so updates survive the process: each change is applied to the table,
+then logged if it was made, so a failed change is never replayed.
+Logged records are copied into an in memory buffer; a
+flusher thread writes and syncs whole buffers (group commit), one sync
+for every change logged since the last one, at least once per
+durability window, so logging costs a buffer copy, not a sync, per
+change. A zero window makes each change durable before it returns,
+changes logged while a sync is running share the next one.
+A checkpoint writes the table as a binary data file (see
+Binary_Data_Utility.h), then empties the log; recovery loads the last
+checkpoint, then replays the log onto it up to its last whole record.
+Layout of log, in native byte order:
+
+   header:  magic "HTWL", version (uint32), number of checkpoint log
+            follows (uint64), zero before first checkpoint
+   records: checksum (uint32) of rest of record, operation (uint8),
+            name length (uint8), name characters (no NULL_CHAR),
+            average, lowest, and highest temperatures (double)
+
+Records are replayed as logged, inserts add an item even if its name
+is in the table. Checkpoints are numbered in their header; a log left
+older than the checkpoint by a crash before it was emptied holds only
+changes the checkpoint has, and is not replayed. A checkpoint holds
+the node of each item, recovery into an open addressing table of the
+same size and probe strategy puts items back in their nodes, so later
+changes replayed land where they did in the live table; chained
+tables get the items of each name in bucket order. So finds on the
+recovered table give the same items, also once some are removed
+(bucket trees of TREE_CHAINING excepted, duplicate names there are
+found in tree order).
+Log calls are made on the thread writing the table.
+*/
+
+// PreProcessor test
+#ifndef WRITE_AHEAD_LOG_UTILITY_H
+#define WRITE_AHEAD_LOG_UTILITY_H
+
+// header files
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "HashUtilities.h"
+#include "Binary_Data_Utility.h"
+
+// constants
+
+    // log file identification and version
+    static const char WAL_MAGIC[ 4 ] = { 'H', 'T', 'W', 'L' };
+    static const uint32_t WAL_VERSION = 2;
+
+    // bytes in each of the two log buffers, a full buffer is
+    // flushed without waiting for the durability window
+    static const size_t WAL_BUFFER_SIZE = 1048576;
+
+    // logged table operations
+    typedef enum { WAL_INSERT = 1, WAL_REMOVE, WAL_UPSERT } WalOperationType;
+
+// data structures
+
+    // log file header
+    typedef struct WalHeaderStruct
+       {
+        char magic[ 4 ];
+        uint32_t version;
+        uint64_t checkpointNumber;
+       } WalHeaderType;
+
+    // open log, records are appended to active buffer while flusher
+    // writes the other one; counts are of records logged since log was
+    // opened, durable ones are written and synced
+    typedef struct WriteAheadLogStruct
+       {
+        int fileDescriptor;
+        uint64_t checkpointNumber;
+        unsigned char *buffers[ 2 ];
+        int activeBuffer;
+        size_t bufferLength;
+        long long windowMicroseconds;
+        pthread_mutex_t lock;
+        pthread_cond_t flushNeeded;
+        pthread_cond_t flushDone;
+        pthread_t flusher;
+        bool flushing;
+        bool urgent;
+        bool stopping;
+        bool failed;
+        long long loggedCount;
+        long long durableCount;
+        long long syncCount;
+        long long bytesWritten;
+       } WriteAheadLogType;
+
+// function prototypes
+
+/*
+Name: checkpointWriteAheadLog
+Process: writes every item in use in table to checkpoint file, with
+         next checkpoint number, through temporary file synced and
+         renamed over it, then empties log; node of each item is written
+         too, so recovery into open addressing table of same layout
+         puts items back in their nodes; items of a name are written in
+         order finds reach them, so loading gives them same order;
+         table must hold every change logged so far
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (const ProbingHashType *),
+                           checkpoint file name (const char *)
+Function output/parameters: updated log, emptied (WriteAheadLogType *)
+Function output/returned: number of items written,
+                          or -1 if checkpoint could not be written (int)
+Device input/---: none
+Device output/file: checkpoint and emptied log to HD
+Dependencies: syncWriteAheadLog, malloc, sprintf, openBinaryDataWriter,
+              qsort, compareCheckpointNodes, strcmp, writeCheckpointName,
+              closeBinaryDataWriter, free, syncFileName, rename,
+              pthread_mutex_lock, pthread_cond_wait, ftruncate,
+              writeWalHeader, fsync, pthread_mutex_unlock
+*/
+int checkpointWriteAheadLog( WriteAheadLogType *wal,
+                  const ProbingHashType *hash, const char *checkpointFileName );
+
+/*
+Name: closeWriteAheadLog
+Process: flushes and syncs records still buffered, stops flusher,
+         closes log file and releases log
+Function input/parameters: log (WriteAheadLogType *)
+Function output/parameters: none
+Function output/returned: false if a write or sync failed (bool)
+Device input/---: none
+Device output/file: buffered records to HD
+Dependencies: pthread_mutex_lock, pthread_cond_signal,
+              pthread_mutex_unlock, pthread_join, close,
+              pthread_mutex_destroy, pthread_cond_destroy, free
+*/
+bool closeWriteAheadLog( WriteAheadLogType *wal );
+
+/*
+Name: insertLoggedItem
+Process: adds item as addItemFromStruct, then logs insert if it was
+         added
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           new item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *)
+Function output/returned: false if item could not be added, or was
+                          added but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: addItemFromStruct, logWalRecord
+*/
+bool insertLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                                                     StateDataType newItem );
+
+/*
+Name: openWriteAheadLog
+Process: opens log file for appending, creating it with header if
+         missing, empty, or older than checkpoint, cutting any partly
+         written last record, and starts flusher
+Function input/parameters: log and checkpoint file names (const char *),
+                           durability window in microseconds, zero to
+                           make each change durable before it returns
+                           (long long)
+Function output/parameters: none
+Function output/returned: pointer to log, or NULL if file could not be
+                          opened, is not a log file, or follows a
+                          checkpoint newer than one on disk
+                          (WriteAheadLogType *)
+Device input/file: checkpoint header and existing log records from HD
+Device output/file: header to HD
+Dependencies: readCheckpointNumber, fopen, fseek, ftell, rewind,
+              readWalHeader, readWalRecord, fclose, open, ftruncate,
+              writeWalHeader, close, malloc, free, pthread_mutex_init,
+              pthread_cond_init, pthread_create
+*/
+WriteAheadLogType *openWriteAheadLog( const char *logFileName,
+              const char *checkpointFileName, long long windowMicroseconds );
+
+/*
+Name: recoverHashTable
+Process: loads last checkpoint into empty table, if there is one,
+         then replays log onto it up to its last whole record, unless
+         log is older than checkpoint; missing checkpoint or log is
+         an empty one
+Function input/parameters: hash table (ProbingHashType *),
+                           checkpoint and log file names (const char *)
+Function output/parameters: updated hash table (ProbingHashType *)
+Function output/returned: number of log records replayed, or -1 if
+                          checkpoint or log is not valid, or log follows
+                          a newer checkpoint (long long)
+Device input/file: checkpoint and log from HD
+Device output/---: none
+Dependencies: readCheckpointNumber, restoreDataFromBinary, fopen, fgetc,
+              fclose, rewind, readWalHeader, readWalRecord, removeState,
+              addItemFromStruct, upsertItem
+*/
+long long recoverHashTable( ProbingHashType *hash,
+                      const char *checkpointFileName, const char *logFileName );
+
+/*
+Name: removeLoggedItem
+Process: removes item as removeState, then logs removal if it was
+         removed
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           search item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *),
+                            removed state (StateDataType *)
+Function output/returned: false if item was not found, or was removed
+                          but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: removeState, logWalRecord
+*/
+bool removeLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                      StateDataType toBeRemoved, StateDataType *removedState );
+
+/*
+Name: syncWriteAheadLog
+Process: waits until every record logged so far is written and synced,
+         flushing now without waiting for durability window
+Function input/parameters: log (WriteAheadLogType *)
+Function output/parameters: updated log (WriteAheadLogType *)
+Function output/returned: false if a write or sync failed (bool)
+Device input/---: none
+Device output/file: buffered records to HD
+Dependencies: pthread_mutex_lock, pthread_cond_signal, pthread_cond_wait,
+              pthread_mutex_unlock
+*/
+bool syncWriteAheadLog( WriteAheadLogType *wal );
+
+/*
+Name: upsertLoggedItem
+Process: applies item as upsertItem, then logs upsert if it was applied
+Function input/parameters: log (WriteAheadLogType *),
+                           hash table (ProbingHashType *),
+                           new item (StateDataType)
+Function output/parameters: updated log (WriteAheadLogType *),
+                            updated hash table (ProbingHashType *)
+Function output/returned: false if item could not be added, or was
+                          applied but could not be logged (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: upsertItem, logWalRecord
+*/
+bool upsertLoggedItem( WriteAheadLogType *wal, ProbingHashType *hash,
+                                                     StateDataType newItem );
+
+#endif  // WRITE_AHEAD_LOG_UTILITY_H
@@ -0,0 +1,213 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Benchmark_Utility.c"
+#include "Arena_Utility.c"
+
+// constants
+#define MAX_BATCH_TABLES 1024
+
+// prototypes
+void fillBatchKeys( StateDataType *keys, int keyCount, int tableIndex );
+long long runHeapBatches( int batchCount, int tableCount, int keyCount,
+                                                            int tableSize );
+long long runArenaBatches( ArenaType *arena, int batchCount, int tableCount,
+                                              int keyCount, int tableSize );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    ArenaType *arena;
+    long long heapNanoseconds, arenaNanoseconds;
+    int batchCount = 200, tableCount = 64, keyCount = 200, tableSize = 401;
+
+    if( argc > 1 )
+       {
+        batchCount = atoi( argv[ 1 ] );
+       }
+
+    if( argc > 2 )
+       {
+        tableCount = atoi( argv[ 2 ] );
+       }
+
+    if( argc > 3 )
+       {
+        keyCount = atoi( argv[ 3 ] );
+       }
+
+    if( argc > 4 )
+       {
+        tableSize = atoi( argv[ 4 ] );
+       }
+
+    // title
+    printf( "\nARENA BATCH PROGRAM\n" );
+    printf( "===================\n" );
+
+    if( batchCount <= 0 || tableCount <= 0 || tableCount > MAX_BATCH_TABLES
+                         || keyCount <= 0 || tableSize < keyCount )
+       {
+        printf( "\nUsage: arenadriver [batches] [tables per batch]"
+                " [keys per table] [table size]\n" );
+
+        return 1;
+       }
+
+    arena = createArena( 0 );
+
+    if( arena == NULL )
+       {
+        printf( "\nUnable to create arena\n" );
+
+        return 1;
+       }
+
+    printf( "\n%d batches of %d tables, %d keys in %d slots each\n",
+                             batchCount, tableCount, keyCount, tableSize );
+
+    heapNanoseconds = runHeapBatches( batchCount, tableCount, keyCount,
+                                                                  tableSize );
+    arenaNanoseconds = runArenaBatches( arena, batchCount, tableCount,
+                                                        keyCount, tableSize );
+
+    printf( "\nHeap:  %10.1f us per batch\n",
+                                       heapNanoseconds / 1000.0 / batchCount );
+    printf( "Arena: %10.1f us per batch, %zu bytes reserved\n",
+            arenaNanoseconds / 1000.0 / batchCount, arena->reservedBytes );
+
+    clearArena( arena );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: fillBatchKeys
+Process: fills keys of one table of batch, names differ per table
+Function input/parameters: key count (int), table index (int)
+Function output/parameters: keys (StateDataType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: sprintf, setHashNodeFromData
+*/
+void fillBatchKeys( StateDataType *keys, int keyCount, int tableIndex )
+   {
+    char name[ STD_STR_LEN ];
+    int keyIndex;
+
+    for( keyIndex = 0; keyIndex < keyCount; keyIndex++ )
+       {
+        sprintf( name, "Batch State %04d-%05d", tableIndex, keyIndex );
+
+        setHashNodeFromData( &keys[ keyIndex ], name, keyIndex % 100,
+                          keyIndex % 100 - 20.0, keyIndex % 100 + 20.0,
+                                                                 USED_NODE );
+       }
+   }
+
+/*
+Name: runArenaBatches
+Process: builds batches of tables and their key buffers in arena,
+         each batch torn down with one arena reset
+Function input/parameters: arena (ArenaType *), batch count (int),
+                           tables per batch (int), keys per table (int),
+                           table size (int)
+Function output/parameters: updated arena (ArenaType *)
+Function output/returned: total time in nanoseconds (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: getArenaAllocator, getTimeNanoseconds, allocateArenaMemory,
+              fillBatchKeys, initializeHashTableWithOptions,
+              setHashTableVerbose, addItemFromStruct, resetArena
+*/
+long long runArenaBatches( ArenaType *arena, int batchCount, int tableCount,
+                                               int keyCount, int tableSize )
+   {
+    HashAllocationOptionsType options = { STANDARD_PAGES, NUMA_DEFAULT, 0,
+                                                 getArenaAllocator( arena ) };
+    ProbingHashType *hash;
+    StateDataType *keys;
+    long long startTime = getTimeNanoseconds();
+    int batchIndex, tableIndex, keyIndex;
+
+    for( batchIndex = 0; batchIndex < batchCount; batchIndex++ )
+       {
+        for( tableIndex = 0; tableIndex < tableCount; tableIndex++ )
+           {
+            keys = (StateDataType *)allocateArenaMemory( arena,
+                           keyCount * sizeof( StateDataType ), sizeof( double ) );
+            fillBatchKeys( keys, keyCount, tableIndex );
+
+            hash = initializeHashTableWithOptions( tableSize, tableSize,
+                                                    LINEAR_PROBING, &options );
+            setHashTableVerbose( hash, false );
+
+            for( keyIndex = 0; keyIndex < keyCount; keyIndex++ )
+               {
+                addItemFromStruct( hash, keys[ keyIndex ] );
+               }
+           }
+
+        // whole batch, tables and keys, dropped at once
+        resetArena( arena );
+       }
+
+    return getTimeNanoseconds() - startTime;
+   }
+
+/*
+Name: runHeapBatches
+Process: builds batches of tables and their key buffers on heap,
+         each table and buffer freed one by one at end of batch
+Function input/parameters: batch count (int), tables per batch (int),
+                           keys per table (int), table size (int)
+Function output/parameters: none
+Function output/returned: total time in nanoseconds (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: getTimeNanoseconds, malloc, fillBatchKeys,
+              initializeHashTable, setHashTableVerbose, addItemFromStruct,
+              clearHashTable, free
+*/
+long long runHeapBatches( int batchCount, int tableCount, int keyCount,
+                                                             int tableSize )
+   {
+    ProbingHashType *tables[ MAX_BATCH_TABLES ];
+    StateDataType *keys[ MAX_BATCH_TABLES ];
+    long long startTime = getTimeNanoseconds();
+    int batchIndex, tableIndex, keyIndex;
+
+    for( batchIndex = 0; batchIndex < batchCount; batchIndex++ )
+       {
+        for( tableIndex = 0; tableIndex < tableCount; tableIndex++ )
+           {
+            keys[ tableIndex ] = (StateDataType *)malloc(
+                                        keyCount * sizeof( StateDataType ) );
+            fillBatchKeys( keys[ tableIndex ], keyCount, tableIndex );
+
+            tables[ tableIndex ] = initializeHashTable( tableSize,
+                                                             LINEAR_PROBING );
+            setHashTableVerbose( tables[ tableIndex ], false );
+
+            for( keyIndex = 0; keyIndex < keyCount; keyIndex++ )
+               {
+                addItemFromStruct( tables[ tableIndex ],
+                                                   keys[ tableIndex ][ keyIndex ] );
+               }
+           }
+
+        for( tableIndex = 0; tableIndex < tableCount; tableIndex++ )
+           {
+            clearHashTable( tables[ tableIndex ] );
+            free( keys[ tableIndex ] );
+           }
+       }
+
+    return getTimeNanoseconds() - startTime;
+   }
@@ -0,0 +1,524 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "HashUtilities.c"
+#include "Benchmark_Utility.c"
+#include <string.h>
+
+// constants
+
+    // most list entries accepted per command line option
+    #define MAX_BENCH_LIST_LEN 32
+
+    // a miss scans the whole table, so misses per cell are limited
+    // to about this many slot visits (but at least MIN_MISS_OPERATIONS)
+    const long long MISS_PROBE_BUDGET = 67108864;
+    const long long MIN_MISS_OPERATIONS = 16;
+
+// data structures
+
+    // benchmark settings from command line
+    typedef struct BenchSettingsStruct
+       {
+        int tableSizes[ MAX_BENCH_LIST_LEN ];
+        int tableSizeCount;
+        double loadFactors[ MAX_BENCH_LIST_LEN ];
+        int loadFactorCount;
+        ProbeType probes[ MAX_BENCH_LIST_LEN ];
+        int probeCount;
+        long long operations;
+        unsigned long long seed;
+        const char *outFileName;
+        bool useFilter;
+       } BenchSettingsType;
+
+// prototypes
+long long getGreatestCommonDivisor( long long one, long long other );
+const char *getProbeName( ProbeType probe );
+void makeBenchKey( StateDataType *key, long long keyIndex, 
+                                                  unsigned long long seed );
+bool readBenchSettings( BenchSettingsType *settings, int argc, char *argv[] );
+void runBenchCell( FILE *outFilePtr, const BenchSettingsType *settings,
+                           ProbeType probe, int tableSize, double loadFactor );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    BenchSettingsType settings;
+    FILE *outFilePtr;
+    int probeIndex, sizeIndex, loadIndex;
+    bool firstCell = true;
+
+    // title
+    printf( "\nHASH TABLE BENCHMARK\n" );
+    printf( "====================\n" );
+
+    if( !readBenchSettings( &settings, argc, argv ) )
+       {
+        printf( "\nUsage: benchdriver [--sizes n,n,...] [--loads f,f,...]"
+                "\n                   [--probes linear,quadratic,tree,chain,none]"
+                "\n                   [--ops n] [--seed n] [--output file]"
+                "\n                   [--filter on|off]\n" );
+
+        return 1;
+       }
+
+    outFilePtr = fopen( settings.outFileName, "w" );
+
+    if( outFilePtr == NULL )
+       {
+        printf( "\nUnable to open %s\n", settings.outFileName );
+
+        return 1;
+       }
+
+    fprintf( outFilePtr, "{\n  \"benchmark\": \"hash_table_operations\",\n"
+                         "  \"operations\": %lld,\n  \"seed\": %llu,\n"
+                         "  \"results\": [", 
+                                     settings.operations, settings.seed );
+
+    // every probe type, size, and load factor
+    for( probeIndex = 0; probeIndex < settings.probeCount; probeIndex++ )
+       {
+        for( sizeIndex = 0; sizeIndex < settings.tableSizeCount; sizeIndex++ )
+           {
+            for( loadIndex = 0; loadIndex < settings.loadFactorCount; 
+                                                                  loadIndex++ )
+               {
+                // only chained tables hold more items than slots
+                if( settings.loadFactors[ loadIndex ] > 1.0
+                        && settings.probes[ probeIndex ] != TREE_CHAINING
+                        && settings.probes[ probeIndex ] != CHAINING )
+                   {
+                    continue;
+                   }
+
+                printf( "\n%s probing, table size %d, load factor %.2f", 
+                             getProbeName( settings.probes[ probeIndex ] ),
+                                       settings.tableSizes[ sizeIndex ], 
+                                      settings.loadFactors[ loadIndex ] );
+                fflush( stdout );
+
+                fprintf( outFilePtr, firstCell ? "\n" : ",\n" );
+                firstCell = false;
+
+                runBenchCell( outFilePtr, &settings, 
+                              settings.probes[ probeIndex ],
+                              settings.tableSizes[ sizeIndex ], 
+                              settings.loadFactors[ loadIndex ] );
+               }
+           }
+       }
+
+    fprintf( outFilePtr, "\n  ]\n}\n" );
+    fclose( outFilePtr );
+
+    printf( "\n\nResults written to %s\n", settings.outFileName );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: getGreatestCommonDivisor
+Process: finds greatest common divisor by Euclid's algorithm
+Function input/parameters: two values (long long)
+Function output/parameters: none
+Function output/returned: greatest common divisor (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+long long getGreatestCommonDivisor( long long one, long long other )
+   {
+    long long remainder;
+
+    while( other != 0 )
+       {
+        remainder = one % other;
+        one = other;
+        other = remainder;
+       }
+
+    return one;
+   }
+
+/*
+Name: getProbeName
+Process: finds display name of probe type
+Function input/parameters: probe type (ProbeType)
+Function output/parameters: none
+Function output/returned: name of probe type (const char *)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+const char *getProbeName( ProbeType probe )
+   {
+    if( probe == LINEAR_PROBING )
+       {
+        return "linear";
+       }
+
+    if( probe == QUADRATIC_PROBING )
+       {
+        return "quadratic";
+       }
+
+    if( probe == TREE_CHAINING )
+       {
+        return "tree";
+       }
+
+    if( probe == CHAINING )
+       {
+        return "chain";
+       }
+
+    return "none";
+   }
+
+/*
+Name: makeBenchKey
+Process: creates unique state name for key index, pseudo random
+         lower case prefix of 3 to 14 letters followed by key index 
+         in upper case base 26, so any key index not yet inserted 
+         is a guaranteed miss
+Function input/parameters: key index (long long), 
+                           seed (unsigned long long)
+Function output/parameters: key with name set, in use (StateDataType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: nextRandom
+*/
+void makeBenchKey( StateDataType *key, long long keyIndex, 
+                                                   unsigned long long seed )
+   {
+    unsigned long long state = seed ^ (unsigned long long)keyIndex;
+    int prefixLength = 3 + (int)( nextRandom( &state ) % 12 );
+    int nameIndex;
+
+    for( nameIndex = 0; nameIndex < prefixLength; nameIndex++ )
+       {
+        key->name[ nameIndex ] = (char)( 'a' + nextRandom( &state ) % 26 );
+       }
+
+    do
+       {
+        key->name[ nameIndex ] = (char)( 'A' + keyIndex % 26 );
+        keyIndex /= 26;
+        nameIndex++;
+       }
+    while( keyIndex > 0 );
+
+    key->name[ nameIndex ] = NULL_CHAR;
+    key->averageTemp = key->lowestTemp = key->highestTemp = 0.0;
+    key->inUse = USED_NODE;
+   }
+
+/*
+Name: readBenchSettings
+Process: sets defaults, then reads options from command line,
+         lists are comma separated
+Function input/parameters: argument count (int), arguments (char *[])
+Function output/parameters: benchmark settings (BenchSettingsType *)
+Function output/returned: false if an option is unknown or invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp, strtok, atoi, atof, atoll, strtoull
+*/
+bool readBenchSettings( BenchSettingsType *settings, int argc, char *argv[] )
+   {
+    int argIndex;
+    char *item;
+
+    // defaults, L1 to L2 resident tables
+    settings->tableSizes[ 0 ] = 1021;
+    settings->tableSizes[ 1 ] = 16381;
+    settings->tableSizeCount = 2;
+    settings->loadFactors[ 0 ] = 0.5;
+    settings->loadFactors[ 1 ] = 0.75;
+    settings->loadFactors[ 2 ] = 0.9;
+    settings->loadFactors[ 3 ] = 0.95;
+    settings->loadFactorCount = 4;
+    settings->probes[ 0 ] = LINEAR_PROBING;
+    settings->probes[ 1 ] = QUADRATIC_PROBING;
+    settings->probes[ 2 ] = NO_PROBING;
+    settings->probeCount = 3;
+    settings->operations = 50000;
+    settings->seed = 20231;
+    settings->outFileName = "benchresults.json";
+    settings->useFilter = false;
+
+    for( argIndex = 1; argIndex + 1 < argc; argIndex += 2 )
+       {
+        if( strcmp( argv[ argIndex ], "--sizes" ) == 0 )
+           {
+            settings->tableSizeCount = 0;
+
+            for( item = strtok( argv[ argIndex + 1 ], "," ); 
+                    item != NULL && settings->tableSizeCount < MAX_BENCH_LIST_LEN;
+                                               item = strtok( NULL, "," ) )
+               {
+                settings->tableSizes[ settings->tableSizeCount ] = atoi( item );
+
+                if( settings->tableSizes[ settings->tableSizeCount ] <= 0 )
+                   {
+                    return false;
+                   }
+
+                settings->tableSizeCount++;
+               }
+           }
+
+        else if( strcmp( argv[ argIndex ], "--loads" ) == 0 )
+           {
+            settings->loadFactorCount = 0;
+
+            for( item = strtok( argv[ argIndex + 1 ], "," ); 
+                 item != NULL && settings->loadFactorCount < MAX_BENCH_LIST_LEN;
+                                               item = strtok( NULL, "," ) )
+               {
+                settings->loadFactors[ settings->loadFactorCount ] = atof( item );
+
+                if( settings->loadFactors[ settings->loadFactorCount ] <= 0.0 )
+                   {
+                    return false;
+                   }
+
+                settings->loadFactorCount++;
+               }
+           }
+
+        else if( strcmp( argv[ argIndex ], "--probes" ) == 0 )
+           {
+            settings->probeCount = 0;
+
+            for( item = strtok( argv[ argIndex + 1 ], "," ); 
+                     item != NULL && settings->probeCount < MAX_BENCH_LIST_LEN;
+                                               item = strtok( NULL, "," ) )
+               {
+                if( strcmp( item, "linear" ) == 0 )
+                   {
+                    settings->probes[ settings->probeCount ] = LINEAR_PROBING;
+                   }
+
+                else if( strcmp( item, "quadratic" ) == 0 )
+                   {
+                    settings->probes[ settings->probeCount ] = QUADRATIC_PROBING;
+                   }
+
+                else if( strcmp( item, "tree" ) == 0 )
+                   {
+                    settings->probes[ settings->probeCount ] = TREE_CHAINING;
+                   }
+
+                else if( strcmp( item, "chain" ) == 0 )
+                   {
+                    settings->probes[ settings->probeCount ] = CHAINING;
+                   }
+
+                else if( strcmp( item, "none" ) == 0 )
+                   {
+                    settings->probes[ settings->probeCount ] = NO_PROBING;
+                   }
+
+                else
+                   {
+                    return false;
+                   }
+
+                settings->probeCount++;
+               }
+           }
+
+        else if( strcmp( argv[ argIndex ], "--ops" ) == 0 )
+           {
+            settings->operations = atoll( argv[ argIndex + 1 ] );
+           }
+
+        else if( strcmp( argv[ argIndex ], "--seed" ) == 0 )
+           {
+            settings->seed = strtoull( argv[ argIndex + 1 ], NULL, 10 );
+           }
+
+        else if( strcmp( argv[ argIndex ], "--output" ) == 0 )
+           {
+            settings->outFileName = argv[ argIndex + 1 ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--filter" ) == 0 
+                                && ( strcmp( argv[ argIndex + 1 ], "on" ) == 0 
+                                || strcmp( argv[ argIndex + 1 ], "off" ) == 0 ) )
+           {
+            settings->useFilter = strcmp( argv[ argIndex + 1 ], "on" ) == 0;
+           }
+
+        else
+           {
+            return false;
+           }
+       }
+
+    // odd argument count leaves an option without value
+    return argIndex == argc && settings->operations > 0
+            && settings->tableSizeCount > 0 && settings->loadFactorCount > 0
+                                             && settings->probeCount > 0;
+   }
+
+/*
+Name: runBenchCell
+Process: fills quiet table of given size and probe type to load factor,
+         table size is bucket count for chained tables, which hold
+         as many nodes as needed for load factors above 1.0,
+         membership filter enabled before filling if set,
+         timing each addItemFromStruct, then times findItemIndex on
+         random inserted keys (hits) and keys never inserted (misses),
+         then removeState on distinct inserted keys, 
+         writes JSON object of results
+Function input/parameters: output file (FILE *), 
+                           settings (const BenchSettingsType *),
+                           probe type (ProbeType), table size (int),
+                           load factor (double)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/file: JSON result object written as specified
+Dependencies: initializeChainedHashTable, setHashTableVerbose, 
+              enableHashFilter, createLatencyLog,
+              makeBenchKey, getTimeNanoseconds, addItemFromStruct,
+              addLatencySample, findItemIndex, removeState, 
+              getGreatestCommonDivisor, writeLatencyJson, clearLatencyLog, 
+              clearHashTable
+*/
+void runBenchCell( FILE *outFilePtr, const BenchSettingsType *settings,
+                            ProbeType probe, int tableSize, double loadFactor )
+   {
+    long long itemCount = (long long)( tableSize * loadFactor );
+    ProbingHashType *hash = initializeChainedHashTable( 
+                  itemCount > tableSize ? (int)itemCount : tableSize, 
+                                                          tableSize, probe );
+    long long missCount = MISS_PROBE_BUDGET / tableSize;
+    long long removeCount = itemCount, stride = 1000003;
+    long long opIndex, storedCount = 0, hitsFound = 0, removedCount = 0;
+    long long opStart, batchStart;
+    unsigned long long randomState = settings->seed;
+    LatencyLogType *insertLog = createLatencyLog( itemCount );
+    LatencyLogType *hitLog = createLatencyLog( settings->operations );
+    LatencyLogType *missLog, *removeLog;
+    StateDataType key, removed;
+    int index;
+
+    setHashTableVerbose( hash, false );
+
+    // filter updated on every insert, so insert times include it
+    if( settings->useFilter )
+       {
+        enableHashFilter( hash, (int)itemCount );
+       }
+
+    // misses scan whole table, keep within budget
+    missCount = missCount < MIN_MISS_OPERATIONS ? MIN_MISS_OPERATIONS : missCount;
+    missCount = missCount > settings->operations ? settings->operations : missCount;
+    missLog = createLatencyLog( missCount );
+
+    removeCount = removeCount > settings->operations ? 
+                                            settings->operations : removeCount;
+    removeLog = createLatencyLog( removeCount );
+
+    // insert
+    batchStart = getTimeNanoseconds();
+
+    for( opIndex = 0; opIndex < itemCount; opIndex++ )
+       {
+        makeBenchKey( &key, opIndex, settings->seed );
+
+        opStart = getTimeNanoseconds();
+        addItemFromStruct( hash, key );
+        addLatencySample( insertLog, getTimeNanoseconds() - opStart );
+       }
+
+    insertLog->totalNanoseconds = getTimeNanoseconds() - batchStart;
+
+    for( index = 0; index < hash->tableSize; index++ )
+       {
+        storedCount += hash->array[ index ].inUse;
+       }
+
+    // find hits
+    batchStart = getTimeNanoseconds();
+
+    for( opIndex = 0; opIndex < settings->operations && itemCount > 0; 
+                                                                   opIndex++ )
+       {
+        makeBenchKey( &key, (long long)( nextRandom( &randomState ) 
+                                  % (unsigned long long)itemCount ), 
+                                                            settings->seed );
+
+        opStart = getTimeNanoseconds();
+        hitsFound += findItemIndex( hash, key ) != ITEM_NOT_FOUND;
+        addLatencySample( hitLog, getTimeNanoseconds() - opStart );
+       }
+
+    hitLog->totalNanoseconds = getTimeNanoseconds() - batchStart;
+
+    // find misses
+    batchStart = getTimeNanoseconds();
+
+    for( opIndex = 0; opIndex < missCount; opIndex++ )
+       {
+        makeBenchKey( &key, itemCount + opIndex, settings->seed );
+
+        opStart = getTimeNanoseconds();
+        findItemIndex( hash, key );
+        addLatencySample( missLog, getTimeNanoseconds() - opStart );
+       }
+
+    missLog->totalNanoseconds = getTimeNanoseconds() - batchStart;
+
+    // remove distinct keys, stride coprime to item count
+    while( itemCount > 0 && getGreatestCommonDivisor( stride, itemCount ) != 1 )
+       {
+        stride++;
+       }
+
+    batchStart = getTimeNanoseconds();
+
+    for( opIndex = 0; opIndex < removeCount; opIndex++ )
+       {
+        makeBenchKey( &key, opIndex * stride % itemCount, settings->seed );
+
+        opStart = getTimeNanoseconds();
+        removedCount += removeState( &removed, key, *hash );
+        addLatencySample( removeLog, getTimeNanoseconds() - opStart );
+       }
+
+    removeLog->totalNanoseconds = getTimeNanoseconds() - batchStart;
+
+    // results
+    fprintf( outFilePtr, "    { \"probe\": \"%s\", \"table_size\": %d, "
+                         "\"load_factor\": %.2f, \"items\": %lld, "
+                         "\"stored\": %lld, \"hits_found\": %lld, "
+                         "\"removed\": %lld, \"filter\": %s,\n      ", 
+              getProbeName( probe ), tableSize, loadFactor, itemCount, 
+                                   storedCount, hitsFound, removedCount, 
+                                  hash->filter != NULL ? "true" : "false" );
+
+    writeLatencyJson( outFilePtr, "insert", insertLog );
+    fprintf( outFilePtr, ",\n      " );
+    writeLatencyJson( outFilePtr, "find_hit", hitLog );
+    fprintf( outFilePtr, ",\n      " );
+    writeLatencyJson( outFilePtr, "find_miss", missLog );
+    fprintf( outFilePtr, ",\n      " );
+    writeLatencyJson( outFilePtr, "remove", removeLog );
+    fprintf( outFilePtr, " }" );
+
+    clearLatencyLog( insertLog );
+    clearLatencyLog( hitLog );
+    clearLatencyLog( missLog );
+    clearLatencyLog( removeLog );
+    clearHashTable( hash );
+   }
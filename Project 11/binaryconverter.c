@@ -0,0 +1,47 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Binary_Data_Utility.c"
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *csvFileName = "inData.csv";
+    const char *binaryFileName = "inData.bin";
+    long long recordCount;
+
+    // file names from command line, if given
+    if( argc > 1 )
+       {
+        csvFileName = argv[ 1 ];
+       }
+
+    if( argc > 2 )
+       {
+        binaryFileName = argv[ 2 ];
+       }
+
+    // title
+    printf( "\nCSV TO BINARY DATA CONVERTER\n" );
+    printf( "============================\n" );
+
+    recordCount = convertCsvToBinary( csvFileName, binaryFileName );
+
+    if( recordCount < 0 )
+       {
+        printf( "\nConversion of %s to %s failed\n", 
+                                                csvFileName, binaryFileName );
+
+        return 1;
+       }
+
+    printf( "\n%lld records converted from %s to %s\n", 
+                                   recordCount, csvFileName, binaryFileName );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
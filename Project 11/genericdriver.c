@@ -0,0 +1,268 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Generic_Hash_Table.h"
+#include <string.h>
+
+// constants
+#define STATE_TABLE_SIZE 67
+#define COUNT_TABLE_SIZE 17
+
+// data structures
+
+    // state name key
+    typedef struct StateNameKeyStruct
+       {
+        char name[ STD_STR_LEN ];
+       } StateNameKeyType;
+
+    // state temperatures value
+    typedef struct TemperatureStruct
+       {
+        double averageTemp, lowestTemp, highestTemp;
+       } TemperatureType;
+
+// prototypes
+static inline bool equalStateNames( const StateNameKeyType *oneKey,
+                                              const StateNameKeyType *otherKey );
+static inline bool equalTemperatureKeys( const int *oneKey,
+                                                         const int *otherKey );
+static inline uint64_t hashStateName( const StateNameKeyType *key );
+static inline uint64_t hashTemperatureKey( const int *key );
+void setStateNameKey( StateNameKeyType *key, const char *name,
+                                                              int nameLength );
+
+// hash table specializations
+DEFINE_HASH_TABLE( StateTemperatureTable, StateNameKeyType, TemperatureType,
+                                             hashStateName, equalStateNames )
+
+DEFINE_HASH_TABLE( TemperatureCountTable, int, int,
+                                    hashTemperatureKey, equalTemperatureKeys )
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *dataFileName = "inData.csv";
+    const char *findNames[] = { "Arizona", "Iowa", "Minnesota", "Texas" };
+    StateTemperatureTableType *stateTable;
+    TemperatureCountTableType *countTable;
+    MappedFileType *mappedFile;
+    StringViewType nameView;
+    StateNameKeyType key;
+    TemperatureType temps, *foundTemps;
+    int index, decade, one = 1, *foundCount;
+    size_t errorOffset;
+
+    if( argc > 1 )
+       {
+        dataFileName = argv[ 1 ];
+       }
+
+    // title
+    printf( "\nGENERIC HASH TABLE TEST PROGRAM\n" );
+    printf( "===============================\n" );
+
+    stateTable = initializeStateTemperatureTable( STATE_TABLE_SIZE,
+                                                             QUADRATIC_PROBING );
+    countTable = initializeTemperatureCountTable( COUNT_TABLE_SIZE,
+                                                                LINEAR_PROBING );
+    mappedFile = openMappedFile( dataFileName );
+
+    if( stateTable == NULL || countTable == NULL || mappedFile == NULL )
+       {
+        printf( "\nUnable to load %s\n", dataFileName );
+
+        return 1;
+       }
+
+    // load states, name keyed
+    while( readViewToDelimiterFromMap( mappedFile, COMMA, &nameView ) )
+       {
+        temps.averageTemp = readDoubleFromMap( mappedFile );
+        readCharacterFromMap( mappedFile );
+        temps.lowestTemp = readDoubleFromMap( mappedFile );
+        readCharacterFromMap( mappedFile );
+        temps.highestTemp = readDoubleFromMap( mappedFile );
+
+        if( getMapParseStatus( mappedFile, &errorOffset ) != PARSE_SUCCESS )
+           {
+            printf( "\nData error in %s at byte %lu\n", dataFileName,
+                                                  (unsigned long)errorOffset );
+
+            break;
+           }
+
+        setStateNameKey( &key, nameView.start, nameView.length );
+
+        addStateTemperatureTableItem( stateTable, &key, &temps );
+       }
+
+    closeMappedFile( mappedFile );
+
+    printf( "\n%d states loaded from %s\n",
+                                         stateTable->itemCount, dataFileName );
+
+    printf( "\n\nFinding Selected States ----------------------------------\n" );
+
+    for( index = 0; index < 4; index++ )
+       {
+        setStateNameKey( &key, findNames[ index ],
+                                         getStringLength( findNames[ index ] ) );
+
+        foundTemps = findStateTemperatureTableItem( stateTable, &key );
+
+        if( foundTemps != NULL )
+           {
+            printf( "Found: %s, Avg: %5.2f, Low: %5.2f, High: %5.2f\n",
+                             key.name, foundTemps->averageTemp,
+                             foundTemps->lowestTemp, foundTemps->highestTemp );
+           }
+
+        else
+           {
+            printf( "Not Found: %s\n", key.name );
+           }
+       }
+
+    printf( "\n\nRemoving Selected States ----------------------------------\n" );
+
+    setStateNameKey( &key, "Texas", getStringLength( "Texas" ) );
+
+    if( removeStateTemperatureTableItem( stateTable, &key, &temps ) )
+       {
+        printf( "---Removed: %s, Avg: %5.2f\n", key.name, temps.averageTemp );
+       }
+
+    printf( "Texas %s\n", findStateTemperatureTableItem( stateTable, &key )
+                                            == NULL ? "not found" : "found" );
+
+    // integer keyed table, states per ten degrees of average temperature
+    printf( "\n\nStates Per Average Temperature Decade ---------------------\n" );
+
+    for( index = 0; index < stateTable->tableSize; index++ )
+       {
+        if( stateTable->array[ index ].state == GENERIC_USED_ENTRY )
+           {
+            decade = (int)( stateTable->array[ index ].value.averageTemp / 10 )
+                                                                          * 10;
+
+            foundCount = findTemperatureCountTableItem( countTable, &decade );
+
+            if( foundCount != NULL )
+               {
+                ( *foundCount )++;
+               }
+
+            else
+               {
+                addTemperatureCountTableItem( countTable, &decade, &one );
+               }
+           }
+       }
+
+    for( decade = 0; decade <= 100; decade += 10 )
+       {
+        foundCount = findTemperatureCountTableItem( countTable, &decade );
+
+        if( foundCount != NULL )
+           {
+            printf( "%3d - %3d: %d\n", decade, decade + 9, *foundCount );
+           }
+       }
+
+    clearStateTemperatureTable( stateTable );
+    clearTemperatureCountTable( countTable );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: equalStateNames
+Process: compares state name keys for equality
+Function input/parameters: one key and other key (const StateNameKeyType *)
+Function output/parameters: none
+Function output/returned: true if names match (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp
+*/
+static inline bool equalStateNames( const StateNameKeyType *oneKey,
+                                              const StateNameKeyType *otherKey )
+   {
+    return strcmp( oneKey->name, otherKey->name ) == 0;
+   }
+
+/*
+Name: equalTemperatureKeys
+Process: compares integer keys for equality
+Function input/parameters: one key and other key (const int *)
+Function output/parameters: none
+Function output/returned: true if keys match (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+static inline bool equalTemperatureKeys( const int *oneKey,
+                                                          const int *otherKey )
+   {
+    return *oneKey == *otherKey;
+   }
+
+/*
+Name: hashStateName
+Process: hashes state name key
+Function input/parameters: key (const StateNameKeyType *)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: getGenericBytesHash, strlen
+*/
+static inline uint64_t hashStateName( const StateNameKeyType *key )
+   {
+    return getGenericBytesHash( key->name, strlen( key->name ) );
+   }
+
+/*
+Name: hashTemperatureKey
+Process: hashes integer key
+Function input/parameters: key (const int *)
+Function output/parameters: none
+Function output/returned: hash value (uint64_t)
+Device input/---: none
+Device output/---: none
+Dependencies: getGenericIntegerHash
+*/
+static inline uint64_t hashTemperatureKey( const int *key )
+   {
+    return getGenericIntegerHash( (uint64_t)(int64_t)*key );
+   }
+
+/*
+Name: setStateNameKey
+Process: sets key from name given as pointer and length,
+         truncated to STD_STR_LEN - 1 as in hash table nodes
+Function input/parameters: name (const char *), name length (int)
+Function output/parameters: key (StateNameKeyType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: memcpy
+*/
+void setStateNameKey( StateNameKeyType *key, const char *name,
+                                                              int nameLength )
+   {
+    if( nameLength > STD_STR_LEN - 1 )
+       {
+        nameLength = STD_STR_LEN - 1;
+       }
+
+    memcpy( key->name, name, nameLength );
+
+    key->name[ nameLength ] = NULL_CHAR;
+   }
@@ -0,0 +1,527 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Binary_Data_Utility.c"
+#include "Benchmark_Utility.c"
+#include "Workload_Utility.c"
+#include <string.h>
+
+// constants
+
+    // most file sizes accepted on command line
+    #define MAX_INGEST_SIZES 32
+
+    // bytes read per block by staged loader
+    const int INGEST_BLOCK_SIZE = 1048576;
+
+    // average generated line length, used to size generated files
+    const long long GENERATED_LINE_BYTES = 32;
+
+// data structures
+
+    // one parsed row of staged loader, name points into block
+    typedef struct IngestRowStruct
+       {
+        const char *name;
+        int nameLength;
+        double averageTemp, lowestTemp, highestTemp;
+       } IngestRowType;
+
+    // staged loader results
+    typedef struct IngestStagesStruct
+       {
+        long long rowCount;
+        long long ioNanoseconds;
+        long long tokenizeNanoseconds;
+        long long parseNanoseconds;
+        long long insertNanoseconds;
+        bool dataError;
+       } IngestStagesType;
+
+    // ingest settings from command line
+    typedef struct IngestSettingsStruct
+       {
+        long long sizesMegabytes[ MAX_INGEST_SIZES ];
+        int sizeCount;
+        const char *directory;
+        const char *outFileName;
+        bool insertRows;
+        bool keepFiles;
+        unsigned long long seed;
+       } IngestSettingsType;
+
+// prototypes
+long long countFileLines( const char *fileName, long long *byteCount );
+bool readIngestSettings( IngestSettingsType *settings, 
+                                                      int argc, char *argv[] );
+void runStagedIngest( IngestStagesType *stages, ProbingHashType *hash,
+                                                       const char *fileName );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    IngestSettingsType settings;
+    WorkloadSettingsType workload;
+    IngestStagesType stages;
+    ProbingHashType *hash;
+    FILE *outFilePtr;
+    char fileName[ HUGE_STR_LEN ];
+    long long lineCount, byteCount, loadStart, loadNanoseconds, stageTotal;
+    int sizeIndex, tableSize, loadedRows = 0;
+    double megabytes;
+    bool generated;
+
+    // title
+    printf( "\nEND TO END INGEST BENCHMARK\n" );
+    printf( "===========================\n" );
+
+    if( !readIngestSettings( &settings, argc, argv ) )
+       {
+        printf( "\nUsage: ingestdriver [--sizes mb,mb,...] [--dir path]"
+                "\n                   [--no-insert] [--keep] [--seed n]"
+                "\n                   [--output file]\n" );
+
+        return 1;
+       }
+
+    outFilePtr = fopen( settings.outFileName, "w" );
+
+    if( outFilePtr == NULL )
+       {
+        printf( "\nUnable to open %s\n", settings.outFileName );
+
+        return 1;
+       }
+
+    fprintf( outFilePtr, "{\n  \"benchmark\": \"end_to_end_ingest\",\n"
+                         "  \"insert\": %s,\n  \"results\": [", 
+                                   settings.insertRows ? "true" : "false" );
+
+    for( sizeIndex = 0; sizeIndex < settings.sizeCount; sizeIndex++ )
+       {
+        sprintf( fileName, "%s/ingest_%lldMB.csv", settings.directory, 
+                                      settings.sizesMegabytes[ sizeIndex ] );
+
+        // generate file unless already there
+        lineCount = countFileLines( fileName, &byteCount );
+        generated = lineCount < 0;
+
+        if( generated )
+           {
+            setDefaultWorkloadSettings( &workload );
+
+            workload.rowCount = settings.sizesMegabytes[ sizeIndex ] 
+                                         * 1048576 / GENERATED_LINE_BYTES;
+            workload.dataFileName = fileName;
+            workload.seed = settings.seed;
+
+            printf( "\nGenerating %s", fileName );
+            fflush( stdout );
+
+            if( writeWorkloadData( &workload ) < 0 )
+               {
+                printf( "\nUnable to write %s\n", fileName );
+
+                break;
+               }
+
+            lineCount = countFileLines( fileName, &byteCount );
+           }
+
+        megabytes = byteCount / 1048576.0;
+        tableSize = (int)( lineCount * 1.3 ) | 1;
+
+        printf( "\n%s: %.1f MB, %lld lines", fileName, megabytes, lineCount );
+        fflush( stdout );
+
+        // stage split, table only needed for insert stage
+        hash = NULL;
+
+        if( settings.insertRows )
+           {
+            hash = initializeHashTable( tableSize, LINEAR_PROBING );
+            setHashTableVerbose( hash, false );
+           }
+
+        runStagedIngest( &stages, hash, fileName );
+
+        if( hash != NULL )
+           {
+            clearHashTable( hash );
+           }
+
+        // whole uploadData path
+        loadNanoseconds = 0;
+
+        if( settings.insertRows )
+           {
+            hash = initializeHashTable( tableSize, LINEAR_PROBING );
+            setHashTableVerbose( hash, false );
+
+            loadStart = getTimeNanoseconds();
+            loadedRows = uploadDataFromReader( hash, fileName );
+            loadNanoseconds = getTimeNanoseconds() - loadStart;
+
+            clearHashTable( hash );
+
+            printf( ", uploadData %.3f s (%.1f MB/s)", loadNanoseconds / 1e9,
+                                          megabytes / ( loadNanoseconds / 1e9 ) );
+           }
+
+        stageTotal = stages.ioNanoseconds + stages.tokenizeNanoseconds 
+                       + stages.parseNanoseconds + stages.insertNanoseconds;
+
+        printf( "\n   stages: I/O %.3f s, tokenize %.3f s, parse %.3f s, "
+                "insert %.3f s%s\n", stages.ioNanoseconds / 1e9, 
+                stages.tokenizeNanoseconds / 1e9, stages.parseNanoseconds / 1e9,
+                stages.insertNanoseconds / 1e9, 
+                stages.dataError ? " (stopped at data error)" : "" );
+
+        fprintf( outFilePtr, "%s\n    { \"file\": \"%s\", \"bytes\": %lld, "
+                 "\"rows\": %lld,\n      \"upload_data\": { \"rows\": %d, "
+                 "\"seconds\": %.6f, \"mb_per_second\": %.2f, "
+                 "\"rows_per_second\": %.1f },\n", sizeIndex > 0 ? "," : "",
+                 fileName, byteCount, stages.rowCount, loadedRows,
+                 loadNanoseconds / 1e9, 
+                 loadNanoseconds > 0 ? megabytes / ( loadNanoseconds / 1e9 ) : 0.0,
+                 loadNanoseconds > 0 ? loadedRows / ( loadNanoseconds / 1e9 ) : 0.0 );
+
+        fprintf( outFilePtr, "      \"stages\": { \"io_seconds\": %.6f, "
+                 "\"tokenize_seconds\": %.6f, \"parse_seconds\": %.6f, "
+                 "\"insert_seconds\": %.6f, \"mb_per_second\": %.2f, "
+                 "\"rows_per_second\": %.1f, \"data_error\": %s },\n"
+                 "      \"peak_rss_kb\": %ld }",
+                 stages.ioNanoseconds / 1e9, stages.tokenizeNanoseconds / 1e9,
+                 stages.parseNanoseconds / 1e9, stages.insertNanoseconds / 1e9,
+                 stageTotal > 0 ? megabytes / ( stageTotal / 1e9 ) : 0.0,
+                 stageTotal > 0 ? stages.rowCount / ( stageTotal / 1e9 ) : 0.0,
+                 stages.dataError ? "true" : "false", 
+                                                  getPeakResidentKilobytes() );
+        fflush( outFilePtr );
+
+        if( generated && !settings.keepFiles )
+           {
+            remove( fileName );
+           }
+       }
+
+    fprintf( outFilePtr, "\n  ]\n}\n" );
+    fclose( outFilePtr );
+
+    printf( "\nResults written to %s\n", settings.outFileName );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: countFileLines
+Process: counts lines and bytes of file, a last line without 
+         NEWLINE_CHAR is counted
+Function input/parameters: file name (const char *)
+Function output/parameters: file size in bytes (long long *)
+Function output/returned: number of lines, 
+                          or -1 if file could not be opened (long long)
+Device input/file: data from HD
+Device output/---: none
+Dependencies: openMappedFile, memchr, closeMappedFile
+*/
+long long countFileLines( const char *fileName, long long *byteCount )
+   {
+    MappedFileType *mappedFile = openMappedFile( fileName );
+    const char *linePtr, *endPtr;
+    long long lineCount = 0;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    linePtr = mappedFile->data;
+    endPtr = mappedFile->data + mappedFile->length;
+
+    while( linePtr < endPtr )
+       {
+        linePtr = (const char *)memchr( linePtr, NEWLINE_CHAR, 
+                                                           endPtr - linePtr );
+
+        lineCount++;
+
+        linePtr = linePtr == NULL ? endPtr : linePtr + 1;
+       }
+
+    *byteCount = (long long)mappedFile->length;
+
+    closeMappedFile( mappedFile );
+
+    return lineCount;
+   }
+
+/*
+Name: readIngestSettings
+Process: sets defaults, then reads options from command line,
+         sizes in megabytes, comma separated
+Function input/parameters: argument count (int), arguments (char *[])
+Function output/parameters: ingest settings (IngestSettingsType *)
+Function output/returned: false if an option is unknown or invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp, strtok, atoll, strtoull
+*/
+bool readIngestSettings( IngestSettingsType *settings, 
+                                                       int argc, char *argv[] )
+   {
+    int argIndex;
+    char *item;
+    bool valid = true;
+
+    // defaults, small enough to insert quickly
+    settings->sizesMegabytes[ 0 ] = 1;
+    settings->sizesMegabytes[ 1 ] = 2;
+    settings->sizeCount = 2;
+    settings->directory = ".";
+    settings->outFileName = "ingestresults.json";
+    settings->insertRows = true;
+    settings->keepFiles = false;
+    settings->seed = 20231;
+
+    for( argIndex = 1; argIndex < argc && valid; argIndex++ )
+       {
+        // flags without values
+        if( strcmp( argv[ argIndex ], "--no-insert" ) == 0 )
+           {
+            settings->insertRows = false;
+           }
+
+        else if( strcmp( argv[ argIndex ], "--keep" ) == 0 )
+           {
+            settings->keepFiles = true;
+           }
+
+        else if( argIndex + 1 == argc )
+           {
+            valid = false;
+           }
+
+        else if( strcmp( argv[ argIndex ], "--sizes" ) == 0 )
+           {
+            argIndex++;
+            settings->sizeCount = 0;
+
+            for( item = strtok( argv[ argIndex ], "," ); 
+                      item != NULL && settings->sizeCount < MAX_INGEST_SIZES;
+                                               item = strtok( NULL, "," ) )
+               {
+                settings->sizesMegabytes[ settings->sizeCount ] = atoll( item );
+
+                valid = valid 
+                         && settings->sizesMegabytes[ settings->sizeCount ] > 0;
+
+                settings->sizeCount++;
+               }
+           }
+
+        else if( strcmp( argv[ argIndex ], "--dir" ) == 0 )
+           {
+            argIndex++;
+            settings->directory = argv[ argIndex ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--output" ) == 0 )
+           {
+            argIndex++;
+            settings->outFileName = argv[ argIndex ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--seed" ) == 0 )
+           {
+            argIndex++;
+            settings->seed = strtoull( argv[ argIndex ], NULL, 10 );
+           }
+
+        else
+           {
+            valid = false;
+           }
+       }
+
+    return valid && settings->sizeCount > 0
+            && strlen( settings->directory ) < HUGE_STR_LEN - MIN_STR_LEN;
+   }
+
+/*
+Name: runStagedIngest
+Process: loads file the way uploadData does, but one stage at a time 
+         per block so each can be timed: reads block (I/O), 
+         finds comma and newline positions of its complete lines 
+         (tokenize), converts fields to names and temperatures (parse),
+         and adds rows to table (insert), skipped if table is NULL,
+         stops with message at first malformed line
+Function input/parameters: hash table, or NULL (ProbingHashType *),
+                           file name (const char *)
+Function output/parameters: stage results (IngestStagesType *),
+                            updated hash table (ProbingHashType *)
+Function output/returned: none
+Device input/file: data from HD
+Device output/monitor: message on malformed line
+Dependencies: fopen, malloc, getTimeNanoseconds, fread, scanFieldBoundaries,
+              skipWhiteSpace, parseDoubleFromSpan, addItemFromView, memmove,
+              printf, fclose, free
+*/
+void runStagedIngest( IngestStagesType *stages, ProbingHashType *hash,
+                                                        const char *fileName )
+   {
+    FILE *inFilePtr = fopen( fileName, "rb" );
+    char *block;
+    const char **boundaries;
+    const char *fieldStart, *fieldEnd, *stopPtr, *completeEnd, *dataEnd;
+    IngestRowType *rows;
+    double *fieldValue;
+    int carryLength = 0, boundaryCount, boundaryIndex, fieldIndex;
+    int rowCount, rowIndex;
+    size_t bytesRead;
+    long long stageStart;
+    bool endOfFile = false, atComma;
+
+    stages->rowCount = 0;
+    stages->ioNanoseconds = stages->tokenizeNanoseconds = 0;
+    stages->parseNanoseconds = stages->insertNanoseconds = 0;
+    stages->dataError = false;
+
+    if( inFilePtr == NULL )
+       {
+        return;
+       }
+
+    // every byte could be a boundary, every two bytes a row
+    block = (char *)malloc( INGEST_BLOCK_SIZE );
+    boundaries = (const char **)malloc( 
+                              ( INGEST_BLOCK_SIZE + 1 ) * sizeof( char * ) );
+    rows = (IngestRowType *)malloc( 
+                          ( INGEST_BLOCK_SIZE / 2 + 1 ) * sizeof( IngestRowType ) );
+
+    while( !endOfFile && !stages->dataError )
+       {
+        // I/O
+        stageStart = getTimeNanoseconds();
+
+        bytesRead = fread( block + carryLength, 1, 
+                                   INGEST_BLOCK_SIZE - carryLength, inFilePtr );
+
+        stages->ioNanoseconds += getTimeNanoseconds() - stageStart;
+
+        dataEnd = block + carryLength + bytesRead;
+        endOfFile = bytesRead < (size_t)( INGEST_BLOCK_SIZE - carryLength );
+
+        // complete lines only, unless at end or line fills block
+        completeEnd = dataEnd;
+
+        while( !endOfFile && completeEnd > block 
+                                     && completeEnd[ -1 ] != NEWLINE_CHAR )
+           {
+            completeEnd--;
+           }
+
+        completeEnd = completeEnd == block ? dataEnd : completeEnd;
+
+        // tokenize
+        stageStart = getTimeNanoseconds();
+
+        boundaryCount = scanFieldBoundaries( block, completeEnd, COMMA, 
+                                               boundaries, INGEST_BLOCK_SIZE );
+
+        stages->tokenizeNanoseconds += getTimeNanoseconds() - stageStart;
+
+        // parse, name then three numbers per line
+        stageStart = getTimeNanoseconds();
+
+        rowCount = 0;
+        fieldIndex = 0;
+        fieldStart = block;
+
+        // end of complete lines closes a last line without newline
+        boundaries[ boundaryCount ] = completeEnd;
+
+        for( boundaryIndex = 0; boundaryIndex <= boundaryCount 
+                                    && !stages->dataError; boundaryIndex++ )
+           {
+            fieldEnd = boundaries[ boundaryIndex ];
+            atComma = boundaryIndex < boundaryCount && *fieldEnd == COMMA;
+
+            // name, or blank line
+            if( fieldIndex == 0 )
+               {
+                if( atComma )
+                   {
+                    rows[ rowCount ].name = skipWhiteSpace( fieldStart, 
+                                                             fieldEnd, true );
+                    rows[ rowCount ].nameLength = (int)( fieldEnd 
+                                                    - rows[ rowCount ].name );
+                    fieldIndex = 1;
+                   }
+
+                else
+                   {
+                    stages->dataError = skipWhiteSpace( fieldStart, 
+                                                  fieldEnd, true ) != fieldEnd;
+                   }
+               }
+
+            // numbers end at commas, last one at end of line
+            else
+               {
+                fieldValue = fieldIndex == 1 ? &rows[ rowCount ].averageTemp
+                           : fieldIndex == 2 ? &rows[ rowCount ].lowestTemp
+                                             : &rows[ rowCount ].highestTemp;
+
+                stages->dataError = parseDoubleFromSpan( 
+                               skipWhiteSpace( fieldStart, fieldEnd, true ),
+                               fieldEnd, fieldValue, &stopPtr ) != PARSE_SUCCESS
+                                         || atComma != ( fieldIndex < 3 );
+
+                fieldIndex = ( fieldIndex + 1 ) % 4;
+                rowCount += fieldIndex == 0;
+               }
+
+            fieldStart = fieldEnd + 1;
+           }
+
+        stages->parseNanoseconds += getTimeNanoseconds() - stageStart;
+
+        // insert
+        stageStart = getTimeNanoseconds();
+
+        for( rowIndex = 0; rowIndex < rowCount && hash != NULL; rowIndex++ )
+           {
+            addItemFromView( hash, rows[ rowIndex ].name, 
+                             rows[ rowIndex ].nameLength, 
+                             rows[ rowIndex ].averageTemp,
+                             rows[ rowIndex ].lowestTemp, 
+                             rows[ rowIndex ].highestTemp );
+           }
+
+        stages->insertNanoseconds += getTimeNanoseconds() - stageStart;
+        stages->rowCount += rowCount;
+
+        if( stages->dataError )
+           {
+            printf( "\nData error in %s at line %lld\n", fileName, 
+                                                      stages->rowCount + 1 );
+           }
+
+        // carry partial line to front of block
+        carryLength = (int)( dataEnd - completeEnd );
+        memmove( block, completeEnd, carryLength );
+       }
+
+    free( rows );
+    free( boundaries );
+    free( block );
+    fclose( inFilePtr );
+   }
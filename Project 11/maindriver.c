@@ -1,6 +1,10 @@
 // header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
 #include "File_Input_Utility.c"
 #include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
 
 // constants
 extern const int ITEM_NOT_FOUND;
@@ -9,7 +13,6 @@ extern const bool UNUSED_NODE;
 
 // prototypes
 void getQueryObject( StateDataType *returnedState, const char *stateName );
-ProbingHashType *uploadData( char *fileName, int tableSize, int probeType );
 
 // main function
 int main( int argc, char *argv[] )
@@ -163,91 +166,3 @@ void getQueryObject( StateDataType *returnedState, const char *stateName )
    {
     setHashNodeFromData( returnedState, stateName, 0.0, 0.0, 0.0, 0.0 );      
    }
-
-    
-/*
-Name: getDataFromFile
-Process: uploads data from file with unknown number of data sets,
-         has internal Verbose Boolean to display input operation
-Function input/parameters: file name (char *)
-Function output/parameters: none
-Function output/returned: pointer to hash table (ProbingHashType *)
-Device input/file: data from HD
-Device output/monitor: none
-Dependencies: initializeHashTable, openInputFile, readStringToDelimiterFromFile,
-              readDoubleFromFile, readCharacterFromFile, printf, 
-              addItemFromData, closeInputFile, free
-*/
-ProbingHashType *uploadData( char *fileName, int tableSize, int probeType )
-   {
-    char stateNameStr[ MAX_STR_LEN ];
-    double avgTemp, lowestTemp, highestTemp;
-    int index = 0;
-    bool verbose = false;  // Set to true to verify data upload, false otherwise
-    ProbingHashType *tempHashPtr = initializeHashTable( tableSize, probeType );
-
-    if( openInputFile( fileName ) )
-       {
-        if( verbose )
-           {
-            printf( "\n     ----- Verbose: Begin Loading Data From File\n" );
-           }
-
-        // get first state name
-        readStringToDelimiterFromFile( COMMA, stateNameStr );
-
-        while( !checkForEndOfInputFile() )
-           {
-            avgTemp = readDoubleFromFile();
-
-            // ignores comma
-            readCharacterFromFile();
-
-            lowestTemp = readDoubleFromFile();
-
-            // ignores comma
-            readCharacterFromFile();
-
-            highestTemp = readDoubleFromFile();
-
-            if( verbose )
-               {
-                printf( "State Name: %s | ", stateNameStr );
-
-                printf( "Average Temp: %5.2f | ", avgTemp );
-
-                printf( "Lowest Temp: %5.2f | ", lowestTemp );
-
-                printf( "Highest Temp: %5.2f\n", highestTemp );
-               }
-
-            // add to hash table
-            addItemFromData( tempHashPtr, stateNameStr, 
-                                             avgTemp, lowestTemp, highestTemp );
-
-            // reprime - read next state name
-            readStringToDelimiterFromFile( COMMA, stateNameStr );
-
-            index++;
-           }
-
-        if( verbose )
-           {
-            printf( "\n     ----- Verbose: Items found in file: %d\n", index );
-            printf( "     ----- Verbose: End Loading Data From File\n\n" );
-           }
-
-        closeInputFile();
-       }
-
-    // file not found
-    else
-       {
-        free( tempHashPtr );
-       }
-
-    return tempHashPtr;
-   }
-    
-
-
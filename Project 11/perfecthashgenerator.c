@@ -0,0 +1,505 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Perfect_Hash_Utility.c"
+#include <ctype.h>
+
+// constants
+#define MAX_PREFIX_LEN 64
+
+// prototypes
+long long countCsvRows( const char *fileName );
+bool makeUpperPrefix( char *upperPrefix, const char *prefix );
+void writeDoubleLiteral( FILE *outFilePtr, double value );
+void writeNameLiteral( FILE *outFilePtr, const char *name );
+bool writePerfectHashHeader( const char *headerFileName,
+                           const FrozenHashType *frozen, const char *prefix,
+                                                     const char *dataFileName );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *dataFileName = "inData.csv";
+    const char *headerFileName = "State_Table_Generated.h";
+    const char *prefix = "StateTable";
+    ProbingHashType *hash;
+    FrozenHashType *frozen;
+    long long rowCount;
+    int tableSize, loadedRows;
+
+    // file names and name prefix from command line, if given
+    if( argc > 1 )
+       {
+        dataFileName = argv[ 1 ];
+       }
+
+    if( argc > 2 )
+       {
+        headerFileName = argv[ 2 ];
+       }
+
+    if( argc > 3 )
+       {
+        prefix = argv[ 3 ];
+       }
+
+    // title
+    printf( "\nPERFECT HASH TABLE GENERATOR\n" );
+    printf( "============================\n" );
+
+    rowCount = countCsvRows( dataFileName );
+
+    if( rowCount <= 0 )
+       {
+        printf( "\nNo keys found in %s\n", dataFileName );
+
+        return 1;
+       }
+
+    // build time table only, size for few collisions
+    tableSize = (int)( rowCount * 2 ) | 1;
+
+    hash = initializeHashTable( tableSize, LINEAR_PROBING );
+    setHashTableVerbose( hash, false );
+
+    loadedRows = uploadDataFromMap( hash, dataFileName );
+
+    frozen = loadedRows > 0 ? freezeHashTable( hash ) : NULL;
+
+    clearHashTable( hash );
+
+    if( frozen == NULL )
+       {
+        printf( "\nUnable to build perfect hash table from %s\n",
+                                                                dataFileName );
+
+        return 1;
+       }
+
+    if( !writePerfectHashHeader( headerFileName, frozen, prefix,
+                                                              dataFileName ) )
+       {
+        printf( "\nUnable to write %s\n", headerFileName );
+
+        clearFrozenHashTable( frozen );
+
+        return 1;
+       }
+
+    printf( "\n%d keys from %s written to %s (%d buckets, seed %llu)\n",
+                  frozen->slotCount, dataFileName, headerFileName,
+                  frozen->bucketCount, (unsigned long long)frozen->seed );
+
+    clearFrozenHashTable( frozen );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: countCsvRows
+Process: counts lines of CSV file, used to size build time table
+Function input/parameters: file name (const char *)
+Function output/parameters: none
+Function output/returned: number of lines, or -1 if file
+                          could not be opened (long long)
+Device input/file: data from HD
+Device output/---: none
+Dependencies: openMappedFile, memchr, closeMappedFile
+*/
+long long countCsvRows( const char *fileName )
+   {
+    MappedFileType *mappedFile = openMappedFile( fileName );
+    const char *linePtr, *endPtr;
+    long long rowCount = 0;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    linePtr = mappedFile->data;
+    endPtr = mappedFile->data + mappedFile->length;
+
+    while( linePtr < endPtr )
+       {
+        linePtr = (const char *)memchr( linePtr, NEWLINE_CHAR,
+                                                          endPtr - linePtr );
+
+        rowCount++;
+
+        linePtr = linePtr == NULL ? endPtr : linePtr + 1;
+       }
+
+    closeMappedFile( mappedFile );
+
+    return rowCount;
+   }
+
+/*
+Name: makeUpperPrefix
+Process: converts camel case prefix (e.g., StateTable) to upper case
+         constant prefix (e.g., STATE_TABLE), prefix must be a
+         C identifier starting with a letter
+Function input/parameters: prefix (const char *)
+Function output/parameters: upper case prefix (char *)
+Function output/returned: true if prefix is usable, false otherwise (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: isalpha, isalnum, isupper, toupper
+*/
+bool makeUpperPrefix( char *upperPrefix, const char *prefix )
+   {
+    int prefixIndex, upperIndex = 0;
+
+    if( !isalpha( (unsigned char)prefix[ 0 ] ) )
+       {
+        return false;
+       }
+
+    for( prefixIndex = 0; prefix[ prefixIndex ] != NULL_CHAR; prefixIndex++ )
+       {
+        if( ( !isalnum( (unsigned char)prefix[ prefixIndex ] )
+                                         && prefix[ prefixIndex ] != '_' )
+             || upperIndex >= MAX_PREFIX_LEN * 2 - 2 )
+           {
+            return false;
+           }
+
+        if( prefixIndex > 0 && isupper( (unsigned char)prefix[ prefixIndex ] )
+                                        && upperPrefix[ upperIndex - 1 ] != '_' )
+           {
+            upperPrefix[ upperIndex ] = '_';
+
+            upperIndex++;
+           }
+
+        upperPrefix[ upperIndex ]
+                          = (char)toupper( (unsigned char)prefix[ prefixIndex ] );
+
+        upperIndex++;
+       }
+
+    upperPrefix[ upperIndex ] = NULL_CHAR;
+
+    return true;
+   }
+
+/*
+Name: writeDoubleLiteral
+Process: writes double as shortest of 15 or 17 significant digits
+         that reads back to same value
+Function input/parameters: output file (FILE *), value (double)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/file: literal written to file
+Dependencies: sprintf, strtod, strchr, fprintf
+*/
+void writeDoubleLiteral( FILE *outFilePtr, double value )
+   {
+    char literal[ MAX_STR_LEN ];
+
+    sprintf( literal, "%.15g", value );
+
+    if( strtod( literal, NULL ) != value )
+       {
+        sprintf( literal, "%.17g", value );
+       }
+
+    // keep literal a double
+    if( strchr( literal, '.' ) == NULL && strchr( literal, 'e' ) == NULL
+                                         && strchr( literal, 'n' ) == NULL )
+       {
+        fprintf( outFilePtr, "%s.0", literal );
+       }
+
+    else
+       {
+        fprintf( outFilePtr, "%s", literal );
+       }
+   }
+
+/*
+Name: writeNameLiteral
+Process: writes name as C string literal, escaping quotes, backslashes,
+         question marks (so no trigraphs), and non printing characters
+         (as three digit octal)
+Function input/parameters: output file (FILE *), name (const char *)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/file: literal written to file
+Dependencies: fputc, fprintf, isprint
+*/
+void writeNameLiteral( FILE *outFilePtr, const char *name )
+   {
+    int index;
+    unsigned char nameChar;
+
+    fputc( '"', outFilePtr );
+
+    for( index = 0; name[ index ] != NULL_CHAR; index++ )
+       {
+        nameChar = (unsigned char)name[ index ];
+
+        if( nameChar == '"' || nameChar == '\\' )
+           {
+            fprintf( outFilePtr, "\\%c", nameChar );
+           }
+
+        else if( !isprint( nameChar ) || nameChar == '?' )
+           {
+            fprintf( outFilePtr, "\\%03o", nameChar );
+           }
+
+        else
+           {
+            fputc( nameChar, outFilePtr );
+           }
+       }
+
+    fputc( '"', outFilePtr );
+   }
+
+/*
+Name: writePerfectHashHeader
+Process: writes header holding frozen table as const initialized arrays
+         and static lookup functions, so table is built at compile time
+         and lives in read only memory; hash and slot functions written
+         must match getFrozenNameHash and getFrozenSlot
+Function input/parameters: header file name (const char *),
+                           frozen table (const FrozenHashType *),
+                           name prefix (const char *),
+                           data file name (const char *)
+Function output/parameters: none
+Function output/returned: true if header written, false otherwise (bool)
+Device input/---: none
+Device output/file: header written to HD
+Dependencies: makeUpperPrefix, fopen, fprintf, writeNameLiteral,
+              writeDoubleLiteral, fclose, remove
+*/
+bool writePerfectHashHeader( const char *headerFileName,
+                           const FrozenHashType *frozen, const char *prefix,
+                                                     const char *dataFileName )
+   {
+    char upper[ MAX_PREFIX_LEN * 2 ];
+    FILE *outFilePtr;
+    const StateDataType *node;
+    int index;
+    bool written;
+
+    if( !makeUpperPrefix( upper, prefix ) )
+       {
+        return false;
+       }
+
+    outFilePtr = fopen( headerFileName, "w" );
+
+    if( outFilePtr == NULL )
+       {
+        return false;
+       }
+
+    // header comment and guard
+    fprintf( outFilePtr,
+       "/*\n"
+       "Generated perfect hash table, do not edit\n"
+       "\n"
+       "Generated by perfecthashgenerator from %s, %d keys.\n"
+       "Table is const initialized, so it lives in read only memory and\n"
+       "needs no initializeHashTable or uploadData at startup; regenerate\n"
+       "when key list changes.\n"
+       "*/\n"
+       "\n"
+       "// PreProcessor test\n"
+       "#ifndef %s_GENERATED_H\n"
+       "#define %s_GENERATED_H\n"
+       "\n"
+       "// header files\n"
+       "#include <stdint.h>\n"
+       "#include <string.h>\n"
+       "#include \"HashUtilities.h\"\n"
+       "\n", dataFileName, frozen->slotCount, upper, upper );
+
+    // constants
+    fprintf( outFilePtr,
+       "// constants\n"
+       "\n"
+       "    static const int %s_SLOT_COUNT = %d;\n"
+       "\n"
+       "    static const int %s_BUCKET_COUNT = %d;\n"
+       "\n"
+       "    static const uint64_t %s_SEED = 0x%016llXULL;\n"
+       "\n"
+       "    // displacement pair of each bucket\n"
+       "    static const uint32_t %s_DISPLACEMENTS[ %d ] =\n"
+       "       {", upper, frozen->slotCount, upper, frozen->bucketCount,
+                         upper, (unsigned long long)frozen->seed,
+                                              upper, 2 * frozen->bucketCount );
+
+    for( index = 0; index < 2 * frozen->bucketCount; index++ )
+       {
+        fprintf( outFilePtr, "%s%s%lu", index > 0 ? "," : "",
+                                   index % 8 == 0 ? "\n        " : " ",
+                                   (unsigned long)frozen->displacements[ index ] );
+       }
+
+    fprintf( outFilePtr,
+       "\n"
+       "       };\n"
+       "\n"
+       "    // states, one per slot\n"
+       "    static const StateDataType %s_STATES[ %d ] =\n"
+       "       {\n", upper, frozen->slotCount );
+
+    for( index = 0; index < frozen->slotCount; index++ )
+       {
+        node = &frozen->array[ index ];
+
+        fprintf( outFilePtr, "        { " );
+        writeNameLiteral( outFilePtr, node->name );
+        fprintf( outFilePtr, ", " );
+        writeDoubleLiteral( outFilePtr, node->averageTemp );
+        fprintf( outFilePtr, ", " );
+        writeDoubleLiteral( outFilePtr, node->lowestTemp );
+        fprintf( outFilePtr, ", " );
+        writeDoubleLiteral( outFilePtr, node->highestTemp );
+        fprintf( outFilePtr, ", true }%s\n",
+                                 index < frozen->slotCount - 1 ? "," : "" );
+       }
+
+    fprintf( outFilePtr, "       };\n\n" );
+
+    // functions, same as getFrozenNameHash, getFrozenSlot,
+    // and findFrozenItemFromView
+    fprintf( outFilePtr,
+       "// functions\n"
+       "\n"
+       "/*\n"
+       "Name: get%sHash\n"
+       "Process: seeded 64 bit hash of name (FNV-1a with splitmix64 finish),\n"
+       "         same as getFrozenNameHash\n"
+       "Function input/parameters: name (const char *), name length (int)\n"
+       "Function output/parameters: none\n"
+       "Function output/returned: hash value (uint64_t)\n"
+       "Device input/---: none\n"
+       "Device output/---: none\n"
+       "Dependencies: none\n"
+       "*/\n"
+       "static inline uint64_t get%sHash( const char *name, int nameLength )\n"
+       "   {\n"
+       "    uint64_t hash = 0xCBF29CE484222325ULL ^ %s_SEED;\n"
+       "    int index;\n"
+       "\n"
+       "    for( index = 0; index < nameLength; index++ )\n"
+       "       {\n"
+       "        hash = ( hash ^ (unsigned char)name[ index ] ) "
+                                                       "* 0x100000001B3ULL;\n"
+       "       }\n"
+       "\n"
+       "    hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;\n"
+       "    hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;\n"
+       "\n"
+       "    return hash ^ ( hash >> 31 );\n"
+       "   }\n"
+       "\n", prefix, prefix, upper );
+
+    fprintf( outFilePtr,
+       "/*\n"
+       "Name: find%sItemFromView\n"
+       "Process: finds state by name given as pointer and length,\n"
+       "         one hash, one slot, one name check, names longer than\n"
+       "         STD_STR_LEN - 1 are truncated as they would be in the\n"
+       "         table, as findFrozenItemFromView does\n"
+       "Function input/parameters: name (const char *), name length (int)\n"
+       "Function output/parameters: none\n"
+       "Function output/returned: pointer to state, \n"
+       "                          or NULL if not found (const StateDataType *)\n"
+       "Device input/---: none\n"
+       "Device output/---: none\n"
+       "Dependencies: get%sHash, memcmp\n"
+       "*/\n"
+       "static inline const StateDataType *find%sItemFromView(\n"
+       "                                     const char *name, int nameLength )\n"
+       "   {\n"
+       "    uint64_t hash, offset, step;\n"
+       "    int bucket;\n"
+       "    const StateDataType *node;\n"
+       "\n"
+       "    if( nameLength > STD_STR_LEN - 1 )\n"
+       "       {\n"
+       "        nameLength = STD_STR_LEN - 1;\n"
+       "       }\n"
+       "\n"
+       "    hash = get%sHash( name, nameLength );\n"
+       "    bucket = (int)( hash %% (uint64_t)%s_BUCKET_COUNT );\n"
+       "    offset = ( hash >> 32 ) %% (uint64_t)%s_SLOT_COUNT;\n"
+       "    step = ( ( hash * 0x9E3779B97F4A7C15ULL ) >> 32 )\n"
+       "                                        %% (uint64_t)%s_SLOT_COUNT;\n"
+       "\n"
+       "    node = &%s_STATES[ ( offset\n"
+       "                   + %s_DISPLACEMENTS[ 2 * bucket ] * step\n"
+       "                   + %s_DISPLACEMENTS[ 2 * bucket + 1 ] )\n"
+       "                                    %% (uint64_t)%s_SLOT_COUNT ];\n"
+       "\n"
+       "    if( node->name[ nameLength ] == NULL_CHAR\n"
+       "                         && memcmp( node->name, name, nameLength ) "
+                                                              "== 0 )\n"
+       "       {\n"
+       "        return node;\n"
+       "       }\n"
+       "\n"
+       "    return NULL;\n"
+       "   }\n"
+       "\n", prefix, prefix, prefix, prefix, upper, upper, upper,
+                                                  upper, upper, upper, upper );
+
+    fprintf( outFilePtr,
+       "/*\n"
+       "Name: find%sItem\n"
+       "Process: finds state by name, names longer than STD_STR_LEN - 1\n"
+       "         are truncated as they would be in the table\n"
+       "Function input/parameters: state name (const char *)\n"
+       "Function output/parameters: none\n"
+       "Function output/returned: pointer to state, \n"
+       "                          or NULL if not found (const StateDataType *)\n"
+       "Device input/---: none\n"
+       "Device output/---: none\n"
+       "Dependencies: strlen, find%sItemFromView\n"
+       "*/\n"
+       "static inline const StateDataType *find%sItem(\n"
+       "                                                const char *stateName )\n"
+       "   {\n"
+       "    size_t nameLength = strlen( stateName );\n"
+       "\n"
+       "    if( nameLength > STD_STR_LEN - 1 )\n"
+       "       {\n"
+       "        nameLength = STD_STR_LEN - 1;\n"
+       "       }\n"
+       "\n"
+       "    return find%sItemFromView( stateName, (int)nameLength );\n"
+       "   }\n"
+       "\n"
+       "#endif  // %s_GENERATED_H\n", prefix, prefix, prefix, prefix, upper );
+
+    written = !ferror( outFilePtr );
+
+    if( fclose( outFilePtr ) != 0 )
+       {
+        written = false;
+       }
+
+    if( !written )
+       {
+        remove( headerFileName );
+       }
+
+    return written;
+   }
@@ -0,0 +1,138 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Name_Index_Utility.c"
+
+// constants
+#define MAX_PREFIX_RESULTS 64
+#define PREFIX_COUNT 5
+
+// prototypes
+void displayPrefixResults( const char *prefix,
+                         const StateDataType **results, int foundCount );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *dataFileName = "inData.csv";
+    const char *prefixes[ PREFIX_COUNT ] = { "New", "North", "M", "Ala",
+                                                                   "Quebec" };
+    const StateDataType *results[ MAX_PREFIX_RESULTS ];
+    ProbingHashType *hash;
+    NameIndexType *index;
+    StateDataType toRemove, removed;
+    int tableSize = 67, loadedRows, foundCount, prefixIndex;
+
+    if( argc > 1 )
+       {
+        dataFileName = argv[ 1 ];
+       }
+
+    if( argc > 2 )
+       {
+        tableSize = atoi( argv[ 2 ] );
+       }
+
+    // title
+    printf( "\nNAME PREFIX QUERY PROGRAM\n" );
+    printf( "=========================\n" );
+
+    hash = initializeHashTable( tableSize, LINEAR_PROBING );
+    setHashTableVerbose( hash, false );
+
+    loadedRows = uploadDataFromMap( hash, dataFileName );
+
+    if( loadedRows < 0 )
+       {
+        printf( "\nUnable to open %s\n", dataFileName );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    index = createNameIndex( hash );
+
+    if( index == NULL )
+       {
+        printf( "\nUnable to create name index\n" );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    printf( "\n%d states loaded from %s, %d indexed\n",
+                          loadedRows, dataFileName, index->root->subtreeCount );
+
+    for( prefixIndex = 0; prefixIndex < PREFIX_COUNT; prefixIndex++ )
+       {
+        foundCount = findNamePrefix( index, prefixes[ prefixIndex ],
+                                   getStringLength( prefixes[ prefixIndex ] ),
+                                                 results, MAX_PREFIX_RESULTS );
+
+        displayPrefixResults( prefixes[ prefixIndex ], results, foundCount );
+       }
+
+    // index follows table changes
+    printf( "\n\nRemoving New York -----------------------------------------" );
+
+    setHashNodeFromData( &toRemove, "New York", 0.0, 0.0, 0.0, UNUSED_NODE );
+
+    if( removeState( &removed, toRemove, *hash ) )
+       {
+        foundCount = findNamePrefix( index, "New", 3, results,
+                                                         MAX_PREFIX_RESULTS );
+        displayPrefixResults( "New", results, foundCount );
+       }
+
+    printf( "\n\nAdding New York Back --------------------------------------" );
+
+    addItemFromStruct( hash, removed );
+
+    foundCount = findNamePrefix( index, "New Y", 5, results,
+                                                         MAX_PREFIX_RESULTS );
+    displayPrefixResults( "New Y", results, foundCount );
+
+    clearNameIndex( index );
+    clearHashTable( hash );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: displayPrefixResults
+Process: displays prefix and states found with it, one per line,
+         up to MAX_PREFIX_RESULTS of them
+Function input/parameters: prefix (const char *),
+                           states found (const StateDataType **),
+                           number of states found (int)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/monitor: states displayed
+Dependencies: dataToString, printf
+*/
+void displayPrefixResults( const char *prefix,
+                          const StateDataType **results, int foundCount )
+   {
+    char displayStr[ MAX_STR_LEN ];
+    int index;
+
+    printf( "\n\nStates Starting With \"%s\"\n", prefix );
+
+    for( index = 0; index < foundCount && index < MAX_PREFIX_RESULTS; index++ )
+       {
+        dataToString( displayStr, *results[ index ] );
+        printf( "%s\n", displayStr );
+       }
+
+    printf( "%d found\n", foundCount );
+   }
@@ -0,0 +1,140 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Temperature_Index_Utility.c"
+
+// constants
+#define MAX_QUERY_RESULTS 64
+#define TOP_COUNT 5
+
+// prototypes
+void displayQueryResults( const StateDataType **results, int foundCount );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *dataFileName = "inData.csv";
+    const StateDataType *results[ MAX_QUERY_RESULTS ];
+    ProbingHashType *hash;
+    TemperatureIndexType *index;
+    StateDataType toRemove, removed;
+    int tableSize = 67, loadedRows, foundCount;
+
+    if( argc > 1 )
+       {
+        dataFileName = argv[ 1 ];
+       }
+
+    if( argc > 2 )
+       {
+        tableSize = atoi( argv[ 2 ] );
+       }
+
+    // title
+    printf( "\nTEMPERATURE QUERY PROGRAM\n" );
+    printf( "=========================\n" );
+
+    hash = initializeHashTable( tableSize, LINEAR_PROBING );
+    setHashTableVerbose( hash, false );
+
+    loadedRows = uploadDataFromMap( hash, dataFileName );
+
+    if( loadedRows < 0 )
+       {
+        printf( "\nUnable to open %s\n", dataFileName );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    index = createTemperatureIndex( hash );
+
+    if( index == NULL )
+       {
+        printf( "\nUnable to create temperature index\n" );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    printf( "\n%d states loaded from %s, %d indexed\n",
+                                     loadedRows, dataFileName, index->count );
+
+    printf( "\n\nAverage Temperature 45 To 55 ------------------------------\n" );
+
+    foundCount = findTemperatureRange( index, AVERAGE_TEMP_FIELD, 45.0, 55.0,
+                                                 results, MAX_QUERY_RESULTS );
+    displayQueryResults( results, foundCount );
+
+    printf( "\n\nLowest Temperature At Or Below -40 ------------------------\n" );
+
+    foundCount = findTemperatureRange( index, LOWEST_TEMP_FIELD, -HUGE_VAL,
+                                         -40.0, results, MAX_QUERY_RESULTS );
+    displayQueryResults( results, foundCount );
+
+    printf( "\n\nFive Highest Record Temperatures --------------------------\n" );
+
+    foundCount = findTopTemperatures( index, HIGHEST_TEMP_FIELD, TOP_COUNT,
+                                                             true, results );
+    displayQueryResults( results, foundCount );
+
+    // index follows table changes
+    printf( "\n\nRemoving Arizona, Five Highest Record Temperatures --------\n" );
+
+    setHashNodeFromData( &toRemove, "Arizona", 0.0, 0.0, 0.0, UNUSED_NODE );
+
+    if( removeState( &removed, toRemove, *hash ) )
+       {
+        foundCount = findTopTemperatures( index, HIGHEST_TEMP_FIELD, TOP_COUNT,
+                                                             true, results );
+        displayQueryResults( results, foundCount );
+       }
+
+    printf( "\n\nAdding Arizona Back, Five Lowest Average Temperatures -----\n" );
+
+    addItemFromStruct( hash, removed );
+
+    foundCount = findTopTemperatures( index, AVERAGE_TEMP_FIELD, TOP_COUNT,
+                                                            false, results );
+    displayQueryResults( results, foundCount );
+
+    clearTemperatureIndex( index );
+    clearHashTable( hash );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: displayQueryResults
+Process: displays states found by query, one per line,
+         up to MAX_QUERY_RESULTS of them
+Function input/parameters: states found (const StateDataType **),
+                           number of states found (int)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/monitor: states displayed
+Dependencies: dataToString, printf
+*/
+void displayQueryResults( const StateDataType **results, int foundCount )
+   {
+    char displayStr[ MAX_STR_LEN ];
+    int index;
+
+    for( index = 0; index < foundCount && index < MAX_QUERY_RESULTS; index++ )
+       {
+        dataToString( displayStr, *results[ index ] );
+        printf( "%s\n", displayStr );
+       }
+
+    printf( "%d found\n", foundCount );
+   }
@@ -0,0 +1,441 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Binary_Data_Utility.c"
+#include "Benchmark_Utility.c"
+#include <string.h>
+
+// data structures
+
+    // one operation from log, name points into mapped log
+    typedef struct ReplayOpStruct
+       {
+        char code;
+        StringViewType name;
+        double averageTemp, lowestTemp, highestTemp;
+       } ReplayOpType;
+
+    // replay settings from command line
+    typedef struct ReplaySettingsStruct
+       {
+        const char *dataFileName;
+        const char *opLogFileName;
+        const char *outFileName;
+        int tableSize;
+        ProbeType probe;
+       } ReplaySettingsType;
+
+// prototypes
+long long countDataRows( const char *fileName );
+long long readOperationLog( ReplayOpType **opsPtr, long long *insertCount,
+                                                  MappedFileType *mappedLog );
+bool readReplaySettings( ReplaySettingsType *settings, 
+                                                      int argc, char *argv[] );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    ReplaySettingsType settings;
+    MappedFileType *mappedLog;
+    ReplayOpType *ops;
+    ProbingHashType *hash;
+    LatencyLogType *insertLog, *findLog, *removeLog;
+    StateDataType key, removed;
+    FILE *outFilePtr;
+    long long opCount, opIndex, insertCount, dataRows = 0, loadedRows = 0;
+    long long hitCount = 0, removedCount = 0, opStart, replayStart, loadStart;
+    long long replayNanoseconds, loadNanoseconds = 0;
+    int nameLength;
+
+    // title
+    printf( "\nOPERATION LOG REPLAY\n" );
+    printf( "====================\n" );
+
+    if( !readReplaySettings( &settings, argc, argv ) )
+       {
+        printf( "\nUsage: replaydriver [--data file] [--ops file]"
+                "\n                   [--table-size n] [--probe linear|quadratic]"
+                "\n                   [--output file]\n" );
+
+        return 1;
+       }
+
+    // operations held in memory, so only table work is timed
+    mappedLog = openMappedFile( settings.opLogFileName );
+
+    if( mappedLog == NULL )
+       {
+        printf( "\nUnable to open %s\n", settings.opLogFileName );
+
+        return 1;
+       }
+
+    opCount = readOperationLog( &ops, &insertCount, mappedLog );
+
+    if( settings.dataFileName != NULL )
+       {
+        dataRows = countDataRows( settings.dataFileName );
+
+        if( dataRows < 0 )
+           {
+            printf( "\nUnable to open %s\n", settings.dataFileName );
+
+            return 1;
+           }
+       }
+
+    // room for every row at about 1.3x, odd size
+    if( settings.tableSize <= 0 )
+       {
+        settings.tableSize = (int)( ( dataRows + insertCount ) * 1.3 ) | 1;
+        settings.tableSize = settings.tableSize < 3 ? 3 : settings.tableSize;
+       }
+
+    hash = initializeHashTable( settings.tableSize, settings.probe );
+    setHashTableVerbose( hash, false );
+
+    // binary data file first, CSV otherwise
+    if( settings.dataFileName != NULL )
+       {
+        loadStart = getTimeNanoseconds();
+
+        loadedRows = uploadDataFromBinary( hash, settings.dataFileName );
+
+        if( loadedRows < 0 )
+           {
+            loadedRows = uploadDataFromMap( hash, settings.dataFileName );
+           }
+
+        loadNanoseconds = getTimeNanoseconds() - loadStart;
+       }
+
+    insertLog = createLatencyLog( insertCount );
+    findLog = createLatencyLog( opCount - insertCount );
+    removeLog = createLatencyLog( opCount - insertCount );
+
+    // replay
+    replayStart = getTimeNanoseconds();
+
+    for( opIndex = 0; opIndex < opCount; opIndex++ )
+       {
+        if( ops[ opIndex ].code == 'I' )
+           {
+            opStart = getTimeNanoseconds();
+            addItemFromView( hash, ops[ opIndex ].name.start, 
+                             ops[ opIndex ].name.length, 
+                             ops[ opIndex ].averageTemp, 
+                             ops[ opIndex ].lowestTemp, 
+                             ops[ opIndex ].highestTemp );
+            addLatencySample( insertLog, getTimeNanoseconds() - opStart );
+           }
+
+        else
+           {
+            // search key built outside timing
+            nameLength = ops[ opIndex ].name.length < STD_STR_LEN - 1 ?
+                                 ops[ opIndex ].name.length : STD_STR_LEN - 1;
+            memcpy( key.name, ops[ opIndex ].name.start, nameLength );
+            key.name[ nameLength ] = NULL_CHAR;
+
+            if( ops[ opIndex ].code == 'F' )
+               {
+                opStart = getTimeNanoseconds();
+                hitCount += findItemIndex( hash, key ) != ITEM_NOT_FOUND;
+                addLatencySample( findLog, getTimeNanoseconds() - opStart );
+               }
+
+            else
+               {
+                opStart = getTimeNanoseconds();
+                removedCount += removeState( &removed, key, *hash );
+                addLatencySample( removeLog, getTimeNanoseconds() - opStart );
+               }
+           }
+       }
+
+    replayNanoseconds = getTimeNanoseconds() - replayStart;
+
+    insertLog->totalNanoseconds = replayNanoseconds;
+    findLog->totalNanoseconds = replayNanoseconds;
+    removeLog->totalNanoseconds = replayNanoseconds;
+
+    // report
+    printf( "\nTable size %d, %s probing, %lld rows loaded in %.3f s\n",
+               settings.tableSize, 
+               settings.probe == QUADRATIC_PROBING ? "quadratic" : "linear",
+                                        loadedRows, loadNanoseconds / 1e9 );
+    printf( "\n%lld operations in %.3f s, %.0f ops/s\n", opCount, 
+                                                 replayNanoseconds / 1e9,
+                  replayNanoseconds > 0 ? opCount / ( replayNanoseconds / 1e9 ) 
+                                                                      : 0.0 );
+    printf( "   inserts: %lld, p50 %lld ns, p99 %lld ns\n", insertLog->count,
+                                        getLatencyPercentile( insertLog, 50.0 ), 
+                                        getLatencyPercentile( insertLog, 99.0 ) );
+    printf( "   finds:   %lld (%lld hits), p50 %lld ns, p99 %lld ns\n", 
+                                  findLog->count, hitCount,
+                                  getLatencyPercentile( findLog, 50.0 ), 
+                                  getLatencyPercentile( findLog, 99.0 ) );
+    printf( "   removes: %lld (%lld removed), p50 %lld ns, p99 %lld ns\n", 
+                                  removeLog->count, removedCount,
+                                  getLatencyPercentile( removeLog, 50.0 ), 
+                                  getLatencyPercentile( removeLog, 99.0 ) );
+
+    if( settings.outFileName != NULL )
+       {
+        outFilePtr = fopen( settings.outFileName, "w" );
+
+        if( outFilePtr != NULL )
+           {
+            fprintf( outFilePtr, "{\n  \"benchmark\": \"operation_replay\",\n"
+                     "  \"table_size\": %d, \"rows_loaded\": %lld, "
+                     "\"load_seconds\": %.6f,\n  \"operations\": %lld, "
+                     "\"seconds\": %.6f, \"hits\": %lld, \"removed\": %lld,\n  ",
+                     settings.tableSize, loadedRows, loadNanoseconds / 1e9, 
+                     opCount, replayNanoseconds / 1e9, hitCount, removedCount );
+
+            // per operation seconds are their share of replay
+            insertLog->totalNanoseconds = 0;
+            findLog->totalNanoseconds = 0;
+            removeLog->totalNanoseconds = 0;
+
+            for( opIndex = 0; opIndex < insertLog->count; opIndex++ )
+               {
+                insertLog->totalNanoseconds += insertLog->samples[ opIndex ];
+               }
+
+            for( opIndex = 0; opIndex < findLog->count; opIndex++ )
+               {
+                findLog->totalNanoseconds += findLog->samples[ opIndex ];
+               }
+
+            for( opIndex = 0; opIndex < removeLog->count; opIndex++ )
+               {
+                removeLog->totalNanoseconds += removeLog->samples[ opIndex ];
+               }
+
+            writeLatencyJson( outFilePtr, "insert", insertLog );
+            fprintf( outFilePtr, ",\n  " );
+            writeLatencyJson( outFilePtr, "find", findLog );
+            fprintf( outFilePtr, ",\n  " );
+            writeLatencyJson( outFilePtr, "remove", removeLog );
+            fprintf( outFilePtr, "\n}\n" );
+
+            fclose( outFilePtr );
+
+            printf( "\nResults written to %s\n", settings.outFileName );
+           }
+       }
+
+    clearLatencyLog( insertLog );
+    clearLatencyLog( findLog );
+    clearLatencyLog( removeLog );
+    clearHashTable( hash );
+    free( ops );
+    closeMappedFile( mappedLog );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: countDataRows
+Process: finds number of rows in data file, from header of binary
+         data file, or by counting lines of CSV file
+Function input/parameters: file name (const char *)
+Function output/parameters: none
+Function output/returned: number of rows, or -1 if file 
+                          could not be opened (long long)
+Device input/file: data from HD
+Device output/---: none
+Dependencies: openMappedFile, memcmp, memcpy, memchr, closeMappedFile
+*/
+long long countDataRows( const char *fileName )
+   {
+    MappedFileType *mappedFile = openMappedFile( fileName );
+    BinaryDataHeaderType header;
+    const char *linePtr, *endPtr;
+    long long rowCount = 0;
+
+    if( mappedFile == NULL )
+       {
+        return -1;
+       }
+
+    if( mappedFile->length >= sizeof( header ) 
+         && memcmp( mappedFile->data, BINARY_DATA_MAGIC, 
+                                             sizeof( BINARY_DATA_MAGIC ) ) == 0 )
+       {
+        memcpy( &header, mappedFile->data, sizeof( header ) );
+
+        rowCount = (long long)header.recordCount;
+       }
+
+    else
+       {
+        linePtr = mappedFile->data;
+        endPtr = mappedFile->data + mappedFile->length;
+
+        while( linePtr < endPtr )
+           {
+            linePtr = (const char *)memchr( linePtr, NEWLINE_CHAR, 
+                                                       endPtr - linePtr );
+
+            rowCount++;
+
+            linePtr = linePtr == NULL ? endPtr : linePtr + 1;
+           }
+       }
+
+    closeMappedFile( mappedFile );
+
+    return rowCount;
+   }
+
+/*
+Name: readOperationLog
+Process: reads whole operation log into array, stops at first
+         malformed line with message (see workloadgenerator)
+Function input/parameters: mapped operation log (MappedFileType *)
+Function output/parameters: allocated operations (ReplayOpType **),
+                            number of inserts (long long *)
+Function output/returned: number of operations (long long)
+Device input/---: none
+Device output/monitor: message on malformed line
+Dependencies: malloc, realloc, readViewToDelimiterFromMap, 
+              readDoubleFromMap, readCharacterFromMap, getMapParseStatus,
+              printf
+*/
+long long readOperationLog( ReplayOpType **opsPtr, long long *insertCount,
+                                                   MappedFileType *mappedLog )
+   {
+    long long opCount = 0, opCapacity = 4096;
+    ReplayOpType *ops = (ReplayOpType *)malloc( 
+                                         opCapacity * sizeof( ReplayOpType ) );
+    StringViewType codeView;
+    size_t errorOffset;
+
+    *insertCount = 0;
+
+    while( readViewToDelimiterFromMap( mappedLog, COMMA, &codeView ) )
+       {
+        if( opCount == opCapacity )
+           {
+            opCapacity *= 2;
+            ops = (ReplayOpType *)realloc( ops, 
+                                         opCapacity * sizeof( ReplayOpType ) );
+           }
+
+        ops[ opCount ].code = codeView.length == 1 ? codeView.start[ 0 ] : '?';
+
+        if( ops[ opCount ].code == 'I' )
+           {
+            readViewToDelimiterFromMap( mappedLog, COMMA, 
+                                                      &ops[ opCount ].name );
+
+            ops[ opCount ].averageTemp = readDoubleFromMap( mappedLog );
+
+            // ignores comma
+            readCharacterFromMap( mappedLog );
+
+            ops[ opCount ].lowestTemp = readDoubleFromMap( mappedLog );
+
+            // ignores comma
+            readCharacterFromMap( mappedLog );
+
+            ops[ opCount ].highestTemp = readDoubleFromMap( mappedLog );
+
+            *insertCount += 1;
+           }
+
+        else if( ops[ opCount ].code == 'F' || ops[ opCount ].code == 'R' )
+           {
+            readViewToDelimiterFromMap( mappedLog, NEWLINE_CHAR, 
+                                                      &ops[ opCount ].name );
+           }
+
+        if( ( ops[ opCount ].code != 'I' && ops[ opCount ].code != 'F' 
+                                         && ops[ opCount ].code != 'R' )
+             || getMapParseStatus( mappedLog, &errorOffset ) != PARSE_SUCCESS )
+           {
+            printf( "\nOperation log error at operation %lld\n", opCount + 1 );
+
+            break;
+           }
+
+        opCount++;
+       }
+
+    *opsPtr = ops;
+
+    return opCount;
+   }
+
+/*
+Name: readReplaySettings
+Process: sets defaults, then reads options from command line
+Function input/parameters: argument count (int), arguments (char *[])
+Function output/parameters: replay settings (ReplaySettingsType *)
+Function output/returned: false if an option is unknown or invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: strcmp, atoi
+*/
+bool readReplaySettings( ReplaySettingsType *settings, 
+                                                       int argc, char *argv[] )
+   {
+    int argIndex;
+    bool valid = true;
+
+    // defaults, table sized from data
+    settings->dataFileName = NULL;
+    settings->opLogFileName = "workload.ops";
+    settings->outFileName = NULL;
+    settings->tableSize = 0;
+    settings->probe = LINEAR_PROBING;
+
+    for( argIndex = 1; argIndex + 1 < argc && valid; argIndex += 2 )
+       {
+        if( strcmp( argv[ argIndex ], "--data" ) == 0 )
+           {
+            settings->dataFileName = argv[ argIndex + 1 ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--ops" ) == 0 )
+           {
+            settings->opLogFileName = argv[ argIndex + 1 ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--output" ) == 0 )
+           {
+            settings->outFileName = argv[ argIndex + 1 ];
+           }
+
+        else if( strcmp( argv[ argIndex ], "--table-size" ) == 0 )
+           {
+            settings->tableSize = atoi( argv[ argIndex + 1 ] );
+            valid = settings->tableSize > 0;
+           }
+
+        else if( strcmp( argv[ argIndex ], "--probe" ) == 0 )
+           {
+            valid = strcmp( argv[ argIndex + 1 ], "linear" ) == 0 
+                     || strcmp( argv[ argIndex + 1 ], "quadratic" ) == 0;
+            settings->probe = strcmp( argv[ argIndex + 1 ], "quadratic" ) == 0 ?
+                                             QUADRATIC_PROBING : LINEAR_PROBING;
+           }
+
+        else
+           {
+            valid = false;
+           }
+       }
+
+    // odd argument count leaves an option without value
+    return valid && argIndex == argc;
+   }
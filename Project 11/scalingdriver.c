@@ -0,0 +1,594 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Binary_Data_Utility.c"
+#include "Benchmark_Utility.c"
+#include "Workload_Utility.c"
+#include <pthread.h>
+#include <string.h>
+
+// constants
+
+    // most thread counts accepted on command line
+    #define MAX_THREAD_COUNTS 32
+
+// data structures
+
+    // table locking used for a run
+    typedef enum { GLOBAL_MUTEX, READ_WRITE_LOCK } TableLockType;
+
+    // scaling settings from command line
+    typedef struct ScalingSettingsStruct
+       {
+        int threadCounts[ MAX_THREAD_COUNTS ];
+        int threadCountCount;
+        TableLockType locks[ 2 ];
+        int lockCount;
+        long long keyCount;
+        long long opsPerThread;
+        int readPercent;
+        double zipfExponent;
+        unsigned long long seed;
+        const char *outFileName;
+        HashAllocationOptionsType allocation;
+       } ScalingSettingsType;
+
+    // state shared by threads of one run
+    typedef struct ScalingRunStruct
+       {
+        ProbingHashType *hash;
+        const StateDataType *keys;
+        ZipfGeneratorType zipf;
+        const ScalingSettingsType *settings;
+        TableLockType lock;
+        pthread_mutex_t tableMutex;
+        pthread_rwlock_t tableRwLock;
+        pthread_mutex_t startMutex;
+        pthread_cond_t startSignal;
+        bool started;
+       } ScalingRunType;
+
+    // one thread of a run
+    typedef struct ScalingThreadStruct
+       {
+        pthread_t thread;
+        ScalingRunType *run;
+        LatencyLogType *readLog;
+        LatencyLogType *writeLog;
+        unsigned long long randomState;
+       } ScalingThreadType;
+
+// prototypes
+const char *getAllocationName( HashAllocationKindType kind );
+const char *getLockName( TableLockType lock );
+bool readScalingSettings( ScalingSettingsType *settings, 
+                                                      int argc, char *argv[] );
+void runScalingStep( FILE *outFilePtr, ScalingRunType *run, int threadCount );
+void *scalingWorker( void *threadPtr );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    ScalingSettingsType settings;
+    WorkloadSettingsType workload;
+    ScalingRunType run;
+    StateDataType *keys;
+    FILE *outFilePtr;
+    long long keyIndex;
+    int lockIndex, countIndex, nameLength;
+    bool firstResult = true;
+
+    // title
+    printf( "\nMULTI THREADED SCALING BENCHMARK\n" );
+    printf( "================================\n" );
+
+    if( !readScalingSettings( &settings, argc, argv ) )
+       {
+        printf( "\nUsage: scalingdriver [--threads n,n,...] [--keys n]"
+                "\n                   [--ops n] [--read-percent n] [--zipf s]"
+                "\n                   [--lock mutex|rwlock|both] [--seed n]"
+                "\n                   [--pages 4k|2m|1g]"
+                "\n                   [--numa default|local|interleave|node]"
+                "\n                   [--output file]\n" );
+
+        return 1;
+       }
+
+    outFilePtr = fopen( settings.outFileName, "w" );
+
+    if( outFilePtr == NULL )
+       {
+        printf( "\nUnable to open %s\n", settings.outFileName );
+
+        return 1;
+       }
+
+    // keys from workload generator, table at half load
+    setDefaultWorkloadSettings( &workload );
+    workload.seed = settings.seed;
+
+    keys = (StateDataType *)malloc( settings.keyCount * sizeof( StateDataType ) );
+
+    for( keyIndex = 0; keyIndex < settings.keyCount; keyIndex++ )
+       {
+        nameLength = makeWorkloadName( keys[ keyIndex ].name, &workload, 
+                                                                   keyIndex );
+        keys[ keyIndex ].name[ nameLength ] = NULL_CHAR;
+        keys[ keyIndex ].averageTemp = keyIndex % 100;
+        keys[ keyIndex ].lowestTemp = keys[ keyIndex ].averageTemp - 20.0;
+        keys[ keyIndex ].highestTemp = keys[ keyIndex ].averageTemp + 20.0;
+        keys[ keyIndex ].inUse = USED_NODE;
+       }
+
+    // large tables take huge pages and NUMA placement if asked for
+    run.hash = initializeHashTableWithOptions( 
+                (int)( settings.keyCount * 2 + 1 ), 
+                (int)( settings.keyCount * 2 + 1 ), LINEAR_PROBING, 
+                                                     &settings.allocation );
+    setHashTableVerbose( run.hash, false );
+
+    printf( "\nLoading %lld keys", settings.keyCount );
+    fflush( stdout );
+
+    for( keyIndex = 0; keyIndex < settings.keyCount; keyIndex++ )
+       {
+        addItemFromStruct( run.hash, keys[ keyIndex ] );
+       }
+
+    run.keys = keys;
+    run.settings = &settings;
+    initializeZipfGenerator( &run.zipf, settings.keyCount, 
+                                                     settings.zipfExponent );
+    pthread_mutex_init( &run.tableMutex, NULL );
+    pthread_rwlock_init( &run.tableRwLock, NULL );
+    pthread_mutex_init( &run.startMutex, NULL );
+    pthread_cond_init( &run.startSignal, NULL );
+
+    fprintf( outFilePtr, "{\n  \"benchmark\": \"multi_threaded_scaling\",\n"
+             "  \"keys\": %lld, \"table_size\": %d, \"ops_per_thread\": %lld, "
+             "\"read_percent\": %d, \"zipf\": %.3f,\n"
+             "  \"allocation\": \"%s\", \"numa_placed\": %s,\n"
+             "  \"results\": [",
+             settings.keyCount, run.hash->tableSize, settings.opsPerThread,
+                             settings.readPercent, settings.zipfExponent,
+                  getAllocationName( run.hash->arrayAllocation.kind ),
+                     run.hash->arrayAllocation.numaPlaced ? "true" : "false" );
+
+    // each lock, each thread count
+    for( lockIndex = 0; lockIndex < settings.lockCount; lockIndex++ )
+       {
+        run.lock = settings.locks[ lockIndex ];
+
+        for( countIndex = 0; countIndex < settings.threadCountCount; 
+                                                                countIndex++ )
+           {
+            fprintf( outFilePtr, firstResult ? "\n" : ",\n" );
+            firstResult = false;
+
+            runScalingStep( outFilePtr, &run, 
+                                         settings.threadCounts[ countIndex ] );
+           }
+       }
+
+    fprintf( outFilePtr, "\n  ]\n}\n" );
+    fclose( outFilePtr );
+
+    pthread_cond_destroy( &run.startSignal );
+    pthread_mutex_destroy( &run.startMutex );
+    pthread_rwlock_destroy( &run.tableRwLock );
+    pthread_mutex_destroy( &run.tableMutex );
+    clearHashTable( run.hash );
+    free( keys );
+
+    printf( "\n\nResults written to %s\n", settings.outFileName );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: getAllocationName
+Process: finds display name of table array allocation kind
+Function input/parameters: allocation kind (HashAllocationKindType)
+Function output/parameters: none
+Function output/returned: name of allocation kind (const char *)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+const char *getAllocationName( HashAllocationKindType kind )
+   {
+    if( kind == HUGE_PAGE_ALLOCATION )
+       {
+        return "huge_pages";
+       }
+
+    if( kind == TRANSPARENT_HUGE_ALLOCATION )
+       {
+        return "transparent_huge_pages";
+       }
+
+    if( kind == MAPPED_ALLOCATION )
+       {
+        return "mapped";
+       }
+
+    return "heap";
+   }
+
+/*
+Name: getLockName
+Process: finds display name of table lock
+Function input/parameters: table lock (TableLockType)
+Function output/parameters: none
+Function output/returned: name of lock (const char *)
+Device input/---: none
+Device output/---: none
+Dependencies: none
+*/
+const char *getLockName( TableLockType lock )
+   {
+    return lock == READ_WRITE_LOCK ? "rwlock" : "mutex";
+   }
+
+/*
+Name: readScalingSettings
+Process: sets defaults, then reads options from command line,
+         default thread counts are powers of two up to all processors,
+         NUMA option is a policy name or node number to bind to
+Function input/parameters: argument count (int), arguments (char *[])
+Function output/parameters: scaling settings (ScalingSettingsType *)
+Function output/returned: false if an option is unknown or invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: getProcessorCount, strcmp, strtok, atoi, atoll, atof, 
+              strtoull
+*/
+bool readScalingSettings( ScalingSettingsType *settings, 
+                                                       int argc, char *argv[] )
+   {
+    int argIndex, threadCount, processorCount = getProcessorCount();
+    const char *option;
+    char *value, *item;
+    bool valid = true;
+
+    // defaults
+    settings->threadCountCount = 0;
+
+    for( threadCount = 1; threadCount < processorCount 
+                    && settings->threadCountCount < MAX_THREAD_COUNTS - 1; 
+                                                             threadCount *= 2 )
+       {
+        settings->threadCounts[ settings->threadCountCount ] = threadCount;
+        settings->threadCountCount++;
+       }
+
+    settings->threadCounts[ settings->threadCountCount ] = processorCount;
+    settings->threadCountCount++;
+    settings->locks[ 0 ] = GLOBAL_MUTEX;
+    settings->locks[ 1 ] = READ_WRITE_LOCK;
+    settings->lockCount = 2;
+    settings->keyCount = 10000;
+    settings->opsPerThread = 100000;
+    settings->readPercent = 90;
+    settings->zipfExponent = 0.99;
+    settings->seed = 20231;
+    settings->outFileName = "scalingresults.json";
+    settings->allocation.pageSize = STANDARD_PAGES;
+    settings->allocation.numaPolicy = NUMA_DEFAULT;
+    settings->allocation.numaNode = 0;
+
+    for( argIndex = 1; argIndex + 1 < argc && valid; argIndex += 2 )
+       {
+        option = argv[ argIndex ];
+        value = argv[ argIndex + 1 ];
+
+        if( strcmp( option, "--threads" ) == 0 )
+           {
+            settings->threadCountCount = 0;
+
+            for( item = strtok( value, "," ); item != NULL 
+                         && settings->threadCountCount < MAX_THREAD_COUNTS; 
+                                               item = strtok( NULL, "," ) )
+               {
+                settings->threadCounts[ settings->threadCountCount ] = atoi( item );
+
+                valid = valid 
+                     && settings->threadCounts[ settings->threadCountCount ] > 0;
+
+                settings->threadCountCount++;
+               }
+           }
+
+        else if( strcmp( option, "--lock" ) == 0 )
+           {
+            valid = strcmp( value, "mutex" ) == 0 
+                     || strcmp( value, "rwlock" ) == 0
+                     || strcmp( value, "both" ) == 0;
+
+            settings->lockCount = strcmp( value, "both" ) == 0 ? 2 : 1;
+            settings->locks[ 0 ] = strcmp( value, "rwlock" ) == 0 ? 
+                                             READ_WRITE_LOCK : GLOBAL_MUTEX;
+           }
+
+        else if( strcmp( option, "--keys" ) == 0 )
+           {
+            settings->keyCount = atoll( value );
+           }
+
+        else if( strcmp( option, "--ops" ) == 0 )
+           {
+            settings->opsPerThread = atoll( value );
+           }
+
+        else if( strcmp( option, "--read-percent" ) == 0 )
+           {
+            settings->readPercent = atoi( value );
+           }
+
+        else if( strcmp( option, "--zipf" ) == 0 )
+           {
+            settings->zipfExponent = atof( value );
+           }
+
+        else if( strcmp( option, "--seed" ) == 0 )
+           {
+            settings->seed = strtoull( value, NULL, 10 );
+           }
+
+        else if( strcmp( option, "--output" ) == 0 )
+           {
+            settings->outFileName = value;
+           }
+
+        else if( strcmp( option, "--pages" ) == 0 )
+           {
+            valid = strcmp( value, "4k" ) == 0 || strcmp( value, "2m" ) == 0
+                                                 || strcmp( value, "1g" ) == 0;
+
+            settings->allocation.pageSize = strcmp( value, "2m" ) == 0 ? 
+                                                           HUGE_PAGES_2MB 
+                  : strcmp( value, "1g" ) == 0 ? HUGE_PAGES_1GB : STANDARD_PAGES;
+           }
+
+        else if( strcmp( option, "--numa" ) == 0 )
+           {
+            if( strcmp( value, "default" ) == 0 )
+               {
+                settings->allocation.numaPolicy = NUMA_DEFAULT;
+               }
+
+            else if( strcmp( value, "local" ) == 0 )
+               {
+                settings->allocation.numaPolicy = NUMA_LOCAL;
+               }
+
+            else if( strcmp( value, "interleave" ) == 0 )
+               {
+                settings->allocation.numaPolicy = NUMA_INTERLEAVE;
+               }
+
+            else
+               {
+                settings->allocation.numaPolicy = NUMA_BIND;
+                settings->allocation.numaNode = atoi( value );
+
+                valid = value[ 0 ] >= '0' && value[ 0 ] <= '9';
+               }
+           }
+
+        else
+           {
+            valid = false;
+           }
+       }
+
+    // odd argument count leaves an option without value
+    return valid && argIndex == argc && settings->threadCountCount > 0
+            && settings->keyCount > 0 && settings->keyCount < 1000000000
+            && settings->opsPerThread > 0 && settings->readPercent >= 0 
+            && settings->readPercent <= 100 && settings->zipfExponent >= 0.0;
+   }
+
+/*
+Name: runScalingStep
+Process: runs given number of threads against shared table at once,
+         merges their latency logs, writes JSON object of results
+Function input/parameters: output file (FILE *), 
+                           shared run state (ScalingRunType *),
+                           thread count (int)
+Function output/parameters: updated shared run state (ScalingRunType *)
+Function output/returned: none
+Device input/---: none
+Device output/file: JSON result object written as specified
+Device output/monitor: progress displayed
+Dependencies: malloc, createLatencyLog, pthread_create, pthread_mutex_lock,
+              pthread_cond_broadcast, pthread_mutex_unlock, 
+              getTimeNanoseconds, pthread_join, addLatencySample,
+              writeLatencyJson, clearLatencyLog, fprintf, printf, free
+*/
+void runScalingStep( FILE *outFilePtr, ScalingRunType *run, int threadCount )
+   {
+    ScalingThreadType *threads = (ScalingThreadType *)malloc( 
+                                     threadCount * sizeof( ScalingThreadType ) );
+    LatencyLogType *readLog = createLatencyLog( 0 );
+    LatencyLogType *writeLog = createLatencyLog( 0 );
+    long long runStart, runNanoseconds, sampleIndex;
+    int threadIndex;
+
+    printf( "\n%s, %d threads", getLockName( run->lock ), threadCount );
+    fflush( stdout );
+
+    run->started = false;
+
+    for( threadIndex = 0; threadIndex < threadCount; threadIndex++ )
+       {
+        threads[ threadIndex ].run = run;
+        threads[ threadIndex ].readLog = createLatencyLog( 
+                                               run->settings->opsPerThread );
+        threads[ threadIndex ].writeLog = createLatencyLog( 0 );
+        threads[ threadIndex ].randomState = run->settings->seed 
+                                               + 7919ULL * ( threadIndex + 1 );
+
+        pthread_create( &threads[ threadIndex ].thread, NULL, 
+                                        scalingWorker, &threads[ threadIndex ] );
+       }
+
+    // release all threads together
+    pthread_mutex_lock( &run->startMutex );
+
+    runStart = getTimeNanoseconds();
+    run->started = true;
+
+    pthread_cond_broadcast( &run->startSignal );
+    pthread_mutex_unlock( &run->startMutex );
+
+    for( threadIndex = 0; threadIndex < threadCount; threadIndex++ )
+       {
+        pthread_join( threads[ threadIndex ].thread, NULL );
+       }
+
+    runNanoseconds = getTimeNanoseconds() - runStart;
+
+    // merge thread logs
+    for( threadIndex = 0; threadIndex < threadCount; threadIndex++ )
+       {
+        for( sampleIndex = 0; sampleIndex < threads[ threadIndex ].readLog->count;
+                                                                 sampleIndex++ )
+           {
+            addLatencySample( readLog, 
+                          threads[ threadIndex ].readLog->samples[ sampleIndex ] );
+           }
+
+        for( sampleIndex = 0; sampleIndex < threads[ threadIndex ].writeLog->count;
+                                                                 sampleIndex++ )
+           {
+            addLatencySample( writeLog, 
+                         threads[ threadIndex ].writeLog->samples[ sampleIndex ] );
+           }
+
+        clearLatencyLog( threads[ threadIndex ].readLog );
+        clearLatencyLog( threads[ threadIndex ].writeLog );
+       }
+
+    // per operation throughput is over whole run
+    readLog->totalNanoseconds = runNanoseconds;
+    writeLog->totalNanoseconds = runNanoseconds;
+
+    printf( ": %.0f ops/s, read p99 %lld ns, write p99 %lld ns",
+            ( readLog->count + writeLog->count ) / ( runNanoseconds / 1e9 ),
+            getLatencyPercentile( readLog, 99.0 ), 
+                                      getLatencyPercentile( writeLog, 99.0 ) );
+
+    fprintf( outFilePtr, "    { \"lock\": \"%s\", \"threads\": %d, "
+             "\"operations\": %lld, \"seconds\": %.6f, "
+             "\"ops_per_second\": %.1f,\n      ", getLockName( run->lock ), 
+             threadCount, readLog->count + writeLog->count, 
+             runNanoseconds / 1e9, 
+             ( readLog->count + writeLog->count ) / ( runNanoseconds / 1e9 ) );
+
+    writeLatencyJson( outFilePtr, "read", readLog );
+    fprintf( outFilePtr, ",\n      " );
+    writeLatencyJson( outFilePtr, "write", writeLog );
+    fprintf( outFilePtr, " }" );
+
+    clearLatencyLog( readLog );
+    clearLatencyLog( writeLog );
+    free( threads );
+   }
+
+/*
+Name: scalingWorker
+Process: thread function, waits for start, then runs operations on keys
+         picked with Zipfian skew: reads are findItemIndex, writes replace
+         key (removeState then addItemFromStruct) so table stays at same
+         load, each operation holds table lock of run 
+         (shared for reads under read write lock), 
+         latency includes time waiting for lock
+Function input/parameters: thread data (void *, ScalingThreadType *)
+Function output/parameters: thread latency logs (ScalingThreadType *)
+Function output/returned: NULL (void *)
+Device input/---: none
+Device output/---: none
+Dependencies: pthread_mutex_lock, pthread_cond_wait, pthread_mutex_unlock,
+              nextRandom, getZipfRank, getTimeNanoseconds, 
+              pthread_rwlock_rdlock, pthread_rwlock_wrlock, 
+              pthread_rwlock_unlock, findItemIndex, removeState, 
+              addItemFromStruct, addLatencySample
+*/
+void *scalingWorker( void *threadPtr )
+   {
+    ScalingThreadType *thread = (ScalingThreadType *)threadPtr;
+    ScalingRunType *run = thread->run;
+    const StateDataType *key;
+    StateDataType removed;
+    long long opIndex, opStart;
+    bool isRead;
+
+    pthread_mutex_lock( &run->startMutex );
+
+    while( !run->started )
+       {
+        pthread_cond_wait( &run->startSignal, &run->startMutex );
+       }
+
+    pthread_mutex_unlock( &run->startMutex );
+
+    for( opIndex = 0; opIndex < run->settings->opsPerThread; opIndex++ )
+       {
+        isRead = (int)( nextRandom( &thread->randomState ) % 100 ) 
+                                                   < run->settings->readPercent;
+        key = &run->keys[ getZipfRank( &run->zipf, &thread->randomState ) ];
+
+        opStart = getTimeNanoseconds();
+
+        if( run->lock == READ_WRITE_LOCK )
+           {
+            if( isRead )
+               {
+                pthread_rwlock_rdlock( &run->tableRwLock );
+               }
+
+            else
+               {
+                pthread_rwlock_wrlock( &run->tableRwLock );
+               }
+           }
+
+        else
+           {
+            pthread_mutex_lock( &run->tableMutex );
+           }
+
+        if( isRead )
+           {
+            findItemIndex( run->hash, *key );
+           }
+
+        else if( removeState( &removed, *key, *run->hash ) )
+           {
+            addItemFromStruct( run->hash, *key );
+           }
+
+        if( run->lock == READ_WRITE_LOCK )
+           {
+            pthread_rwlock_unlock( &run->tableRwLock );
+           }
+
+        else
+           {
+            pthread_mutex_unlock( &run->tableMutex );
+           }
+
+        addLatencySample( isRead ? thread->readLog : thread->writeLog, 
+                                             getTimeNanoseconds() - opStart );
+       }
+
+    return NULL;
+   }
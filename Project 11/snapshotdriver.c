@@ -0,0 +1,171 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Data_Upload_Utility.c"
+#include "Snapshot_Utility.c"
+
+// constants
+#define SHOWN_STATE_COUNT 3
+
+// prototypes
+void displaySnapshotStates( HashSnapshotType *snapshot,
+                          const ProbingHashType *hash, const char **names );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *dataFileName = "inData.csv";
+    const char *names[ SHOWN_STATE_COUNT ] = { "New York", "Texas",
+                                                                 "Ontario" };
+    ProbingHashType *hash;
+    SnapshotSetType *snapshots;
+    HashSnapshotType *snapshot;
+    StateDataType changed, removed;
+    int tableSize = 67, loadedRows;
+
+    if( argc > 1 )
+       {
+        dataFileName = argv[ 1 ];
+       }
+
+    if( argc > 2 )
+       {
+        tableSize = atoi( argv[ 2 ] );
+       }
+
+    // title
+    printf( "\nTABLE SNAPSHOT PROGRAM\n" );
+    printf( "======================\n" );
+
+    hash = initializeHashTable( tableSize, LINEAR_PROBING );
+    setHashTableVerbose( hash, false );
+
+    loadedRows = uploadDataFromMap( hash, dataFileName );
+
+    if( loadedRows < 0 )
+       {
+        printf( "\nUnable to open %s\n", dataFileName );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    snapshots = attachHashSnapshots( hash );
+
+    if( snapshots == NULL )
+       {
+        printf( "\nUnable to attach snapshots\n" );
+
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    printf( "\n%d states loaded from %s\n", loadedRows, dataFileName );
+
+    snapshot = createHashSnapshot( snapshots );
+
+    if( snapshot == NULL )
+       {
+        printf( "\nUnable to take snapshot\n" );
+
+        detachHashSnapshots( snapshots );
+        clearHashTable( hash );
+
+        return 1;
+       }
+
+    // change table after snapshot
+    printf( "\n\nRemoving New York, Changing Texas, Adding Ontario ---------" );
+
+    setHashNodeFromData( &changed, "New York", 0.0, 0.0, 0.0, UNUSED_NODE );
+    removeState( &removed, changed, *hash );
+
+    setHashNodeFromData( &changed, "Texas", 0.0, 0.0, 0.0, UNUSED_NODE );
+
+    if( removeState( &removed, changed, *hash ) )
+       {
+        removed.averageTemp += 10.0;
+        addItemFromStruct( hash, removed );
+       }
+
+    setHashNodeFromData( &changed, "Ontario", 42.5, -20.0, 95.0, USED_NODE );
+    addItemFromStruct( hash, changed );
+
+    displaySnapshotStates( snapshot, hash, names );
+
+    printf( "\n%d of %d pages copied, %d snapshot(s) held\n",
+           snapshots->heldPageCount, snapshots->pageCount,
+                                                  snapshots->snapshotCount );
+
+    releaseHashSnapshot( snapshot );
+
+    printf( "%d pages held after release\n", snapshots->heldPageCount );
+
+    detachHashSnapshots( snapshots );
+    clearHashTable( hash );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: displaySnapshotStates
+Process: displays each named state as snapshot holds it and as
+         table holds it now
+Function input/parameters: snapshot (HashSnapshotType *),
+                           hash (const ProbingHashType *),
+                           state names, SHOWN_STATE_COUNT of them
+                           (const char **)
+Function output/parameters: none
+Function output/returned: none
+Device input/---: none
+Device output/monitor: states displayed
+Dependencies: setHashNodeFromData, findSnapshotItem, findItemIndex,
+              dataToString, printf
+*/
+void displaySnapshotStates( HashSnapshotType *snapshot,
+                           const ProbingHashType *hash, const char **names )
+   {
+    char displayStr[ MAX_STR_LEN ];
+    StateDataType searchItem, found;
+    int nameIndex, index;
+
+    for( nameIndex = 0; nameIndex < SHOWN_STATE_COUNT; nameIndex++ )
+       {
+        setHashNodeFromData( &searchItem, names[ nameIndex ], 0.0, 0.0,
+                                                          0.0, UNUSED_NODE );
+
+        printf( "\n\n%s\n", names[ nameIndex ] );
+
+        if( findSnapshotItem( snapshot, searchItem, &found ) )
+           {
+            dataToString( displayStr, found );
+            printf( "Snapshot: %s\n", displayStr );
+           }
+
+        else
+           {
+            printf( "Snapshot: not found\n" );
+           }
+
+        index = findItemIndex( hash, searchItem );
+
+        if( index != ITEM_NOT_FOUND )
+           {
+            dataToString( displayStr, hash->array[ index ] );
+            printf( "Table:    %s\n", displayStr );
+           }
+
+        else
+           {
+            printf( "Table:    not found\n" );
+           }
+       }
+   }
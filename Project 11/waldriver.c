@@ -0,0 +1,463 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "File_Input_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Binary_Data_Utility.c"
+#include "Benchmark_Utility.c"
+#include "Write_Ahead_Log_Utility.c"
+
+// constants
+#define REMOVE_EVERY 5
+#define FULL_TABLE_NODES 16
+#define REMOVE_TABLE_NODES 11
+
+// prototypes
+bool checkDuplicateInserts( const char *logFileName,
+                                          const char *checkpointFileName );
+bool checkRemovesAfterCheckpoint( const char *logFileName,
+                     const char *checkpointFileName, ProbeType probeStrategy );
+ProbingHashType *createQuietTable( int keyCount );
+void getUpdateKey( StateDataType *key, int operation, int keyCount );
+bool isSameTable( const ProbingHashType *one, const ProbingHashType *other );
+long long runTableUpdates( ProbingHashType *hash, WriteAheadLogType *wal,
+                                          int operationCount, int keyCount );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    const char *logFileName = "table.wal";
+    const char *checkpointFileName = "table.htbd";
+    ProbingHashType *memoryHash, *loggedHash, *recoveredHash;
+    WriteAheadLogType *wal;
+    long long memoryNanoseconds, loggedNanoseconds, syncCount, replayedCount;
+    long long windowMicroseconds = 1000;
+    int operationCount = 200000, keyCount = 2000;
+
+    if( argc > 1 )
+       {
+        operationCount = atoi( argv[ 1 ] );
+       }
+
+    if( argc > 2 )
+       {
+        keyCount = atoi( argv[ 2 ] );
+       }
+
+    if( argc > 3 )
+       {
+        windowMicroseconds = atoll( argv[ 3 ] );
+       }
+
+    // title
+    printf( "\nWRITE AHEAD LOG PROGRAM\n" );
+    printf( "=======================\n" );
+
+    if( operationCount <= 0 || keyCount <= 0 || windowMicroseconds < 0 )
+       {
+        printf( "\nUsage: waldriver [operations] [keys]"
+                " [durability window in microseconds]\n" );
+
+        return 1;
+       }
+
+    remove( logFileName );
+    remove( checkpointFileName );
+
+    wal = openWriteAheadLog( logFileName, checkpointFileName,
+                                                        windowMicroseconds );
+
+    if( wal == NULL )
+       {
+        printf( "\nUnable to open %s\n", logFileName );
+
+        remove( logFileName );
+
+        return 1;
+       }
+
+    printf( "\n%d updates over %d keys, %lld us durability window\n",
+                           operationCount, keyCount, windowMicroseconds );
+
+    memoryHash = createQuietTable( keyCount );
+    loggedHash = createQuietTable( keyCount );
+
+    memoryNanoseconds = runTableUpdates( memoryHash, NULL, operationCount,
+                                                                  keyCount );
+
+    // half of updates before checkpoint, half replayed after it
+    loggedNanoseconds = runTableUpdates( loggedHash, wal,
+                                              operationCount / 2, keyCount );
+
+    if( checkpointWriteAheadLog( wal, loggedHash, checkpointFileName ) < 0 )
+       {
+        printf( "\nUnable to write checkpoint %s\n", checkpointFileName );
+       }
+
+    loggedNanoseconds += runTableUpdates( loggedHash, wal,
+                               operationCount - operationCount / 2, keyCount );
+
+    syncCount = wal->syncCount;
+
+    if( !closeWriteAheadLog( wal ) )
+       {
+        printf( "\nUnable to write %s\n", logFileName );
+       }
+
+    printf( "\nIn memory: %10.0f updates per second\n",
+                              operationCount * 1.0e9 / memoryNanoseconds );
+    printf( "Logged:    %10.0f updates per second, %lld syncs\n",
+                   operationCount * 1.0e9 / loggedNanoseconds, syncCount );
+
+    // as after a crash, table rebuilt from checkpoint and log
+    recoveredHash = createQuietTable( keyCount );
+    replayedCount = recoverHashTable( recoveredHash, checkpointFileName,
+                                                                 logFileName );
+
+    printf( "\n%lld records replayed onto checkpoint, recovered table %s\n",
+              replayedCount, isSameTable( loggedHash, recoveredHash ) ?
+                                                "matches" : "DIFFERS" );
+
+    printf( "Duplicate and failed inserts: recovered table %s\n",
+              checkDuplicateInserts( logFileName, checkpointFileName ) ?
+                                                "matches" : "DIFFERS" );
+
+    printf( "Removes after checkpoint: recovered tables %s\n",
+              checkRemovesAfterCheckpoint( logFileName, checkpointFileName,
+                                                         LINEAR_PROBING )
+           && checkRemovesAfterCheckpoint( logFileName, checkpointFileName,
+                                                      QUADRATIC_PROBING )
+           && checkRemovesAfterCheckpoint( logFileName, checkpointFileName,
+                                                       CHAINING ) ?
+                                                "match" : "DIFFER" );
+
+    clearHashTable( memoryHash );
+    clearHashTable( loggedHash );
+    clearHashTable( recoveredHash );
+
+    remove( logFileName );
+    remove( checkpointFileName );
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: checkDuplicateInserts
+Process: logs inserts of one name before and after a checkpoint, fills
+         chained table until an insert fails, then removes that name
+         once; checks that recovery replays each change made since
+         checkpoint, none that failed, and gives the same table
+Function input/parameters: log and checkpoint file names (const char *)
+Function output/parameters: none
+Function output/returned: true if recovered table matches (bool)
+Device input/---: none
+Device output/file: log and checkpoint to HD
+Dependencies: remove, openWriteAheadLog, initializeHashTable,
+              setHashTableVerbose, setHashNodeFromData, insertLoggedItem,
+              checkpointWriteAheadLog, getUpdateKey, removeLoggedItem,
+              closeWriteAheadLog, recoverHashTable, isSameTable,
+              clearHashTable
+*/
+bool checkDuplicateInserts( const char *logFileName,
+                                           const char *checkpointFileName )
+   {
+    ProbingHashType *loggedHash, *recoveredHash;
+    WriteAheadLogType *wal;
+    StateDataType key, removed;
+    long long changeCount = 0;
+    int operation;
+    bool success;
+
+    remove( logFileName );
+    remove( checkpointFileName );
+
+    wal = openWriteAheadLog( logFileName, checkpointFileName, 0 );
+
+    if( wal == NULL )
+       {
+        return false;
+       }
+
+    loggedHash = initializeHashTable( FULL_TABLE_NODES, CHAINING );
+    recoveredHash = initializeHashTable( FULL_TABLE_NODES, CHAINING );
+
+    setHashTableVerbose( loggedHash, false );
+    setHashTableVerbose( recoveredHash, false );
+
+    // finds give first of three items of one name
+    setHashNodeFromData( &key, "Ohio", 1.0, -10.0, 10.0, USED_NODE );
+    success = insertLoggedItem( wal, loggedHash, key );
+
+    key.averageTemp = 2.0;
+    success = success && insertLoggedItem( wal, loggedHash, key );
+
+    success = success && checkpointWriteAheadLog( wal, loggedHash,
+                                                    checkpointFileName ) == 2;
+
+    key.averageTemp = 3.0;
+    success = success && insertLoggedItem( wal, loggedHash, key );
+    changeCount++;
+
+    for( operation = 3; operation < FULL_TABLE_NODES; operation++ )
+       {
+        getUpdateKey( &key, operation, FULL_TABLE_NODES );
+        success = success && insertLoggedItem( wal, loggedHash, key );
+        changeCount++;
+       }
+
+    // insert into full table fails and is not logged
+    getUpdateKey( &key, 0, FULL_TABLE_NODES );
+    success = success && !insertLoggedItem( wal, loggedHash, key );
+
+    setHashNodeFromData( &key, "Ohio", 0.0, 0.0, 0.0, USED_NODE );
+    success = success && removeLoggedItem( wal, loggedHash, key, &removed );
+    changeCount++;
+
+    success = closeWriteAheadLog( wal ) && success;
+
+    success = success && recoverHashTable( recoveredHash, checkpointFileName,
+                                                   logFileName ) == changeCount
+                      && isSameTable( loggedHash, recoveredHash );
+
+    clearHashTable( loggedHash );
+    clearHashTable( recoveredHash );
+
+    return success;
+   }
+
+/*
+Name: checkRemovesAfterCheckpoint
+Process: logs inserts of one name around item of another name with
+         same home, removes that item, checkpoints, then logs another
+         insert of first name; after recovery, removes first name from
+         both tables until none is left, checking finds after each
+Function input/parameters: log and checkpoint file names (const char *),
+                           probe strategy (ProbeType)
+Function output/parameters: none
+Function output/returned: true if tables match after each removal (bool)
+Device input/---: none
+Device output/file: log and checkpoint to HD
+Dependencies: remove, openWriteAheadLog, initializeHashTable,
+              setHashTableVerbose, setHashNodeFromData, insertLoggedItem,
+              removeLoggedItem,
+              checkpointWriteAheadLog, closeWriteAheadLog,
+              recoverHashTable, isSameTable, removeState, clearHashTable
+*/
+bool checkRemovesAfterCheckpoint( const char *logFileName,
+                      const char *checkpointFileName, ProbeType probeStrategy )
+   {
+    ProbingHashType *loggedHash, *recoveredHash;
+    WriteAheadLogType *wal;
+    StateDataType key, removed;
+    bool success = true, loggedRemoved, recoveredRemoved;
+
+    remove( logFileName );
+    remove( checkpointFileName );
+
+    wal = openWriteAheadLog( logFileName, checkpointFileName, 0 );
+
+    if( wal == NULL )
+       {
+        return false;
+       }
+
+    loggedHash = initializeHashTable( REMOVE_TABLE_NODES, probeStrategy );
+    recoveredHash = initializeHashTable( REMOVE_TABLE_NODES, probeStrategy );
+
+    setHashTableVerbose( loggedHash, false );
+    setHashTableVerbose( recoveredHash, false );
+
+    // anagram has same home, lands between first two items of name
+    setHashNodeFromData( &key, "Ohio", 1.0, -10.0, 10.0, USED_NODE );
+    success = success && insertLoggedItem( wal, loggedHash, key );
+
+    setHashNodeFromData( &key, "Oiho", 0.0, -10.0, 10.0, USED_NODE );
+    success = success && insertLoggedItem( wal, loggedHash, key );
+
+    setHashNodeFromData( &key, "Ohio", 2.0, -10.0, 10.0, USED_NODE );
+    success = success && insertLoggedItem( wal, loggedHash, key );
+
+    // removal leaves unused node that checkpoint must keep
+    setHashNodeFromData( &key, "Oiho", 0.0, 0.0, 0.0, USED_NODE );
+    success = success && removeLoggedItem( wal, loggedHash, key, &removed );
+
+    success = success && checkpointWriteAheadLog( wal, loggedHash,
+                                                    checkpointFileName ) == 2;
+
+    setHashNodeFromData( &key, "Ohio", 3.0, -10.0, 10.0, USED_NODE );
+    success = success && insertLoggedItem( wal, loggedHash, key );
+
+    success = closeWriteAheadLog( wal ) && success;
+
+    success = success && recoverHashTable( recoveredHash, checkpointFileName,
+                                                            logFileName ) == 1;
+
+    // each removal takes item finds gave, so next finds must agree too
+    setHashNodeFromData( &key, "Ohio", 0.0, 0.0, 0.0, USED_NODE );
+
+    do
+       {
+        success = success && isSameTable( loggedHash, recoveredHash );
+
+        loggedRemoved = removeState( &removed, key, *loggedHash );
+        recoveredRemoved = removeState( &removed, key, *recoveredHash );
+
+        success = success && loggedRemoved == recoveredRemoved;
+       }
+    while( success && loggedRemoved );
+
+    clearHashTable( loggedHash );
+    clearHashTable( recoveredHash );
+
+    return success;
+   }
+
+/*
+Name: createQuietTable
+Process: creates linear probing table for given number of keys,
+         about half full, probing display off
+Function input/parameters: key count (int)
+Function output/parameters: none
+Function output/returned: pointer to table (ProbingHashType *)
+Device input/---: none
+Device output/---: none
+Dependencies: initializeHashTable, setHashTableVerbose
+*/
+ProbingHashType *createQuietTable( int keyCount )
+   {
+    ProbingHashType *hash = initializeHashTable( 2 * keyCount + 1,
+                                                             LINEAR_PROBING );
+
+    setHashTableVerbose( hash, false );
+
+    return hash;
+   }
+
+/*
+Name: getUpdateKey
+Process: sets key of given update, keys are visited in a scattered
+         order, temperatures differ per update
+Function input/parameters: update number (int), key count (int)
+Function output/parameters: key (StateDataType *)
+Function output/returned: none
+Device input/---: none
+Device output/---: none
+Dependencies: sprintf, setHashNodeFromData
+*/
+void getUpdateKey( StateDataType *key, int operation, int keyCount )
+   {
+    char name[ STD_STR_LEN ];
+    int keyIndex = (int)( ( operation * 7919LL ) % keyCount );
+
+    sprintf( name, "Logged State %06d", keyIndex );
+
+    setHashNodeFromData( key, name, operation % 100, operation % 100 - 20.0,
+                                          operation % 100 + 20.0, USED_NODE );
+   }
+
+/*
+Name: isSameTable
+Process: checks that, for name of each item in use in one table, finds
+         in both tables give items with same temperatures, and both
+         hold same number of items
+Function input/parameters: tables (const ProbingHashType *)
+Function output/parameters: none
+Function output/returned: true if tables hold same items (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: findItemIndex
+*/
+bool isSameTable( const ProbingHashType *one, const ProbingHashType *other )
+   {
+    const StateDataType *node, *otherNode;
+    int index, otherIndex, oneCount = 0, otherCount = 0;
+
+    // items of same name are told apart by which one finds give
+    for( index = 0; index < one->tableSize; index++ )
+       {
+        if( one->array[ index ].inUse )
+           {
+            oneCount++;
+            node = &one->array[ findItemIndex( one, one->array[ index ] ) ];
+            otherIndex = findItemIndex( other, *node );
+
+            if( otherIndex == ITEM_NOT_FOUND )
+               {
+                return false;
+               }
+
+            otherNode = &other->array[ otherIndex ];
+
+            if( otherNode->averageTemp != node->averageTemp
+                 || otherNode->lowestTemp != node->lowestTemp
+                 || otherNode->highestTemp != node->highestTemp )
+               {
+                return false;
+               }
+           }
+       }
+
+    for( index = 0; index < other->tableSize; index++ )
+       {
+        otherCount += other->array[ index ].inUse ? 1 : 0;
+       }
+
+    return oneCount == otherCount;
+   }
+
+/*
+Name: runTableUpdates
+Process: applies updates to table, every REMOVE_EVERY-th a removal,
+         others upserts, logged if log is given
+Function input/parameters: hash table (ProbingHashType *),
+                           log, or NULL (WriteAheadLogType *),
+                           update count (int), key count (int)
+Function output/parameters: updated hash table (ProbingHashType *),
+                            updated log (WriteAheadLogType *)
+Function output/returned: total time in nanoseconds (long long)
+Device input/---: none
+Device output/---: none
+Dependencies: getTimeNanoseconds, getUpdateKey, removeState, upsertItem,
+              removeLoggedItem, upsertLoggedItem
+*/
+long long runTableUpdates( ProbingHashType *hash, WriteAheadLogType *wal,
+                                           int operationCount, int keyCount )
+   {
+    StateDataType key, removed;
+    long long startTime = getTimeNanoseconds();
+    int operation;
+
+    for( operation = 0; operation < operationCount; operation++ )
+       {
+        getUpdateKey( &key, operation, keyCount );
+
+        if( operation % REMOVE_EVERY == 0 )
+           {
+            if( wal != NULL )
+               {
+                removeLoggedItem( wal, hash, key, &removed );
+               }
+
+            else
+               {
+                removeState( &removed, key, *hash );
+               }
+           }
+
+        else if( wal != NULL )
+           {
+            upsertLoggedItem( wal, hash, key );
+           }
+
+        else
+           {
+            upsertItem( hash, key );
+           }
+       }
+
+    return getTimeNanoseconds() - startTime;
+   }
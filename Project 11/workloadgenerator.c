@@ -0,0 +1,201 @@
+// header files
+#include "Scan_Utility.c"
+#include "Number_Parse_Utility.c"
+#include "HashUtilities.c"
+#include "Mapped_Input_Utility.c"
+#include "Binary_Data_Utility.c"
+#include "Benchmark_Utility.c"
+#include "Workload_Utility.c"
+#include <string.h>
+
+// prototypes
+bool readWorkloadSettings( WorkloadSettingsType *settings, 
+                                                      int argc, char *argv[] );
+
+// main function
+int main( int argc, char *argv[] )
+   {
+    WorkloadSettingsType settings;
+    long long writtenCount;
+
+    // title
+    printf( "\nWORKLOAD GENERATOR\n" );
+    printf( "==================\n" );
+
+    if( !readWorkloadSettings( &settings, argc, argv ) )
+       {
+        printf( "\nUsage: workloadgenerator [--rows n] [--lengths min,max]"
+                "\n                   [--length-dist uniform|normal]"
+                "\n                   [--families n] [--family-size n]"
+                "\n                   [--family-length n] [--format csv|binary]"
+                "\n                   [--output file] [--ops n] [--oplog file]"
+                "\n                   [--mix insert,find,remove] [--zipf s]"
+                "\n                   [--seed n]\n" );
+
+        return 1;
+       }
+
+    writtenCount = writeWorkloadData( &settings );
+
+    if( writtenCount < 0 )
+       {
+        printf( "\nUnable to write %s\n", settings.dataFileName );
+
+        return 1;
+       }
+
+    printf( "\n%lld rows (%lld in anagram families) written to %s\n", 
+                       writtenCount, settings.familyCount * settings.familySize, 
+                                                       settings.dataFileName );
+
+    if( settings.operationCount > 0 )
+       {
+        writtenCount = writeOperationLog( &settings );
+
+        if( writtenCount < 0 )
+           {
+            printf( "\nUnable to write %s\n", settings.opLogFileName );
+
+            return 1;
+           }
+
+        printf( "\n%lld operations written to %s\n", 
+                                      writtenCount, settings.opLogFileName );
+       }
+
+    // end program
+    printf( "\nEnd Program\n" );
+
+    return 0;
+   }
+
+/*
+Name: readWorkloadSettings
+Process: sets defaults, then reads options from command line
+Function input/parameters: argument count (int), arguments (char *[])
+Function output/parameters: generator settings (WorkloadSettingsType *)
+Function output/returned: false if an option is unknown or invalid (bool)
+Device input/---: none
+Device output/---: none
+Dependencies: setDefaultWorkloadSettings, strcmp, sscanf, atoll, atoi, 
+              atof, strtoull
+*/
+bool readWorkloadSettings( WorkloadSettingsType *settings, 
+                                                       int argc, char *argv[] )
+   {
+    int argIndex;
+    const char *option, *value;
+    bool valid = true;
+
+    setDefaultWorkloadSettings( settings );
+
+    // data file name follows format unless given
+    settings->dataFileName = NULL;
+
+    for( argIndex = 1; argIndex + 1 < argc && valid; argIndex += 2 )
+       {
+        option = argv[ argIndex ];
+        value = argv[ argIndex + 1 ];
+
+        if( strcmp( option, "--rows" ) == 0 )
+           {
+            settings->rowCount = atoll( value );
+           }
+
+        else if( strcmp( option, "--lengths" ) == 0 )
+           {
+            valid = sscanf( value, "%d,%d", &settings->minNameLength, 
+                                              &settings->maxNameLength ) == 2;
+           }
+
+        else if( strcmp( option, "--length-dist" ) == 0 )
+           {
+            valid = strcmp( value, "uniform" ) == 0 
+                                        || strcmp( value, "normal" ) == 0;
+            settings->lengthDistribution = strcmp( value, "normal" ) == 0 ? 
+                                          NORMAL_LENGTHS : UNIFORM_LENGTHS;
+           }
+
+        else if( strcmp( option, "--families" ) == 0 )
+           {
+            settings->familyCount = atoll( value );
+           }
+
+        else if( strcmp( option, "--family-size" ) == 0 )
+           {
+            settings->familySize = atoll( value );
+           }
+
+        else if( strcmp( option, "--family-length" ) == 0 )
+           {
+            settings->familyNameLength = atoi( value );
+           }
+
+        else if( strcmp( option, "--format" ) == 0 )
+           {
+            valid = strcmp( value, "csv" ) == 0 
+                                        || strcmp( value, "binary" ) == 0;
+            settings->binaryOutput = strcmp( value, "binary" ) == 0;
+           }
+
+        else if( strcmp( option, "--output" ) == 0 )
+           {
+            settings->dataFileName = value;
+           }
+
+        else if( strcmp( option, "--ops" ) == 0 )
+           {
+            settings->operationCount = atoll( value );
+           }
+
+        else if( strcmp( option, "--oplog" ) == 0 )
+           {
+            settings->opLogFileName = value;
+           }
+
+        else if( strcmp( option, "--mix" ) == 0 )
+           {
+            valid = sscanf( value, "%d,%d,%d", &settings->insertPercent, 
+                                               &settings->findPercent, 
+                                          &settings->removePercent ) == 3;
+           }
+
+        else if( strcmp( option, "--zipf" ) == 0 )
+           {
+            settings->zipfExponent = atof( value );
+           }
+
+        else if( strcmp( option, "--seed" ) == 0 )
+           {
+            settings->seed = strtoull( value, NULL, 10 );
+           }
+
+        else
+           {
+            valid = false;
+           }
+       }
+
+    if( settings->dataFileName == NULL )
+       {
+        settings->dataFileName = settings->binaryOutput ? 
+                                               "workload.bin" : "workload.csv";
+       }
+
+    // odd argument count leaves an option without value
+    return valid && argIndex == argc && settings->rowCount > 0
+            && settings->minNameLength > 0 
+            && settings->minNameLength <= settings->maxNameLength
+            && settings->maxNameLength < STD_STR_LEN
+            && settings->familyCount >= 0 && settings->familySize > 0
+            && settings->familyCount * settings->familySize <= settings->rowCount
+            && settings->familyNameLength > 0 
+            && settings->familyNameLength < STD_STR_LEN
+            && settings->operationCount >= 0
+            && settings->insertPercent >= 0 && settings->findPercent >= 0
+            && settings->removePercent >= 0 
+            && settings->insertPercent + settings->findPercent 
+                                        + settings->removePercent == 100
+            && settings->zipfExponent >= 0.0;
+   }
+